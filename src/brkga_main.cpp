@@ -1,15 +1,34 @@
 #define DEBUG
 #include "CLI/CLI.hpp"
+#include "core/cancellation.hpp"
+#include "core/compressed_graph.hpp"
+#include "core/csr_graph.hpp"
 #include "core/graph.hpp"
 #include "core/log.hpp"
+#include "core/memory_usage.hpp"
+#include "core/numa.hpp"
+#include "core/perf_counters.hpp"
+#include "core/phase_timer.hpp"
+#include "core/run_summary.hpp"
+#include "core/telemetry.hpp"
+#include "core/thread_pool.hpp"
+#include "meta/brkga/adaptive_parameters.hpp"
 #include "meta/brkga/brkga.hpp"
 #include "meta/brkga/brkga_decoder.hpp"
 #include "meta/brkga/mt_rand.hpp"
+#include "meta/brkga/stagnation.hpp"
+#include "meta/brkga/steady_state_brkga.hpp"
+#include "meta/local_search/greedy.hpp"
+#include "meta/local_search/path_relinking.hpp"
 
+#include <cmath>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <future>
 #include <limits>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <random>
 #include <string>
 #include <utility>
@@ -30,70 +49,293 @@ constexpr unsigned DEFAULT_NUM_THREADS        = 1;      // >= 1
 constexpr unsigned DEFAULT_MIGRATION_INTERVAL = 100;    // >= 1
 constexpr unsigned DEFAULT_MIGRATION_SIZE     = 2;      // >= 0
 constexpr unsigned DEFAULT_MAX_GENERATIONS    = 0;      // 0 = desabilitado
-constexpr unsigned DEFAULT_TIME_LIMIT_SECONDS = 0;      // obrigatório (>0)
+constexpr double   DEFAULT_TIME_LIMIT_SECONDS = 0.0;    // obrigatório (>0, resolução de 1 ms)
 constexpr uint64_t DEFAULT_RNG_SEED           = 0;      // 0 = aleatória
 constexpr unsigned DEFAULT_NUM_TRIALS         = 1;      // >= 1
+constexpr unsigned DEFAULT_MEMORY_BUDGET_MB   = 1024;   // blocos de arestas da construção csr
+constexpr unsigned DEFAULT_PARSE_THREADS      = 2;      // >= 1
+constexpr unsigned DEFAULT_RELINK_THREADS     = 1;      // >= 1
+constexpr double   DEFAULT_TELEMETRY_INTERVAL = 5.0;    // segundos entre gravações do arquivo
 
-struct convergence_point {
-  double elapsed_seconds{};
-  double fitness_value{};
+using r3dp::brkga::restart_policy;
+using r3dp::core::convergence_point;
+using r3dp::core::create_graph_summary;
+using r3dp::core::graph_summary;
 
-  friend void to_json( nlohmann::json &j, const convergence_point &p ) {
-    j = nlohmann::json{ { "elapsed_seconds", p.elapsed_seconds },
-                        { "fitness_value", p.fitness_value } };
+// Intervalo entre pontos de convergência no motor assíncrono (que não tem gerações)
+constexpr std::chrono::milliseconds STEADY_STATE_REPORT_INTERVAL{ 100 };
+
+// Com uma só ilha, o religamento usa os melhores cromossomos dela como elites
+constexpr unsigned SINGLE_ISLAND_RELINK_ELITES = 4;
+
+// Resumo da instrumentação por fase de uma tentativa
+struct performance_summary {
+  r3dp::core::phase_report report;
+
+  friend void to_json( nlohmann::json &j, const performance_summary &s ) {
+    nlohmann::json seconds  = nlohmann::json::object();
+    nlohmann::json fraction = nlohmann::json::object();
+    for ( std::size_t ph = 0; ph < r3dp::core::phase_count; ++ph ) {
+      const std::string name( r3dp::core::phase_name( static_cast<r3dp::core::phase>( ph ) ) );
+      seconds[name]  = s.report.phase_seconds[ph];
+      fraction[name] = s.report.phase_fraction[ph];
+    }
+    j = nlohmann::json{ { "engine_seconds", s.report.engine_seconds },
+                        { "busy_seconds", s.report.busy_seconds },
+                        { "evaluations", s.report.evaluations },
+                        { "evaluations_per_second", s.report.evaluations_per_second },
+                        { "repair_passes_per_decode", s.report.repair_passes_per_decode },
+                        { "delta_decode_fraction", s.report.delta_decode_fraction },
+                        { "thread_utilization", s.report.thread_utilization },
+                        { "phase_seconds", seconds },
+                        { "phase_fraction", fraction } };
+  }
+};
+
+// Contadores de hardware por região (presentes apenas com --perf-counters)
+struct hardware_counters_summary {
+  r3dp::core::perf_report report;
+
+  friend void to_json( nlohmann::json &j, const hardware_counters_summary &s ) {
+    using r3dp::core::hw_counter;
+    using r3dp::core::perf_region;
+
+    auto counter_name = []( std::size_t c ) {
+      return std::string( r3dp::core::hw_counter_name( static_cast<hw_counter>( c ) ) );
+    };
+
+    nlohmann::json counters = nlohmann::json::object();
+    for ( std::size_t c = 0; c < r3dp::core::hw_counter_count; ++c ) {
+      counters[counter_name( c )] = s.report.counter_available[c];
+    }
+
+    nlohmann::json regions = nlohmann::json::object();
+    for ( std::size_t r = 0; r < r3dp::core::perf_region_count; ++r ) {
+      const auto    &region = s.report.regions[r];
+      nlohmann::json values = nlohmann::json::object();
+      for ( std::size_t c = 0; c < r3dp::core::hw_counter_count; ++c ) {
+        values[counter_name( c )] = region.totals.counters.value[c];
+      }
+
+      const std::string name( r3dp::core::perf_region_name( static_cast<perf_region>( r ) ) );
+      regions[name] = nlohmann::json{
+        { "samples", region.totals.samples },
+        { "seconds", static_cast<double>( region.totals.elapsed_ns ) * 1e-9 },
+        { "counters", values },
+        { "ipc", region.ipc },
+        { "cache_misses_per_kinstr", region.cache_misses_per_kinstr },
+        { "branch_misses_per_kinstr", region.branch_misses_per_kinstr },
+        { "memory_bandwidth_gbps", region.memory_bandwidth_gbps } };
+    }
+
+    j = nlohmann::json{ { "available", s.report.available },
+                        { "error", s.report.error },
+                        { "counter_available", counters },
+                        { "regions", regions } };
+  }
+};
+
+// Parâmetros usados em uma geração do modo adaptativo (--adaptive-parameters)
+struct parameter_point {
+  unsigned generation             = 0;
+  double   time_seconds           = 0.0;
+  unsigned arm                    = 0;
+  double   elite_fraction         = 0.0;
+  double   mutant_fraction        = 0.0;
+  double   elite_inheritance_prob = 0.0;
+  double   reward                 = 0.0;  // fração das populações cujo melhor melhorou
+  double   diversity              = 0.0;  // BRKGA::getDiversity() após a geração
+  double   best_fitness_value     = 0.0;
+
+  friend void to_json( nlohmann::json &j, const parameter_point &p ) {
+    j = nlohmann::json{ { "generation", p.generation },
+                        { "time_seconds", p.time_seconds },
+                        { "arm", p.arm },
+                        { "elite_fraction", p.elite_fraction },
+                        { "mutant_fraction", p.mutant_fraction },
+                        { "elite_inheritance_prob", p.elite_inheritance_prob },
+                        { "reward", p.reward },
+                        { "diversity", p.diversity },
+                        { "best_fitness_value", p.best_fitness_value } };
+  }
+};
+
+// Reinício parcial de uma ilha estagnada (--restart-stall / --restart-diversity)
+struct restart_event {
+  unsigned    generation         = 0;
+  double      time_seconds       = 0.0;
+  unsigned    island             = 0;
+  std::string reason;                     // "stall" ou "diversity"
+  double      best_fitness_value = 0.0;   // melhor da ilha, que sobrevive ao reinício
+  double      diversity          = -1.0;  // < 0: não medida
+
+  friend void to_json( nlohmann::json &j, const restart_event &e ) {
+    j = nlohmann::json{ { "generation", e.generation },
+                        { "time_seconds", e.time_seconds },
+                        { "island", e.island },
+                        { "reason", e.reason },
+                        { "best_fitness_value", e.best_fitness_value } };
+    if ( e.diversity >= 0.0 ) {
+      j["diversity"] = e.diversity;
+    }
+  }
+};
+
+// Rodadas de religamento de caminhos entre as elites das ilhas (--path-relinking)
+struct relink_summary {
+  unsigned      rounds             = 0;
+  std::uint64_t relinks            = 0;  // pares religados
+  unsigned      injections         = 0;  // rodadas cujo melhor ponto entrou em alguma ilha
+  unsigned      improvements       = 0;  // injeções que melhoraram o melhor da tentativa
+  double        best_fitness_value = std::numeric_limits<double>::infinity();
+
+  friend void to_json( nlohmann::json &j, const relink_summary &r ) {
+    j = nlohmann::json{ { "rounds", r.rounds },
+                        { "relinks", r.relinks },
+                        { "injections", r.injections },
+                        { "improvements", r.improvements } };
+    if ( r.injections > 0 ) {
+      j["best_fitness_value"] = r.best_fitness_value;
+    }
   }
 };
 
 struct trial_result {
   double                         best_fitness_value = std::numeric_limits<double>::infinity();
   std::vector<convergence_point> convergence_points;
+  performance_summary            performance;
+  hardware_counters_summary      hardware_counters;
   std::chrono::steady_clock::time_point start_time_point;
+  std::string                           stop_reason;
+  double                                overshoot_seconds = 0.0;  // além do prazo, se parou por tempo
+
+  // Modo adaptativo: braços do bandit, gerações de cada um e a trajetória dos parâmetros
+  std::vector<r3dp::brkga::parameter_arm> parameter_arms;
+  std::vector<std::uint64_t>              parameter_arm_pulls;
+  std::vector<parameter_point>            parameter_trajectory;
+
+  bool                       restarts_enabled = false;
+  std::vector<restart_event> restarts;
+
+  bool           path_relinking_enabled = false;
+  relink_summary path_relinking;
+
+  // Partida a quente: cromossomos gulosos colocados nas populações iniciais
+  unsigned greedy_seed_count   = 0;
+  double   greedy_seed_seconds = 0.0;
+
+  // Migração assíncrona: cromossomos enviados, descartados (fila cheia) e recebidos
+  bool                         async_migration_enabled = false;
+  r3dp::brkga::migration_stats async_migration;
 
   void start_timer() noexcept {
     start_time_point = std::chrono::steady_clock::now();
   }
 
+  // Registra por que a tentativa parou e quanto passou do prazo
+  void record_stop( std::string reason, std::chrono::steady_clock::time_point deadline ) {
+    const auto now    = std::chrono::steady_clock::now();
+    stop_reason       = std::move( reason );
+    overshoot_seconds = now > deadline
+                          ? std::chrono::duration<double>( now - deadline ).count()
+                          : 0.0;
+  }
+
+  [[nodiscard]] double elapsed_seconds() const {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(
+             std::chrono::steady_clock::now() - start_time_point )
+      .count();
+  }
+
   void add_point( double fitness_value_now ) {
-    const double t = std::chrono::duration_cast<std::chrono::duration<double>>(
-                       std::chrono::steady_clock::now() - start_time_point )
-                       .count();
-    convergence_points.push_back( { t, fitness_value_now } );
+    convergence_points.push_back( { elapsed_seconds(), fitness_value_now } );
   }
 
-  // Apenas salva o valor do melhor fitness e os pontos da curva de convergência
+  // Salva o melhor fitness, os pontos da curva de convergência e a instrumentação por fase
   friend void to_json( nlohmann::json &j, const trial_result &t ) {
     j = nlohmann::json{ { "best_fitness_value", t.best_fitness_value },
-                        { "convergence_points", t.convergence_points } };
+                        { "stop_reason", t.stop_reason },
+                        { "overshoot_seconds", t.overshoot_seconds },
+                        { "convergence_points", t.convergence_points },
+                        { "performance", t.performance } };
+    if ( t.hardware_counters.report.enabled ) {
+      j["hardware_counters"] = t.hardware_counters;
+    }
+    if ( !t.parameter_arms.empty() ) {
+      nlohmann::json arms = nlohmann::json::array();
+      for ( std::size_t a = 0; a < t.parameter_arms.size(); ++a ) {
+        arms.push_back( { { "elite_fraction", t.parameter_arms[a].elite_fraction },
+                          { "mutant_fraction", t.parameter_arms[a].mutant_fraction },
+                          { "elite_inheritance_prob", t.parameter_arms[a].elite_inheritance_prob },
+                          { "generations", t.parameter_arm_pulls[a] } } );
+      }
+      j["parameter_arms"]       = arms;
+      j["parameter_trajectory"] = t.parameter_trajectory;
+    }
+    if ( t.restarts_enabled ) {
+      j["restarts"] = t.restarts;
+    }
+    if ( t.path_relinking_enabled ) {
+      j["path_relinking"] = t.path_relinking;
+    }
+    if ( t.greedy_seed_count > 0 ) {
+      j["greedy_seeds"] = { { "count", t.greedy_seed_count },
+                            { "seconds", t.greedy_seed_seconds } };
+    }
+    if ( t.async_migration_enabled ) {
+      j["async_migration"] = { { "sent", t.async_migration.sent },
+                               { "dropped", t.async_migration.dropped },
+                               { "received", t.async_migration.received } };
+    }
   }
 };
 
-struct graph_summary {
-  std::string   graph_name;
-  std::uint32_t vertex_count = 0;
-  std::uint64_t edge_count   = 0;
-  double        density      = 0.0;
+// Custo de memória da execução (RSS lido de /proc/self/status)
+struct memory_summary {
+  std::string   graph_backend;
+  double        graph_build_seconds       = 0.0;
+  std::uint64_t spilled_runs              = 0;
+  std::uint64_t spilled_bytes             = 0;
+  std::size_t   graph_bytes               = 0;  // csr/compressed (0 no adjacency-list)
+  std::size_t   peak_rss_after_load_bytes = 0;
+  std::size_t   peak_rss_bytes            = 0;
 
-  static constexpr double compute_density( std::uint32_t n, std::uint64_t m ) noexcept {
-    if ( n < 2 ) {
-      return 0.0;
-    }
-    const long double num = 2.0L * static_cast<long double>( m );
-    const long double den = static_cast<long double>( n ) * static_cast<long double>( n - 1U );
-    return static_cast<double>( num / den );
+  friend void to_json( nlohmann::json &j, const memory_summary &m ) {
+    j = nlohmann::json{ { "graph_backend", m.graph_backend },
+                        { "graph_build_seconds", m.graph_build_seconds },
+                        { "spilled_runs", m.spilled_runs },
+                        { "spilled_bytes", m.spilled_bytes },
+                        { "graph_bytes", m.graph_bytes },
+                        { "peak_rss_after_load_bytes", m.peak_rss_after_load_bytes },
+                        { "peak_rss_bytes", m.peak_rss_bytes } };
   }
+};
+
+// Posicionamento com --numa: nós, domínio de cada thread do BRKGA e se o grafo foi intercalado
+struct numa_summary {
+  std::vector<r3dp::core::numa_node> nodes;
+  std::vector<unsigned>              thread_domains;
+  bool                               graph_interleaved = false;
 
-  friend void to_json( nlohmann::json &j, const graph_summary &g ) {
-    j = nlohmann::json{ { "graph_name", g.graph_name },
-                        { "vertex_count", g.vertex_count },
-                        { "edge_count", g.edge_count },
-                        { "density", g.density } };
+  friend void to_json( nlohmann::json &j, const numa_summary &s ) {
+    nlohmann::json nodes = nlohmann::json::array();
+    for ( const auto &node : s.nodes ) {
+      nodes.push_back( { { "id", node.id }, { "cpus", node.cpus } } );
+    }
+    j = nlohmann::json{ { "nodes", nodes },
+                        { "thread_domains", s.thread_domains },
+                        { "graph_interleaved", s.graph_interleaved } };
   }
 };
 
 struct run_results {
-  graph_summary             graph;
-  std::uint64_t             seed = 0;
-  std::vector<trial_result> trials;
+  graph_summary               graph;
+  memory_summary              memory;
+  std::string                 engine;
+  double                      time_limit_seconds = 0.0;
+  std::uint64_t               seed               = 0;
+  std::optional<numa_summary> numa;
+  std::vector<trial_result>   trials;
 
   [[nodiscard]] unsigned trial_count() const noexcept {
     return static_cast<unsigned>( trials.size() );
@@ -106,9 +348,15 @@ struct run_results {
 
   friend void to_json( nlohmann::json &j, const run_results &r ) {
     j = nlohmann::json{ { "graph", r.graph },
+                        { "engine", r.engine },
+                        { "time_limit_seconds", r.time_limit_seconds },
+                        { "memory", r.memory },
                         { "seed", r.seed },
                         { "trial_count", r.trial_count() },
                         { "trials", r.trials } };
+    if ( r.numa ) {
+      j["numa"] = *r.numa;
+    }
   }
 
   void save_json( const std::string &filename, int indent = 2 ) const {
@@ -123,11 +371,509 @@ struct run_results {
   }
 };
 
-inline graph_summary create_graph_summary( std::string name, std::uint32_t n, std::uint64_t m ) {
-  return graph_summary{ .graph_name   = std::move( name ),
-                        .vertex_count = n,
-                        .edge_count   = m,
-                        .density      = graph_summary::compute_density( n, m ) };
+// Parâmetros da linha de comando usados pelas tentativas
+struct run_options {
+  std::string               engine;
+  unsigned                  population_size        = DEFAULT_POPULATION_SIZE;
+  double                    elite_fraction         = DEFAULT_ELITE_FRACTION;
+  double                    mutant_fraction        = DEFAULT_MUTANT_FRACTION;
+  double                    elite_inheritance_prob = DEFAULT_ELITE_INHERIT_PROB;
+  unsigned                  num_populations        = DEFAULT_NUM_POPULATIONS;
+  unsigned                  num_threads            = DEFAULT_NUM_THREADS;
+  unsigned                  decode_threads         = 1;
+  unsigned                  max_generations        = DEFAULT_MAX_GENERATIONS;
+  unsigned                  migration_interval     = DEFAULT_MIGRATION_INTERVAL;
+  unsigned                  migration_size         = DEFAULT_MIGRATION_SIZE;
+  unsigned                  num_trials             = DEFAULT_NUM_TRIALS;
+  std::chrono::milliseconds time_limit{ 0 };
+  bool                      perf_counters       = false;
+  bool                      batch_decode        = false;
+  bool                      delta_decode        = false;
+  bool                      adaptive_parameters = false;
+  double                    diversity_floor     =
+    r3dp::brkga::adaptive_parameters::DEFAULT_DIVERSITY_FLOOR;
+  restart_policy            restart;
+  bool                      path_relinking       = false;
+  unsigned                  relink_threads       = DEFAULT_RELINK_THREADS;
+  double                    greedy_seed_fraction = 0.0;
+  std::vector<r3dp::core::numa_node> numa_nodes;      // vazio sem --numa
+  r3dp::core::thread_placement       numa_placement;  // CPUs e domínios das threads do BRKGA
+  r3dp::brkga::migration_topology    migration_topology{};  // all-to-all
+  bool                               async_migration = false;
+  r3dp::core::telemetry             *telemetry       = nullptr;  // nulo sem --telemetry-*
+};
+
+// Chaves de `count` soluções gulosas: a determinística e depois variantes aleatórias
+template <class Graph>
+std::vector<std::vector<double>> greedy_seeds( const Graph  &graph,
+                                               std::size_t   count,
+                                               unsigned      threads,
+                                               std::uint64_t seed ) {
+  r3dp::core::thread_pool                                           pool( threads );
+  std::vector<r3dp::local_search::basic_greedy_construction<Graph>> builders;
+  builders.reserve( pool.size() );
+  for ( unsigned t = 0; t < pool.size(); ++t ) {
+    builders.emplace_back( graph );
+  }
+
+  const std::size_t                n = r3dp::core::vertex_count( graph );
+  std::vector<std::vector<double>> seeds( count, std::vector<double>( n ) );
+  pool.parallel_for(
+    0,
+    count,
+    [&]( std::size_t i ) {
+      auto &builder = builders[pool.slot()];
+      if ( i == 0 ) {
+        builder.construct();
+        builder.to_keys( seeds[i] );
+        return;
+      }
+      r3dp::core::counter_rng rng( seed, i );
+      builder.construct( &rng );
+      builder.to_keys( seeds[i], &rng );
+    },
+    1 );
+  return seeds;
+}
+
+// Resultado de uma rodada de religamento: o melhor ponto entre todos os pares de elites
+struct relink_round {
+  std::vector<double> keys;  // vazio: nenhum ponto viável
+  double              fitness = 0.0;
+  std::uint64_t       relinks = 0;
+};
+
+// Religa todos os pares ordenados de elites em paralelo, com um religador por slot do pool
+template <class Graph>
+relink_round relink_elites( std::vector<r3dp::local_search::basic_path_relinking<Graph>> &relinkers,
+                            r3dp::core::thread_pool                                      &pool,
+                            const std::vector<std::vector<std::uint8_t>>                 &elites,
+                            std::uint64_t                                                 seed,
+                            const r3dp::core::cancellation_token                         &token ) {
+  const std::size_t count = elites.size();
+  const std::size_t pairs = count * ( count - 1 );
+
+  std::vector<r3dp::local_search::relink_result> results( pairs );
+  pool.parallel_for(
+    0,
+    pairs,
+    [&]( std::size_t i ) {
+      const std::size_t from  = i / ( count - 1 );
+      std::size_t       guide = i % ( count - 1 );
+      guide += guide >= from;  // pula o próprio `from`
+
+      r3dp::core::counter_rng rng( seed, i );
+      results[i] = relinkers[pool.slot()].relink( elites[from], elites[guide], rng, &token );
+    },
+    1 );
+
+  relink_round round;
+  round.relinks = pairs;
+
+  const r3dp::local_search::relink_result *best = nullptr;
+  for ( const auto &r : results ) {
+    if ( r.found() && ( best == nullptr || r.weight < best->weight ) ) {
+      best = &r;
+    }
+  }
+  if ( best != nullptr ) {
+    round.keys.resize( best->labels.size() );
+    for ( std::size_t v = 0; v < best->labels.size(); ++v ) {
+      round.keys[v] = ( best->labels[v] + 0.5 ) / 4.0;  // centro do intervalo do rótulo
+    }
+    round.fitness = double( best->weight );
+  }
+  return round;
+}
+
+// Executa as tentativas sobre uma representação do grafo (graph_t ou csr_graph)
+template <class Graph>
+void run_trials( const Graph         &graph,
+                 const run_options   &opt,
+                 r3dp::brkga::MTRand &rng,
+                 run_results         &run_result ) {
+  using decoder_t = r3dp::brkga::basic_r3dp_decoder<Graph>;
+
+  // A coloração do modo paralelo depende só do grafo: um decodificador serve todas as tentativas
+  const decoder_t decoder( graph, opt.decode_threads );
+
+  // Religamento em segundo plano: threads próprias, fora das -j que evoluem as ilhas
+  std::optional<r3dp::core::thread_pool>                       relink_pool;
+  std::vector<r3dp::local_search::basic_path_relinking<Graph>> relinkers;
+  if ( opt.path_relinking && opt.engine != "steady-state" ) {
+    relink_pool.emplace( opt.relink_threads );
+    relinkers.reserve( relink_pool->size() );
+    for ( unsigned t = 0; t < relink_pool->size(); ++t ) {
+      relinkers.emplace_back( graph );
+    }
+  }
+
+  // Motor guloso: a primeira tentativa é a construção determinística, as demais são variantes
+  std::optional<r3dp::local_search::basic_greedy_construction<Graph>> greedy;
+  if ( opt.engine == "greedy" ) {
+    greedy.emplace( graph );
+  }
+
+  // Com --numa a thread principal é o slot 0 do BRKGA (domínio do primeiro nó); os pools criados
+  // acima não herdam essa restrição
+  if ( !opt.numa_nodes.empty() ) {
+    r3dp::core::bind_current_thread( opt.numa_nodes.front() );
+  }
+
+  for ( size_t trial_idx = 0; trial_idx < opt.num_trials; ++trial_idx ) {
+    LOG_MESSAGE( "Iniciando tentativa: " << trial_idx );
+
+    auto    &trial_result_ref = run_result.create_trial();
+    unsigned generation_idx   = 0;
+
+    trial_result_ref.start_timer();
+
+    if ( greedy ) {
+      if ( trial_idx == 0 ) {
+        greedy->construct();
+      } else {
+        const std::uint64_t     seed = ( std::uint64_t{ rng.randInt() } << 32 ) | rng.randInt();
+        r3dp::core::counter_rng greedy_rng( seed, 0 );
+        greedy->construct( &greedy_rng );
+      }
+      trial_result_ref.best_fitness_value = double( greedy->weight() );
+      trial_result_ref.add_point( trial_result_ref.best_fitness_value );
+      if ( opt.telemetry ) {
+        opt.telemetry->begin_trial(
+          unsigned( trial_idx ), opt.num_trials, trial_result_ref.start_time_point, 0 );
+        opt.telemetry->publish( 0, trial_result_ref.best_fitness_value );
+      }
+      trial_result_ref.record_stop( "completed",
+                                    trial_result_ref.start_time_point + opt.time_limit );
+      LOG_MESSAGE( "Solução gulosa: " << greedy->weight() << " em "
+                                      << trial_result_ref.elapsed_seconds() << " s" );
+      continue;
+    }
+
+    if ( opt.engine == "steady-state" ) {
+      r3dp::brkga::SteadyStateBRKGA<decoder_t, r3dp::brkga::MTRand> algorithm(
+        r3dp::core::vertex_count( graph ),
+        opt.population_size,
+        opt.elite_fraction,
+        opt.mutant_fraction,
+        opt.elite_inheritance_prob,
+        decoder,
+        rng,
+        opt.num_threads );
+
+      // Sem gerações: o limite de gerações vira o número equivalente de decodificações
+      const std::uint64_t decode_budget =
+        opt.max_generations > 0
+          ? std::uint64_t{ opt.max_generations } * ( algorithm.getP() - algorithm.getPe() )
+          : std::numeric_limits<std::uint64_t>::max();
+      const auto deadline = trial_result_ref.start_time_point + opt.time_limit;
+      if ( opt.telemetry ) {
+        opt.telemetry->begin_trial(
+          unsigned( trial_idx ), opt.num_trials, deadline, opt.max_generations );
+      }
+
+      std::uint64_t decoded = 0;
+      while ( decoded < decode_budget && std::chrono::steady_clock::now() < deadline ) {
+        // O prazo da tentativa cancela decodificações; a fatia de relatório só para de emitir
+        decoded += algorithm.evolve(
+          decode_budget - decoded,
+          deadline,
+          std::min( deadline, std::chrono::steady_clock::now() + STEADY_STATE_REPORT_INTERVAL ) );
+
+        double best_fitness_now = algorithm.getBestFitness();
+        trial_result_ref.add_point( best_fitness_now );
+
+        // Gerações equivalentes, na mesma escala de --max-generations
+        if ( opt.telemetry ) {
+          opt.telemetry->publish( decoded / ( algorithm.getP() - algorithm.getPe() ),
+                                  best_fitness_now );
+          if ( opt.telemetry->refresh_due() ) {
+            opt.telemetry->publish_evaluations( algorithm.getPhaseReport().evaluations );
+          }
+        }
+
+        if ( best_fitness_now < trial_result_ref.best_fitness_value ) {
+          trial_result_ref.best_fitness_value = best_fitness_now;
+          LOG_MESSAGE( "Novo melhor fitness encontrado após " << decoded
+                                                              << " decodificações: "
+                                                              << best_fitness_now );
+        }
+      }
+
+      trial_result_ref.record_stop( decoded < decode_budget ? "time_limit" : "max_generations",
+                                    deadline );
+      trial_result_ref.performance.report = algorithm.getPhaseReport();
+      LOG_VAR( trial_result_ref.performance.report.evaluations_per_second );
+      LOG_VAR( trial_result_ref.overshoot_seconds );
+      continue;
+    }
+
+    r3dp::brkga::BRKGA<decoder_t, r3dp::brkga::MTRand> algorithm(
+      r3dp::core::vertex_count( graph ),
+      opt.population_size,
+      opt.elite_fraction,
+      opt.mutant_fraction,
+      opt.elite_inheritance_prob,
+      decoder,
+      rng,
+      opt.num_populations,
+      opt.num_threads,
+      opt.numa_placement.cpus,
+      opt.numa_placement.domains );
+    algorithm.setPerfCounters( opt.perf_counters );
+    algorithm.setBatchDecoding( opt.batch_decode );
+    algorithm.setDeltaDecoding( opt.delta_decode );
+    algorithm.setMigrationTopology( opt.migration_topology );
+
+    // Migração assíncrona: as ilhas só se esperam no fim de cada bloco de gerações do laço abaixo
+    const bool async_migration =
+      opt.async_migration && opt.migration_size > 0 && opt.num_populations > 1;
+    if ( async_migration ) {
+      algorithm.setAsyncMigration( opt.migration_interval, opt.migration_size );
+      trial_result_ref.async_migration_enabled = true;
+    }
+
+    // Partida a quente: parte dos não-elite de cada ilha vira soluções gulosas codificadas
+    const unsigned seeds_per_island =
+      std::min( unsigned( opt.greedy_seed_fraction * opt.population_size ),
+                algorithm.getP() - algorithm.getPe() );
+    if ( seeds_per_island > 0 ) {
+      const auto          seed_start = std::chrono::steady_clock::now();
+      const unsigned      count      = seeds_per_island * opt.num_populations;
+      const std::uint64_t seed       = ( std::uint64_t{ rng.randInt() } << 32 ) | rng.randInt();
+      algorithm.seedPopulations( greedy_seeds( graph, count, opt.num_threads, seed ) );
+
+      trial_result_ref.greedy_seed_count = count;
+      trial_result_ref.greedy_seed_seconds =
+        std::chrono::duration<double>( std::chrono::steady_clock::now() - seed_start ).count();
+      trial_result_ref.best_fitness_value = algorithm.getBestFitness();
+      trial_result_ref.add_point( trial_result_ref.best_fitness_value );
+      LOG_MESSAGE( count << " cromossomos gulosos nas populações iniciais; melhor: "
+                         << trial_result_ref.best_fitness_value );
+    }
+
+    // Modo adaptativo: a configuração da linha de comando e suas vizinhas disputam cada geração
+    std::optional<r3dp::brkga::adaptive_parameters> controller;
+    double                                          diversity = 0.0;
+    std::vector<double>                             island_best( opt.num_populations );
+    if ( opt.adaptive_parameters ) {
+      const r3dp::brkga::parameter_arm base{ opt.elite_fraction,
+                                             opt.mutant_fraction,
+                                             opt.elite_inheritance_prob };
+      auto arms = r3dp::brkga::adaptive_parameters::arms_around( base, opt.population_size );
+      controller.emplace( std::move( arms ), opt.diversity_floor );
+      diversity = algorithm.getDiversity();
+      LOG_MESSAGE( "Parâmetros adaptativos com " << controller->get_arms().size() << " braços" );
+    }
+
+    // Reinícios parciais: ilhas estagnadas guardam a elite e sorteiam o resto
+    std::optional<r3dp::brkga::stagnation_monitor> monitor;
+    std::vector<double>                            island_best_now( opt.num_populations );
+    if ( opt.restart.enabled() ) {
+      monitor.emplace( opt.num_populations, opt.restart );
+      trial_result_ref.restarts_enabled = true;
+    }
+
+    // Religamento: uma rodada por vez roda em paralelo com as gerações seguintes
+    std::future<relink_round> relink_job;
+    trial_result_ref.path_relinking_enabled = relink_pool.has_value();
+
+    // O prazo também é verificado dentro da decodificação; a geração interrompida é descartada
+    const auto deadline = trial_result_ref.start_time_point + opt.time_limit;
+    const r3dp::core::cancellation_token token( deadline );
+    if ( opt.telemetry ) {
+      opt.telemetry->begin_trial(
+        unsigned( trial_idx ), opt.num_trials, deadline, opt.max_generations );
+      opt.telemetry->publish( 0, algorithm.getBestFitness() );
+    }
+    while ( true ) {
+      if ( opt.max_generations > 0 && generation_idx >= opt.max_generations ) {
+        LOG_MESSAGE( "Limite de gerações atingido." );
+        trial_result_ref.record_stop( "max_generations", deadline );
+        break;
+      }
+
+      unsigned arm = 0;
+      if ( controller ) {
+        arm                                 = controller->choose( diversity );
+        const r3dp::brkga::parameter_arm &a = controller->get_arms()[arm];
+        algorithm.setParameters( a.elite_fraction, a.mutant_fraction, a.elite_inheritance_prob );
+        for ( unsigned k = 0; k < opt.num_populations; ++k ) {
+          island_best[k] = algorithm.getPopulation( k ).getBestFitness();
+        }
+      }
+
+      unsigned step = 1;
+      if ( async_migration ) {
+        step = opt.migration_interval;
+        if ( opt.max_generations > 0 ) {
+          step = std::min( step, opt.max_generations - generation_idx );
+        }
+      }
+      if ( !algorithm.evolve( step, token ) ) {
+        LOG_MESSAGE( "Limite de tempo atingido." );
+        trial_result_ref.record_stop( "time_limit", deadline );
+        break;
+      }
+      generation_idx += step;
+
+      double best_fitness_now = algorithm.getBestFitness();
+      trial_result_ref.add_point( best_fitness_now );
+
+      // Diversidade por ilha, medida uma vez por geração quando alguém a usa
+      std::vector<double> island_diversity;
+      if ( controller || opt.restart.uses_diversity() ) {
+        for ( unsigned k = 0; k < opt.num_populations; ++k ) {
+          island_diversity.push_back( algorithm.getDiversity( k ) );
+        }
+      }
+
+      // Telemetria: a cada geração só stores relaxados; avaliações e diversidade por intervalo
+      if ( opt.telemetry ) {
+        opt.telemetry->publish( generation_idx, best_fitness_now );
+        if ( opt.telemetry->refresh_due() ) {
+          opt.telemetry->publish_evaluations( algorithm.getPhaseReport().evaluations );
+          for ( unsigned k = 0; k < opt.num_populations; ++k ) {
+            opt.telemetry->publish_diversity(
+              k, island_diversity.empty() ? algorithm.getDiversity( k ) : island_diversity[k] );
+          }
+        }
+      }
+
+      if ( controller ) {
+        // Recompensa: fração das ilhas que melhoraram nesta geração (migrações não contam)
+        unsigned improved = 0;
+        for ( unsigned k = 0; k < opt.num_populations; ++k ) {
+          improved += algorithm.getPopulation( k ).getBestFitness() < island_best[k];
+        }
+        const double reward = double( improved ) / opt.num_populations;
+        diversity           = 0.0;
+        for ( double d : island_diversity ) {
+          diversity += d / opt.num_populations;
+        }
+        controller->reward( arm, reward );
+
+        const r3dp::brkga::parameter_arm &a = controller->get_arms()[arm];
+        trial_result_ref.parameter_trajectory.push_back( { generation_idx,
+                                                           trial_result_ref.elapsed_seconds(),
+                                                           arm,
+                                                           a.elite_fraction,
+                                                           a.mutant_fraction,
+                                                           a.elite_inheritance_prob,
+                                                           reward,
+                                                           diversity,
+                                                           best_fitness_now } );
+      }
+
+      // O reinício não é interrompido pelo prazo: depois dele não vale a pena começar um
+      if ( monitor && !token.stop_requested() ) {
+        for ( unsigned k = 0; k < opt.num_populations; ++k ) {
+          island_best_now[k] = algorithm.getPopulation( k ).getBestFitness();
+        }
+        const auto stagnated = monitor->check( generation_idx, island_best_now, island_diversity );
+
+        std::vector<unsigned> islands;
+        for ( const auto &s : stagnated ) {
+          islands.push_back( s.island );
+          monitor->restarted( s.island, generation_idx );
+          trial_result_ref.restarts.push_back(
+            { generation_idx,
+              trial_result_ref.elapsed_seconds(),
+              s.island,
+              r3dp::brkga::stagnation_reason_name( s.reason ),
+              island_best_now[s.island],
+              island_diversity.empty() ? -1.0 : island_diversity[s.island] } );
+        }
+        if ( !islands.empty() ) {
+          algorithm.restart( islands, opt.restart.keep( opt.population_size, algorithm.getPe() ) );
+          LOG_MESSAGE( "Reinício parcial de " << islands.size() << " ilha(s) na geração "
+                                              << generation_idx );
+        }
+      }
+
+      if ( best_fitness_now < trial_result_ref.best_fitness_value ) {
+        trial_result_ref.best_fitness_value = best_fitness_now;
+        LOG_MESSAGE( "Novo melhor fitness encontrado na geração " << generation_idx << ": "
+                                                                  << best_fitness_now );
+      }
+
+      if ( !async_migration && opt.migration_size > 0 && opt.num_populations > 1 &&
+           opt.migration_interval > 0 && generation_idx % opt.migration_interval == 0 ) {
+        algorithm.exchangeElite( opt.migration_size );
+        LOG_MESSAGE( "Migração de elite executada na geração " << generation_idx );
+      }
+
+      if ( relink_pool && !token.stop_requested() ) {
+        // Recolhe a rodada terminada; o ponto é injetado como um migrante
+        if ( relink_job.valid() &&
+             relink_job.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready ) {
+          const relink_round round   = relink_job.get();
+          auto              &summary = trial_result_ref.path_relinking;
+          ++summary.rounds;
+          summary.relinks += round.relinks;
+          if ( !round.keys.empty() && algorithm.injectMigrant( round.keys, round.fitness ) ) {
+            ++summary.injections;
+            summary.best_fitness_value = std::min( summary.best_fitness_value, round.fitness );
+            if ( round.fitness < trial_result_ref.best_fitness_value ) {
+              ++summary.improvements;
+              trial_result_ref.best_fitness_value = round.fitness;
+              trial_result_ref.add_point( round.fitness );
+              LOG_MESSAGE( "Novo melhor fitness por religamento na geração " << generation_idx
+                                                                             << ": "
+                                                                             << round.fitness );
+            }
+          }
+        }
+
+        // Lança a próxima rodada com os rótulos das elites atuais
+        if ( !relink_job.valid() ) {
+          unsigned per_island = 1;  // o melhor de cada ilha
+          if ( opt.num_populations == 1 ) {
+            per_island = std::min( SINGLE_ISLAND_RELINK_ELITES, algorithm.getPe() );
+          }
+
+          std::vector<std::vector<std::uint8_t>> elites;
+          r3dp::brkga::decode_context            ctx;
+          ctx.cancel = &token;
+          for ( unsigned k = 0; k < opt.num_populations && !ctx.cancelled; ++k ) {
+            for ( unsigned r = 0; r < per_island && !ctx.cancelled; ++r ) {
+              const auto &chromosome = algorithm.getPopulation( k ).getChromosome( r );
+              auto       &labels     = elites.emplace_back();
+              (void)decoder.decode( std::span<const double>( chromosome ), labels, ctx );
+            }
+          }
+
+          const std::uint64_t seed = ( std::uint64_t{ rng.randInt() } << 32 ) | rng.randInt();
+          if ( !ctx.cancelled && elites.size() > 1 ) {
+            relink_job = std::async( std::launch::async, [&, elites = std::move( elites ), seed] {
+              return relink_elites( relinkers, *relink_pool, elites, seed, token );
+            } );
+          }
+        }
+      }
+    }
+
+    // A rodada em andamento também para pelo prazo; o resultado dela é descartado
+    if ( relink_job.valid() ) {
+      relink_job.wait();
+    }
+
+    trial_result_ref.performance.report = algorithm.getPhaseReport();
+    trial_result_ref.async_migration    = algorithm.getMigrationStats();
+    LOG_VAR( trial_result_ref.performance.report.evaluations_per_second );
+    LOG_VAR( trial_result_ref.overshoot_seconds );
+
+    if ( controller ) {
+      trial_result_ref.parameter_arms      = controller->get_arms();
+      trial_result_ref.parameter_arm_pulls = controller->get_pulls();
+    }
+
+    trial_result_ref.hardware_counters.report = algorithm.getPerfReport();
+    if ( opt.perf_counters && !trial_result_ref.hardware_counters.report.available ) {
+      LOG_ERR( "Contadores de hardware indisponíveis: "
+               << trial_result_ref.hardware_counters.report.error );
+    }
+  }
 }
 
 int main( int argc, char *argv[] ) {
@@ -137,7 +883,7 @@ int main( int argc, char *argv[] ) {
   argv = app.ensure_utf8( argv );
 
   std::string input_file_path = "default.txt";
-  app.add_option( "-f,--file", input_file_path, "Arquivo de arestas (edges.txt)" )
+  app.add_option( "-f,--file", input_file_path, "Arquivo de arestas (edges.txt, .gz ou .zst)" )
     ->required()
     ->check( CLI::ExistingFile );
 
@@ -172,8 +918,11 @@ int main( int argc, char *argv[] ) {
   app.add_option( "-j,--threads", num_threads, "Número de threads (>= 1)" )
     ->check( CLI::PositiveNumber );
 
-  unsigned int time_limit_seconds = DEFAULT_TIME_LIMIT_SECONDS;
-  app.add_option( "--time-limit", time_limit_seconds, "Tempo máximo em segundos (> 0)" )
+  double time_limit_seconds = DEFAULT_TIME_LIMIT_SECONDS;
+  app
+    .add_option( "--time-limit",
+                 time_limit_seconds,
+                 "Tempo máximo em segundos (> 0; aceita frações, resolução de 1 ms)" )
     ->check( CLI::PositiveNumber )
     ->required();
 
@@ -195,6 +944,20 @@ int main( int argc, char *argv[] ) {
       "--migration-size", migration_size, "Melhores indivíduos trocados entre populações (>= 0)" )
     ->check( CLI::Range( 0U, std::numeric_limits<unsigned>::max() ) );
 
+  std::string migration_topology = "all-to-all";
+  app
+    .add_option( "--migration-topology",
+                 migration_topology,
+                 "Para quem cada ilha envia sua elite: all-to-all, ring, torus, random (um destino "
+                 "sorteado a cada migração) ou hypercube" )
+    ->check( CLI::IsMember( { "all-to-all", "ring", "torus", "random", "hypercube" } ) );
+
+  bool async_migration = false;
+  app.add_flag( "--async-migration",
+                async_migration,
+                "Migração assíncrona: cada ilha evolui no seu ritmo e envia a elite por filas sem "
+                "trava; o laço principal avança em blocos de --migration-interval gerações" );
+
   std::string output_file_path = "default.json";
   app.add_option( "-o,--output", output_file_path, "Arquivo de resultados (results.json)" )
     ->required();
@@ -207,6 +970,146 @@ int main( int argc, char *argv[] ) {
   app.add_option( "--seed", rng_seed_cli, "Semente do RNG (0 = aleatória)" )
     ->check( CLI::Range( uint64_t{ 0 }, std::numeric_limits<uint64_t>::max() ) );
 
+  std::string engine = "generational";
+  app
+    .add_option( "--engine",
+                 engine,
+                 "Motor: generational (BRKGA com ilhas), steady-state (assíncrono, sem barreira) "
+                 "ou greedy (só a construção gulosa, em tempo linear)" )
+    ->check( CLI::IsMember( { "generational", "steady-state", "greedy" } ) );
+
+  unsigned decode_threads = 1;
+  app
+    .add_option( "--decode-threads",
+                 decode_threads,
+                 "Threads dentro de uma única decodificação (>= 1; para grafos muito grandes)" )
+    ->check( CLI::PositiveNumber );
+
+  bool perf_counters = false;
+  app.add_flag( "--perf-counters",
+                perf_counters,
+                "Mede contadores de hardware (perf_event_open) em crossover, decode e reparo" );
+
+  bool batch_decode = false;
+  app.add_flag( "--batch-decode",
+                batch_decode,
+                "Decodifica cada geração em lotes bit-sliced (64 ou 256 cromossomos por varredura)" );
+
+  bool delta_decode = false;
+  app.add_flag( "--delta-decode",
+                delta_decode,
+                "Decodifica cada filho a partir da solução do pai de elite, reparando só em torno "
+                "dos genes que mudaram (mesmo fitness; tem precedência sobre --batch-decode)" );
+
+  bool adaptive_parameters = false;
+  app.add_flag( "--adaptive-parameters",
+                adaptive_parameters,
+                "Ajusta elite, mutantes e herança por geração (bandit em torno desses valores)" );
+
+  double diversity_floor = r3dp::brkga::adaptive_parameters::DEFAULT_DIVERSITY_FLOOR;
+  app
+    .add_option( "--diversity-floor",
+                 diversity_floor,
+                 "Diversidade de rótulos abaixo da qual o modo adaptativo força mais mutantes" )
+    ->check( CLI::Range( 0.0, 1.0 ) );
+
+  bool path_relinking = false;
+  app.add_flag( "--path-relinking",
+                path_relinking,
+                "Religa caminhos entre as elites das ilhas em threads próprias e injeta o melhor "
+                "ponto como migrante" );
+
+  unsigned relink_threads = DEFAULT_RELINK_THREADS;
+  app
+    .add_option( "--relink-threads",
+                 relink_threads,
+                 "Threads do religamento de caminhos, além das de -j (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  double greedy_seed_fraction = 0.0;
+  app
+    .add_option( "--greedy-seed-fraction",
+                 greedy_seed_fraction,
+                 "Fração de cada população inicial trocada por soluções gulosas (a determinística "
+                 "e variantes aleatórias) em [0,1]; limitada aos não-elite" )
+    ->check( CLI::Range( 0.0, 1.0 ) );
+
+  restart_policy restart;
+  app
+    .add_option( "--restart-stall",
+                 restart.stall_generations,
+                 "Gerações sem melhora após as quais uma ilha é reiniciada (0 = desabilita)" )
+    ->check( CLI::Range( 0U, std::numeric_limits<unsigned>::max() ) );
+  app
+    .add_option( "--restart-diversity",
+                 restart.diversity_floor,
+                 "Reinicia a ilha que não melhorou e cuja diversidade de rótulos caiu abaixo disso "
+                 "(0 = desabilita)" )
+    ->check( CLI::Range( 0.0, 1.0 ) );
+  app
+    .add_option( "--restart-keep",
+                 restart.keep_fraction,
+                 "Fração da população mantida no reinício em [0,1] (0 = a elite)" )
+    ->check( CLI::Range( 0.0, 1.0 ) );
+
+  bool numa = false;
+  app.add_flag( "--numa",
+                numa,
+                "Distribui as threads pelos nós NUMA (sysfs), cada ilha nas de um nó, e intercala "
+                "o grafo entre os nós" );
+
+  r3dp::core::telemetry_options telemetry_options;
+  app.add_option( "--telemetry-socket",
+                  telemetry_options.socket_path,
+                  "Socket Unix da telemetria ao vivo (HTTP: GET /metrics no formato do Prometheus, "
+                  "GET /status em JSON)" );
+  app
+    .add_option( "--telemetry-port",
+                 telemetry_options.http_port,
+                 "Porta HTTP da telemetria ao vivo em 127.0.0.1 (0 = desabilita)" )
+    ->check( CLI::Range( 0U, 65535U ) );
+  app.add_option( "--telemetry-file",
+                  telemetry_options.file_path,
+                  "Arquivo de texto do Prometheus reescrito a cada intervalo (coletor textfile do "
+                  "node_exporter)" );
+
+  double telemetry_interval = DEFAULT_TELEMETRY_INTERVAL;
+  app
+    .add_option( "--telemetry-interval",
+                 telemetry_interval,
+                 "Segundos entre gravações do arquivo e amostras de avaliações e diversidade" )
+    ->check( CLI::PositiveNumber );
+  app.add_option( "--telemetry-run",
+                  telemetry_options.run,
+                  "Rótulo run das métricas da telemetria (padrão: <grafo>-<semente>)" );
+
+  std::string graph_backend = "adjacency-list";
+  app
+    .add_option( "--graph-backend",
+                 graph_backend,
+                 "Representação do grafo: adjacency-list (Boost), csr (construção em fluxo, "
+                 "com memória limitada) ou compressed (csr com listas comprimidas)" )
+    ->check( CLI::IsMember( { "adjacency-list", "csr", "compressed" } ) );
+
+  std::size_t memory_budget_mb = DEFAULT_MEMORY_BUDGET_MB;
+  app
+    .add_option( "--memory-budget-mb",
+                 memory_budget_mb,
+                 "Memória para blocos de arestas na construção csr, em MiB (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  std::string spill_directory;
+  app.add_option( "--spill-dir",
+                  spill_directory,
+                  "Diretório dos blocos temporários da construção csr (padrão: diretório temporário)" );
+
+  unsigned parse_threads = DEFAULT_PARSE_THREADS;
+  app
+    .add_option( "--parse-threads",
+                 parse_threads,
+                 "Threads que convertem o texto do arquivo de arestas (a descompressão usa mais uma)" )
+    ->check( CLI::PositiveNumber );
+
   CLI11_PARSE( app, argc, argv );
 
   if ( elite_fraction + mutant_fraction > 1.0 + 1e-12 ) {
@@ -223,6 +1126,8 @@ int main( int argc, char *argv[] ) {
   }
 
   const uint64_t rng_seed_to_use = ( rng_seed_cli == 0 ) ? generate_random_seed() : rng_seed_cli;
+  const std::chrono::milliseconds time_limit{ std::max<long long>(
+    1, std::llround( time_limit_seconds * 1000.0 ) ) };
 
   // ---------- logs ----------
   LOG_VAR( input_file_path );
@@ -236,78 +1141,188 @@ int main( int argc, char *argv[] ) {
   LOG_VAR( max_generations );
   LOG_VAR( migration_interval );
   LOG_VAR( migration_size );
+  LOG_VAR( migration_topology );
+  LOG_VAR( async_migration );
   LOG_VAR( num_trials );
   LOG_VAR( output_file_path );
   LOG_VAR( rng_seed_to_use );
+  LOG_VAR( engine );
+  LOG_VAR( decode_threads );
+  LOG_VAR( perf_counters );
+  LOG_VAR( batch_decode );
+  LOG_VAR( delta_decode );
+  LOG_VAR( adaptive_parameters );
+  LOG_VAR( diversity_floor );
+  LOG_VAR( restart.stall_generations );
+  LOG_VAR( restart.diversity_floor );
+  LOG_VAR( restart.keep_fraction );
+  LOG_VAR( path_relinking );
+  LOG_VAR( relink_threads );
+  LOG_VAR( greedy_seed_fraction );
+  LOG_VAR( numa );
+  LOG_VAR( telemetry_options.socket_path );
+  LOG_VAR( telemetry_options.http_port );
+  LOG_VAR( telemetry_options.file_path );
+  LOG_VAR( telemetry_interval );
+  LOG_VAR( graph_backend );
+  LOG_VAR( memory_budget_mb );
+  LOG_VAR( parse_threads );
 
   r3dp::brkga::MTRand rng( rng_seed_to_use );
 
-  auto [vertex_count_total, edge_list] = r3dp::core::read_graph_from_file( input_file_path );
-  const auto graph = r3dp::core::build_graph_from( vertex_count_total, edge_list );
-
   std::string graph_name = std::filesystem::path( input_file_path ).stem().string();
-
-  LOG_VAR( vertex_count_total );
-  LOG_VAR( edge_list.size() );
   LOG_VAR( graph_name );
 
   run_results run_result;
-  run_result.seed  = rng_seed_to_use;
-  run_result.graph = create_graph_summary( graph_name, vertex_count_total, edge_list.size() );
+  run_result.seed                 = rng_seed_to_use;
+  run_result.engine               = engine;
+  run_result.time_limit_seconds   = std::chrono::duration<double>( time_limit ).count();
+  run_result.memory.graph_backend = graph_backend;
 
-  for ( size_t trial_idx = 0; trial_idx < num_trials; ++trial_idx ) {
-    LOG_MESSAGE( "Iniciando tentativa: " << trial_idx );
+  if ( engine == "steady-state" &&
+       ( num_populations > 1 || perf_counters || batch_decode || delta_decode ||
+         adaptive_parameters || restart.enabled() || path_relinking ||
+         greedy_seed_fraction > 0.0 || numa ) ) {
+    LOG_MESSAGE( "steady-state usa uma única população e ignora migração, --perf-counters, "
+                 "--batch-decode, --delta-decode, --adaptive-parameters, os reinícios parciais, "
+                 "--path-relinking, --greedy-seed-fraction e, de --numa, tudo menos a "
+                 "intercalação do grafo" );
+  }
 
-    auto    &trial_result_ref = run_result.create_trial();
-    unsigned generation_idx   = 0;
+  std::vector<r3dp::core::numa_node> numa_nodes;
+  r3dp::core::thread_placement       numa_placement;
+  if ( numa ) {
+    numa_nodes     = r3dp::core::numa_nodes();
+    numa_placement = r3dp::core::numa_placement( num_threads, numa_nodes );
+    run_result.numa.emplace();
+    run_result.numa->nodes          = numa_nodes;
+    run_result.numa->thread_domains = numa_placement.domains;
+    LOG_MESSAGE( "NUMA: " << numa_nodes.size() << " nó(s), " << numa_placement.domain_count()
+                          << " com threads do BRKGA" );
+  }
 
-    trial_result_ref.start_timer();
+  // Telemetria ao vivo: sobe antes da leitura do grafo, que também pode demorar
+  std::optional<r3dp::core::telemetry> telemetry;
+  if ( telemetry_options.enabled() ) {
+    if ( telemetry_options.run.empty() ) {
+      telemetry_options.run = graph_name + "-" + std::to_string( rng_seed_to_use );
+    }
+    telemetry_options.interval = std::chrono::milliseconds(
+      std::max<long long>( 1, std::llround( telemetry_interval * 1000.0 ) ) );
+    try {
+      telemetry.emplace( telemetry_options, engine == "steady-state" ? 1 : num_populations );
+    } catch ( const std::exception &e ) {
+      LOG_ERR( e.what() );
+      return 1;
+    }
+    LOG_MESSAGE( "Telemetria ao vivo com run=\"" << telemetry_options.run << "\"" );
+  }
 
-    r3dp::brkga::R3DPDecoder                                          decoder( graph );
-    r3dp::brkga::BRKGA<r3dp::brkga::R3DPDecoder, r3dp::brkga::MTRand> algorithm(
-      boost::num_vertices( graph ),
-      population_size,
-      elite_fraction,
-      mutant_fraction,
-      elite_inheritance_prob,
-      decoder,
-      rng,
-      num_populations,
-      num_threads );
+  const auto        topology = r3dp::brkga::parse_migration_topology( migration_topology );
+  const run_options options{ .engine                 = engine,
+                             .population_size        = population_size,
+                             .elite_fraction         = elite_fraction,
+                             .mutant_fraction        = mutant_fraction,
+                             .elite_inheritance_prob = elite_inheritance_prob,
+                             .num_populations        = num_populations,
+                             .num_threads            = num_threads,
+                             .decode_threads         = decode_threads,
+                             .max_generations        = max_generations,
+                             .migration_interval     = migration_interval,
+                             .migration_size         = migration_size,
+                             .num_trials             = num_trials,
+                             .time_limit             = time_limit,
+                             .perf_counters          = perf_counters,
+                             .batch_decode           = batch_decode,
+                             .delta_decode           = delta_decode,
+                             .adaptive_parameters    = adaptive_parameters,
+                             .diversity_floor        = diversity_floor,
+                             .restart                = restart,
+                             .path_relinking         = path_relinking,
+                             .relink_threads         = relink_threads,
+                             .greedy_seed_fraction   = greedy_seed_fraction,
+                             .numa_nodes             = numa_nodes,
+                             .numa_placement         = numa_placement,
+                             .migration_topology     = topology,
+                             .async_migration        = async_migration,
+                             .telemetry              = telemetry ? &*telemetry : nullptr };
 
-    while ( true ) {
-      auto elapsed_time_delta =
-        std::chrono::steady_clock::now() - trial_result_ref.start_time_point;
+  r3dp::core::edge_stream_options stream_options;
+  stream_options.parser_threads = parse_threads;
 
-      if ( std::chrono::duration_cast<std::chrono::seconds>( elapsed_time_delta ).count() >=
-           time_limit_seconds ) {
-        LOG_MESSAGE( "Limite de tempo atingido." );
-        break;
-      }
-      if ( max_generations > 0 && generation_idx >= max_generations ) {
-        LOG_MESSAGE( "Limite de gerações atingido." );
-        break;
-      }
+  try {
+    // O grafo é lido por threads de todos os nós: com --numa suas páginas são intercaladas. Só a
+    // construção fica sob a política (as populações são alocadas depois, cada uma no seu nó)
+    std::optional<r3dp::core::scoped_interleave> interleave;
+    if ( numa ) {
+      interleave.emplace( numa_nodes );
+      run_result.numa->graph_interleaved = interleave->active();
+    }
 
-      algorithm.evolve();
-      generation_idx++;
+    const auto build_start = std::chrono::steady_clock::now();
+    if ( graph_backend == "csr" || graph_backend == "compressed" ) {
+      r3dp::core::streaming_build_options build_options;
+      build_options.memory_budget_bytes = std::size_t{ memory_budget_mb } << 20;
+      build_options.spill_directory     = spill_directory;
+      build_options.input               = stream_options;
 
-      double best_fitness_now = algorithm.getBestFitness();
-      trial_result_ref.add_point( best_fitness_now );
+      r3dp::core::streaming_build_stats build_stats;
+      auto csr = r3dp::core::build_csr_from_file( input_file_path, build_options, &build_stats );
 
-      if ( best_fitness_now < trial_result_ref.best_fitness_value ) {
-        trial_result_ref.best_fitness_value = best_fitness_now;
-        LOG_MESSAGE( "Novo melhor fitness encontrado na geração " << generation_idx << ": "
-                                                                  << best_fitness_now );
-      }
+      LOG_VAR( csr.vertex_count() );
+      LOG_VAR( csr.edge_count() );
+      LOG_VAR( build_stats.spilled_runs );
+      run_result.graph = create_graph_summary(
+        graph_name, static_cast<std::uint32_t>( csr.vertex_count() ), csr.edge_count() );
+      run_result.memory.spilled_runs  = build_stats.spilled_runs;
+      run_result.memory.spilled_bytes = build_stats.spilled_bytes;
 
-      if ( migration_size > 0 && num_populations > 1 && migration_interval > 0 &&
-           generation_idx % migration_interval == 0 ) {
-        algorithm.exchangeElite( migration_size );
-        LOG_MESSAGE( "Migração de elite executada na geração " << generation_idx );
+      if ( graph_backend == "compressed" ) {
+        // O CSR só existe até a compressão; a busca roda apenas com a versão comprimida
+        const auto graph = r3dp::core::compress( csr );
+        csr = {};
+        run_result.memory.graph_build_seconds =
+          std::chrono::duration<double>( std::chrono::steady_clock::now() - build_start ).count();
+        run_result.memory.graph_bytes               = graph.memory_bytes();
+        run_result.memory.peak_rss_after_load_bytes = r3dp::core::peak_rss_bytes();
+        LOG_VAR( run_result.memory.graph_bytes );
+        LOG_VAR( run_result.memory.peak_rss_after_load_bytes );
+
+        interleave.reset();
+        run_trials( graph, options, rng, run_result );
+      } else {
+        run_result.memory.graph_build_seconds       = build_stats.seconds;
+        run_result.memory.graph_bytes               = csr.memory_bytes();
+        run_result.memory.peak_rss_after_load_bytes = r3dp::core::peak_rss_bytes();
+        LOG_VAR( run_result.memory.graph_bytes );
+        LOG_VAR( run_result.memory.peak_rss_after_load_bytes );
+
+        interleave.reset();
+        run_trials( csr, options, rng, run_result );
       }
+    } else {
+      auto [vertex_count_total, edge_list] =
+        r3dp::core::read_graph_from_file( input_file_path, stream_options );
+      const auto graph = r3dp::core::build_graph_from( vertex_count_total, edge_list );
+
+      LOG_VAR( vertex_count_total );
+      LOG_VAR( edge_list.size() );
+      run_result.graph = create_graph_summary( graph_name, vertex_count_total, edge_list.size() );
+      run_result.memory.graph_build_seconds =
+        std::chrono::duration<double>( std::chrono::steady_clock::now() - build_start ).count();
+      run_result.memory.peak_rss_after_load_bytes = r3dp::core::peak_rss_bytes();
+      LOG_VAR( run_result.memory.peak_rss_after_load_bytes );
+
+      // A lista de arestas não é mais necessária durante a busca
+      edge_list = {};
+      interleave.reset();
+      run_trials( graph, options, rng, run_result );
     }
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "Falha na execução: " << e.what() );
+    return 1;
   }
+  run_result.memory.peak_rss_bytes = r3dp::core::peak_rss_bytes();
 
   run_result.save_json( output_file_path );
   return 0;
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "graph.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Palavras de 64 bits por vértice em um lote: 4 (256 rotulações) quando o alvo tem AVX2,
+   * para que os laços sobre as palavras sejam vetorizados, e 1 (64 rotulações) nos demais.
+   */
+#if defined( __AVX2__ )
+  inline constexpr std::size_t batch_words = 4;
+#else
+  inline constexpr std::size_t batch_words = 1;
+#endif
+
+  /// @brief Um bit por rotulação do lote (bit l da palavra l / 64 corresponde à pista l).
+  template <std::size_t W>
+  using lane_mask = std::array<std::uint64_t, W>;
+
+  template <std::size_t W>
+  [[nodiscard]] constexpr bool any( const lane_mask<W> &m ) noexcept {
+    std::uint64_t acc = 0;
+    for ( std::size_t w = 0; w < W; ++w ) {
+      acc |= m[w];
+    }
+    return acc != 0;
+  }
+
+  template <std::size_t W>
+  [[nodiscard]] constexpr std::size_t popcount( const lane_mask<W> &m ) noexcept {
+    std::size_t count = 0;
+    for ( std::size_t w = 0; w < W; ++w ) {
+      count += static_cast<std::size_t>( std::popcount( m[w] ) );
+    }
+    return count;
+  }
+
+  /// @brief a & b, pista a pista.
+  template <std::size_t W>
+  [[nodiscard]] constexpr lane_mask<W> masked( const lane_mask<W> &a,
+                                               const lane_mask<W> &b ) noexcept {
+    lane_mask<W> m;
+    for ( std::size_t w = 0; w < W; ++w ) {
+      m[w] = a[w] & b[w];
+    }
+    return m;
+  }
+
+  /// @brief Máscara com as `lanes` primeiras pistas ligadas.
+  template <std::size_t W>
+  [[nodiscard]] constexpr lane_mask<W> first_lanes( std::size_t lanes ) noexcept {
+    lane_mask<W> m{};
+    for ( std::size_t w = 0; w < W; ++w ) {
+      if ( lanes >= 64 * ( w + 1 ) ) {
+        m[w] = ~std::uint64_t{ 0 };
+      } else if ( lanes > 64 * w ) {
+        m[w] = ( std::uint64_t{ 1 } << ( lanes - 64 * w ) ) - 1;
+      }
+    }
+    return m;
+  }
+
+  /**
+   * @brief 64·W rotulações {0,1,2,3} de um mesmo grafo em dois planos de bits por vértice.
+   *
+   * O rótulo da pista l no vértice v é `2·high(v)[l] + low(v)[l]`. Guardar por vértice (e não por
+   * rotulação) faz uma única varredura da adjacência servir todas as pistas.
+   */
+  template <std::size_t W = batch_words>
+  class label_batch {
+  public:
+    static constexpr std::size_t lanes = 64 * W;
+
+    explicit label_batch( std::size_t vertices ) : low( vertices ), high( vertices ) {}
+
+    [[nodiscard]] std::size_t vertex_count() const noexcept {
+      return low.size();
+    }
+
+    [[nodiscard]] lane_mask<W> &low_bits( std::size_t v ) noexcept {
+      return low[v];
+    }
+    [[nodiscard]] const lane_mask<W> &low_bits( std::size_t v ) const noexcept {
+      return low[v];
+    }
+    [[nodiscard]] lane_mask<W> &high_bits( std::size_t v ) noexcept {
+      return high[v];
+    }
+    [[nodiscard]] const lane_mask<W> &high_bits( std::size_t v ) const noexcept {
+      return high[v];
+    }
+
+    void set( std::size_t v, std::size_t lane, std::uint8_t label ) noexcept {
+      const std::uint64_t bit = std::uint64_t{ 1 } << ( lane % 64 );
+      std::uint64_t      &lo  = low[v][lane / 64];
+      std::uint64_t      &hi  = high[v][lane / 64];
+      lo                      = ( label & 1U ) ? ( lo | bit ) : ( lo & ~bit );
+      hi                      = ( label & 2U ) ? ( hi | bit ) : ( hi & ~bit );
+    }
+
+    [[nodiscard]] std::uint8_t get( std::size_t v, std::size_t lane ) const noexcept {
+      const unsigned shift = lane % 64;
+      return static_cast<std::uint8_t>( ( ( high[v][lane / 64] >> shift ) & 1U ) << 1 |
+                                        ( ( low[v][lane / 64] >> shift ) & 1U ) );
+    }
+
+  private:
+    std::vector<lane_mask<W>> low;
+    std::vector<lane_mask<W>> high;
+  };
+
+  /**
+   * @brief Soma de rótulos por pista em 2 bits, saturada em 3 (somador ripple de 2 bits).
+   *
+   * As regras da dominação {3}-romana só comparam somas com 2 e 3, então saturar basta.
+   */
+  template <std::size_t W>
+  struct saturating_sum {
+    lane_mask<W> bit0{};
+    lane_mask<W> bit1{};
+
+    void add( const lane_mask<W> &x0, const lane_mask<W> &x1 ) noexcept {
+      for ( std::size_t w = 0; w < W; ++w ) {
+        const std::uint64_t carry0 = bit0[w] & x0[w];
+        const std::uint64_t sum0   = bit0[w] ^ x0[w];
+        const std::uint64_t sum1   = bit1[w] ^ x1[w] ^ carry0;
+        const std::uint64_t carry1 = ( bit1[w] & x1[w] ) | ( carry0 & ( bit1[w] ^ x1[w] ) );
+        bit0[w]                    = sum0 | carry1;
+        bit1[w]                    = sum1 | carry1;
+      }
+    }
+
+    /// @brief Pistas com soma < 2.
+    [[nodiscard]] lane_mask<W> below_two() const noexcept {
+      lane_mask<W> m;
+      for ( std::size_t w = 0; w < W; ++w ) {
+        m[w] = ~bit1[w];
+      }
+      return m;
+    }
+
+    /// @brief Pistas com soma < 3.
+    [[nodiscard]] lane_mask<W> below_three() const noexcept {
+      lane_mask<W> m;
+      for ( std::size_t w = 0; w < W; ++w ) {
+        m[w] = ~( bit1[w] & bit0[w] );
+      }
+      return m;
+    }
+  };
+
+  /**
+   * @brief Contador vertical: um contador binário por pista, com os bits em planos.
+   *
+   * `add` incrementa as pistas marcadas; o carry para assim que zera, então o custo amortizado é
+   * de ~2 planos por chamada.
+   */
+  template <std::size_t W>
+  class vertical_counter {
+  public:
+    void add( lane_mask<W> carry ) {
+      for ( auto &plane : planes ) {
+        bool pending = false;
+        for ( std::size_t w = 0; w < W; ++w ) {
+          const std::uint64_t next = plane[w] & carry[w];
+          plane[w] ^= carry[w];
+          carry[w]  = next;
+          pending  |= next != 0;
+        }
+        if ( !pending ) {
+          return;
+        }
+      }
+      if ( any( carry ) ) {
+        planes.push_back( carry );
+      }
+    }
+
+    [[nodiscard]] std::uint64_t value( std::size_t lane ) const noexcept {
+      std::uint64_t out = 0;
+      for ( std::size_t k = 0; k < planes.size(); ++k ) {
+        out |= ( ( planes[k][lane / 64] >> ( lane % 64 ) ) & 1U ) << k;
+      }
+      return out;
+    }
+
+  private:
+    std::vector<lane_mask<W>> planes;
+  };
+
+  /**
+   * @brief Versão em lote de is_valid_fdr3: pistas cujas rotulações são {3}-dominantes romanas.
+   *
+   * Todo vértice de rótulo 0 ou 1 precisa de soma >= 3 na vizinhança fechada. A soma de um vértice
+   * é interrompida assim que todas as pistas ainda abertas chegam a 3.
+   */
+  template <adjacency_graph Graph, std::size_t W>
+  [[nodiscard]] lane_mask<W> batch_feasible( const Graph &g, const label_batch<W> &batch ) {
+    lane_mask<W> violated{};
+    const auto   n = vertex_count( g );
+    for ( std::size_t v = 0; v < n; ++v ) {
+      lane_mask<W> open;
+      for ( std::size_t w = 0; w < W; ++w ) {
+        open[w] = ~batch.high_bits( v )[w] & ~violated[w];
+      }
+      if ( !any( open ) ) {
+        continue;
+      }
+
+      saturating_sum<W> sum;
+      sum.add( batch.low_bits( v ), batch.high_bits( v ) );
+      for ( auto u : neighbors( g, static_cast<vertex_t>( v ) ) ) {
+        if ( !any( masked( open, sum.below_three() ) ) ) {
+          break;
+        }
+        sum.add( batch.low_bits( u ), batch.high_bits( u ) );
+      }
+
+      const lane_mask<W> short_of_three = sum.below_three();
+      for ( std::size_t w = 0; w < W; ++w ) {
+        violated[w] |= open[w] & short_of_three[w];
+      }
+    }
+
+    for ( auto &word : violated ) {
+      word = ~word;
+    }
+    return violated;
+  }
+
+  /**
+   * @brief Peso (soma dos rótulos) de cada pista do lote.
+   */
+  template <std::size_t W>
+  [[nodiscard]] std::array<std::uint64_t, 64 * W> batch_weights( const label_batch<W> &batch ) {
+    vertical_counter<W> ones;
+    vertical_counter<W> twos;
+    for ( std::size_t v = 0; v < batch.vertex_count(); ++v ) {
+      ones.add( batch.low_bits( v ) );
+      twos.add( batch.high_bits( v ) );
+    }
+
+    std::array<std::uint64_t, 64 * W> weights{};
+    for ( std::size_t lane = 0; lane < weights.size(); ++lane ) {
+      weights[lane] = ones.value( lane ) + 2 * twos.value( lane );
+    }
+    return weights;
+  }
+
+}  // namespace r3dp::core
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Fila FIFO com capacidade limitada entre threads produtoras e consumidoras.
+   *
+   * `push` bloqueia com a fila cheia (é isso que limita a memória de um pipeline) e `pop` bloqueia
+   * com ela vazia. Depois de `close()` os `push` falham e os `pop` esvaziam o que restou e então
+   * devolvem nullopt, o que encerra produtores e consumidores sem sinal extra.
+   */
+  template <class T>
+  class bounded_queue {
+  public:
+    explicit bounded_queue( std::size_t capacity ) : capacity( capacity > 0 ? capacity : 1 ) {}
+
+    bounded_queue( const bounded_queue & )            = delete;
+    bounded_queue &operator=( const bounded_queue & ) = delete;
+
+    // Retorna false se a fila foi fechada (o item é descartado)
+    bool push( T item ) {
+      std::unique_lock lock( mutex );
+      not_full.wait( lock, [&] { return closed || items.size() < capacity; } );
+      if ( closed ) {
+        return false;
+      }
+      items.push_back( std::move( item ) );
+      lock.unlock();
+      not_empty.notify_one();
+      return true;
+    }
+
+    std::optional<T> pop() {
+      std::unique_lock lock( mutex );
+      not_empty.wait( lock, [&] { return closed || !items.empty(); } );
+      if ( items.empty() ) {
+        return std::nullopt;
+      }
+      T item = std::move( items.front() );
+      items.pop_front();
+      lock.unlock();
+      not_full.notify_one();
+      return item;
+    }
+
+    void close() {
+      {
+        std::lock_guard lock( mutex );
+        closed = true;
+      }
+      not_full.notify_all();
+      not_empty.notify_all();
+    }
+
+  private:
+    std::mutex              mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<T>           items;
+    std::size_t             capacity;
+    bool                    closed = false;
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Pedido de parada cooperativo, por chamada explícita ou por prazo.
+   *
+   * Quem executa trabalho longo consulta `stop_requested()` em pontos seguros e abandona o que
+   * estiver fazendo; quem o dirige decide o que descartar. Depois de expirado o prazo o token fica
+   * cancelado, então as consultas seguintes não leem mais o relógio.
+   */
+  class cancellation_token {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    cancellation_token() = default;  // sem prazo: só para com cancel()
+    explicit cancellation_token( clock::time_point deadline ) noexcept : deadline( deadline ) {}
+
+    cancellation_token( const cancellation_token & )            = delete;
+    cancellation_token &operator=( const cancellation_token & ) = delete;
+
+    void cancel() noexcept {
+      cancelled.store( true, std::memory_order_relaxed );
+    }
+
+    [[nodiscard]] bool stop_requested() const noexcept {
+      if ( cancelled.load( std::memory_order_relaxed ) ) {
+        return true;
+      }
+      if ( deadline != clock::time_point::max() && clock::now() >= deadline ) {
+        cancelled.store( true, std::memory_order_relaxed );
+        return true;
+      }
+      return false;
+    }
+
+    [[nodiscard]] clock::time_point get_deadline() const noexcept {
+      return deadline;
+    }
+
+  private:
+    mutable std::atomic<bool> cancelled{ false };
+    clock::time_point         deadline = clock::time_point::max();
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,70 @@
+#include "compressed_graph.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace r3dp::core {
+  namespace {
+
+    void write_varint( std::vector<std::uint8_t> &out, std::uint32_t value ) {
+      while ( value >= 0x80 ) {
+        out.push_back( static_cast<std::uint8_t>( value | 0x80 ) );
+        value >>= 7;
+      }
+      out.push_back( static_cast<std::uint8_t>( value ) );
+    }
+
+    // Diferença mod 2^32 vista como inteiro com sinal, com magnitude pequena em poucos bytes
+    std::uint32_t zigzag( std::uint32_t delta ) noexcept {
+      const auto sign = static_cast<std::uint32_t>( static_cast<std::int32_t>( delta ) >> 31 );
+      return ( delta << 1 ) ^ sign;
+    }
+
+    unsigned byte_length( std::uint32_t value ) noexcept {
+      return value < ( 1U << 8 ) ? 1 : value < ( 1U << 16 ) ? 2 : value < ( 1U << 24 ) ? 3 : 4;
+    }
+
+  }  // namespace
+
+  void compressed_graph::append_vertex( const std::vector<vertex_t> &sorted_neighbors ) {
+    const auto v = static_cast<vertex_t>( starts.size() );
+    if ( v % ANCHOR_STRIDE == 0 ) {
+      anchors.push_back( bytes.size() );
+    }
+    const std::uint64_t offset = bytes.size() - anchors.back();
+    if ( offset > std::numeric_limits<std::uint32_t>::max() ) {
+      throw std::length_error( "compressed_graph: bloco de 64 vértices maior que 4 GiB" );
+    }
+    starts.push_back( static_cast<std::uint32_t>( offset ) );
+
+    const auto count = static_cast<std::uint32_t>( sorted_neighbors.size() );
+    write_varint( bytes, count );
+    edges += count;
+
+    // Bytes de controle primeiro (um por grupo de 4), depois os valores
+    const std::size_t control_at = bytes.size();
+    bytes.resize( control_at + ( count + 3 ) / 4, 0 );
+
+    vertex_t previous = v;
+    for ( std::uint32_t i = 0; i < count; ++i ) {
+      const vertex_t u = sorted_neighbors[i];
+      const std::uint32_t gap = i == 0 ? zigzag( u - previous ) : u - previous;
+      previous                = u;
+
+      const unsigned length      = byte_length( gap );
+      bytes[control_at + i / 4] |= static_cast<std::uint8_t>( ( length - 1 ) << ( 2 * ( i % 4 ) ) );
+      for ( unsigned byte = 0; byte < length; ++byte ) {
+        bytes.push_back( static_cast<std::uint8_t>( gap >> ( 8 * byte ) ) );
+      }
+    }
+  }
+
+  void compressed_graph::finish() {
+    edges /= 2;
+    bytes.resize( bytes.size() + TAIL_PADDING, 0 );
+    bytes.shrink_to_fit();
+    anchors.shrink_to_fit();
+    starts.shrink_to_fit();
+  }
+
+}  // namespace r3dp::core
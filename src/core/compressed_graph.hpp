@@ -0,0 +1,266 @@
+#pragma once
+
+#include "graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#if defined( __SSSE3__ )
+  #include <immintrin.h>
+#endif
+
+namespace r3dp::core {
+
+  namespace stream_vbyte {
+
+    // Bytes ocupados pelos 4 valores descritos por um byte de controle (2 bits por valor)
+    inline constexpr std::array<std::uint8_t, 256> group_length = [] {
+      std::array<std::uint8_t, 256> table{};
+      for ( unsigned control = 0; control < 256; ++control ) {
+        unsigned bytes = 0;
+        for ( unsigned lane = 0; lane < 4; ++lane ) {
+          bytes += ( ( control >> ( 2 * lane ) ) & 3U ) + 1;
+        }
+        table[control] = static_cast<std::uint8_t>( bytes );
+      }
+      return table;
+    }();
+
+    // Máscara do pshufb que espalha os bytes de um grupo nas 4 palavras de 32 bits
+    inline constexpr std::array<std::array<std::uint8_t, 16>, 256> shuffle_mask = [] {
+      std::array<std::array<std::uint8_t, 16>, 256> table{};
+      for ( unsigned control = 0; control < 256; ++control ) {
+        unsigned source = 0;
+        for ( unsigned lane = 0; lane < 4; ++lane ) {
+          const unsigned length = ( ( control >> ( 2 * lane ) ) & 3U ) + 1;
+          for ( unsigned byte = 0; byte < 4; ++byte ) {
+            table[control][4 * lane + byte] =
+              byte < length ? static_cast<std::uint8_t>( source + byte ) : 0x80;
+          }
+          source += length;
+        }
+      }
+      return table;
+    }();
+
+    /**
+     * @brief Decodifica um grupo de 4 valores e devolve o início do grupo seguinte.
+     *
+     * Pode ler até 16 bytes a partir de `data`, por isso o buffer precisa de folga no final.
+     */
+    inline const std::uint8_t *decode_group( std::uint8_t        control,
+                                             const std::uint8_t *data,
+                                             std::uint32_t      *out ) noexcept {
+#if defined( __SSSE3__ )
+      const __m128i bytes = _mm_loadu_si128( reinterpret_cast<const __m128i *>( data ) );
+      const __m128i mask =
+        _mm_loadu_si128( reinterpret_cast<const __m128i *>( shuffle_mask[control].data() ) );
+      _mm_storeu_si128( reinterpret_cast<__m128i *>( out ), _mm_shuffle_epi8( bytes, mask ) );
+#else
+      const std::uint8_t *p = data;
+      for ( unsigned lane = 0; lane < 4; ++lane ) {
+        const unsigned length = ( ( control >> ( 2 * lane ) ) & 3U ) + 1;
+        std::uint32_t  value  = 0;
+        for ( unsigned byte = 0; byte < length; ++byte ) {
+          value |= static_cast<std::uint32_t>( p[byte] ) << ( 8 * byte );
+        }
+        out[lane]  = value;
+        p         += length;
+      }
+#endif
+      return data + group_length[control];
+    }
+
+  }  // namespace stream_vbyte
+
+  /**
+   * @brief Grafo simples não dirigido com listas de vizinhos comprimidas.
+   *
+   * Cada lista (ordenada) vira diferenças: a primeira relativa ao próprio vértice, em zigzag, e as
+   * demais em relação ao vizinho anterior. As diferenças são gravadas em StreamVByte: um byte de
+   * controle a cada 4 valores (1 a 4 bytes cada) seguido dos bytes dos valores, o que permite
+   * decodificar um grupo inteiro com um único pshufb quando há SSSE3. O bloco do vértice começa
+   * com o grau em varint; o início do bloco é uma âncora de 64 bits a cada 64 vértices mais um
+   * deslocamento de 32 bits por vértice.
+   *
+   * Com ids próximos entre vizinhos (grafos web/sociais renumerados por localidade) cada aresta
+   * ocupa pouco mais de 1 byte, contra 4 no csr_graph; o custo é decodificar as listas a cada
+   * varredura.
+   */
+  class compressed_graph {
+  public:
+    class neighbor_iterator {
+    public:
+      using value_type      = vertex_t;
+      using difference_type = std::ptrdiff_t;
+
+      neighbor_iterator() = default;
+
+      neighbor_iterator( const std::uint8_t *control,
+                         const std::uint8_t *data,
+                         std::uint32_t       count,
+                         vertex_t            v ) noexcept
+        : control( control ), data( data ), remaining( count ) {
+        if ( remaining != 0 ) {
+          this->data =
+            stream_vbyte::decode_group( *this->control++, this->data, values.data() );
+          // Primeira diferença em zigzag, relativa a v (aritmética mod 2^32)
+          const std::uint32_t zigzag = values[0];
+          values[0]                  = v + ( ( zigzag >> 1 ) ^ ( 0U - ( zigzag & 1U ) ) );
+          accumulate_gaps();
+        }
+      }
+
+      [[nodiscard]] vertex_t operator*() const noexcept {
+        return values[index];
+      }
+
+      neighbor_iterator &operator++() noexcept {
+        --remaining;
+        if ( ++index == 4 && remaining != 0 ) {
+          const vertex_t previous = values[3];
+          data = stream_vbyte::decode_group( *control++, data, values.data() );
+          values[0] += previous;
+          accumulate_gaps();
+        }
+        return *this;
+      }
+
+      neighbor_iterator operator++( int ) noexcept {
+        neighbor_iterator old = *this;
+        ++*this;
+        return old;
+      }
+
+      friend bool operator==( const neighbor_iterator &it, std::default_sentinel_t ) noexcept {
+        return it.remaining == 0;
+      }
+
+    private:
+      const std::uint8_t     *control   = nullptr;
+      const std::uint8_t     *data      = nullptr;
+      std::uint32_t           remaining = 0;
+      unsigned                index     = 0;
+      std::array<vertex_t, 4> values{};
+
+      void accumulate_gaps() noexcept {
+        values[1] += values[0];
+        values[2] += values[1];
+        values[3] += values[2];
+        index      = 0;
+      }
+    };
+
+    class neighbor_range {
+    public:
+      explicit neighbor_range( neighbor_iterator first, std::uint32_t count ) noexcept
+        : first( first ), count( count ) {}
+
+      [[nodiscard]] neighbor_iterator begin() const noexcept {
+        return first;
+      }
+      [[nodiscard]] std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+      }
+      [[nodiscard]] std::size_t size() const noexcept {
+        return count;
+      }
+
+    private:
+      neighbor_iterator first;
+      std::uint32_t     count;
+    };
+
+    compressed_graph() = default;
+
+    [[nodiscard]] std::size_t vertex_count() const noexcept {
+      return starts.size();
+    }
+
+    [[nodiscard]] std::uint64_t edge_count() const noexcept {
+      return edges;
+    }
+
+    [[nodiscard]] neighbor_range neighbors( vertex_t v ) const noexcept {
+      const std::uint8_t *block = block_of( v );
+      const std::uint32_t count = read_varint( block );
+      const std::uint8_t *data  = block + ( count + 3 ) / 4;
+      return neighbor_range( neighbor_iterator( block, data, count, v ), count );
+    }
+
+    [[nodiscard]] std::size_t degree( vertex_t v ) const noexcept {
+      const std::uint8_t *block = block_of( v );
+      return read_varint( block );
+    }
+
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return bytes.capacity() + anchors.capacity() * sizeof( std::uint64_t ) +
+             starts.capacity() * sizeof( std::uint32_t );
+    }
+
+  private:
+    static constexpr std::size_t ANCHOR_STRIDE = 64;
+    static constexpr std::size_t TAIL_PADDING  = 16;  // leitura de 16 bytes do pshufb
+
+    std::vector<std::uint8_t>  bytes;
+    std::vector<std::uint64_t> anchors;
+    std::vector<std::uint32_t> starts;
+    std::uint64_t              edges = 0;
+
+    [[nodiscard]] const std::uint8_t *block_of( vertex_t v ) const noexcept {
+      return bytes.data() + anchors[v / ANCHOR_STRIDE] + starts[v];
+    }
+
+    static std::uint32_t read_varint( const std::uint8_t *&p ) noexcept {
+      std::uint32_t value = 0;
+      for ( unsigned shift = 0;; shift += 7 ) {
+        const std::uint8_t byte  = *p++;
+        value                   |= static_cast<std::uint32_t>( byte & 0x7F ) << shift;
+        if ( ( byte & 0x80 ) == 0 ) {
+          return value;
+        }
+      }
+    }
+
+    // Acrescenta o próximo vértice; `sorted_neighbors` em ordem crescente e sem repetições
+    void append_vertex( const std::vector<vertex_t> &sorted_neighbors );
+    void finish();
+
+    template <adjacency_graph Graph>
+    friend compressed_graph compress( const Graph &g );
+  };
+
+  inline std::size_t vertex_count( const compressed_graph &g ) {
+    return g.vertex_count();
+  }
+
+  inline compressed_graph::neighbor_range neighbors( const compressed_graph &g, vertex_t v ) {
+    return g.neighbors( v );
+  }
+
+  /// @brief Comprime qualquer grafo com vertex_count/neighbors (graph_t, csr_graph).
+  template <adjacency_graph Graph>
+  compressed_graph compress( const Graph &g ) {
+    const std::size_t     n = vertex_count( g );
+    compressed_graph      out;
+    std::vector<vertex_t> scratch;
+    out.starts.reserve( n );
+    out.anchors.reserve( ( n + compressed_graph::ANCHOR_STRIDE - 1 ) /
+                         compressed_graph::ANCHOR_STRIDE );
+    for ( std::size_t v = 0; v < n; ++v ) {
+      scratch.clear();
+      for ( auto u : neighbors( g, static_cast<vertex_t>( v ) ) ) {
+        scratch.push_back( static_cast<vertex_t>( u ) );
+      }
+      std::sort( scratch.begin(), scratch.end() );
+      out.append_vertex( scratch );
+    }
+    out.finish();
+    return out;
+  }
+
+}  // namespace r3dp::core
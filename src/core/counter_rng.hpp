@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Gerador baseado em contador (hash SplitMix64 de `chave + i·γ`).
+   *
+   * O i-ésimo número de um fluxo depende apenas de (chave, fluxo, i), então cada indivíduo de uma
+   * geração pode ter seu próprio fluxo e ser gerado em qualquer thread e em qualquer ordem com o
+   * mesmo resultado. O estado cabe em dois inteiros, o que torna barato criar um fluxo por tarefa.
+   */
+  class counter_rng {
+  public:
+    constexpr counter_rng( std::uint64_t key, std::uint64_t stream ) noexcept
+      : state( mix( key ^ mix( stream + GAMMA ) ) ) {}
+
+    /// @brief Próximo inteiro de 64 bits do fluxo.
+    constexpr std::uint64_t next_u64() noexcept {
+      state += GAMMA;
+      return mix( state );
+    }
+
+    /// @brief Real uniforme em [0, 1) com 53 bits de precisão.
+    constexpr double uniform() noexcept {
+      return static_cast<double>( next_u64() >> 11 ) * 0x1.0p-53;
+    }
+
+    /// @brief Inteiro uniforme em [0, bound] (mesma convenção de MTRand::randInt(n)).
+    constexpr std::uint64_t below_or_equal( std::uint64_t bound ) noexcept {
+      if ( bound == UINT64_MAX ) {
+        return next_u64();
+      }
+      // Multiplicação de Lemire com rejeição: sem viés e sem divisão no caso comum
+      const std::uint64_t range = bound + 1;
+      __uint128_t         m     = static_cast<__uint128_t>( next_u64() ) * range;
+      auto                low   = static_cast<std::uint64_t>( m );
+      if ( low < range ) {
+        const std::uint64_t threshold = -range % range;
+        while ( low < threshold ) {
+          m   = static_cast<__uint128_t>( next_u64() ) * range;
+          low = static_cast<std::uint64_t>( m );
+        }
+      }
+      return static_cast<std::uint64_t>( m >> 64 );
+    }
+
+  private:
+    static constexpr std::uint64_t GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t state;
+
+    static constexpr std::uint64_t mix( std::uint64_t z ) noexcept {
+      z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+      z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+      return z ^ ( z >> 31 );
+    }
+  };
+
+}  // namespace r3dp::core
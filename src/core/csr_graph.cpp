@@ -0,0 +1,304 @@
+#include "csr_graph.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+  #include <unistd.h>
+#endif
+
+namespace r3dp::core {
+  namespace {
+    using raw_edge = std::pair<vertex_t, vertex_t>;  // ids originais, first < second
+
+    constexpr std::size_t MIN_RUN_BUFFER = 4096;  // arestas por bloco na intercalação
+
+    /*
+     * Conjunto de ids presentes com rank em O(1): bit por id possível e contagem acumulada a cada
+     * palavra de 64 bits.
+     */
+    class id_bitmap {
+    public:
+      void insert( vertex_t id ) {
+        const std::size_t word = id >> 6;
+        if ( word >= words.size() ) {
+          words.resize( std::max( word + 1, words.size() * 2 ), 0 );
+        }
+        words[word] |= std::uint64_t{ 1 } << ( id & 63 );
+      }
+
+      // Calcula os ranks; depois disso o conjunto não pode mais mudar
+      vertex_t freeze() {
+        ranks.resize( words.size() );
+        vertex_t total = 0;
+        for ( std::size_t w = 0; w < words.size(); ++w ) {
+          ranks[w] = total;
+          total += static_cast<vertex_t>( std::popcount( words[w] ) );
+        }
+        return total;
+      }
+
+      [[nodiscard]] vertex_t rank( vertex_t id ) const noexcept {
+        const std::uint64_t below = words[id >> 6] & ( ( std::uint64_t{ 1 } << ( id & 63 ) ) - 1 );
+        return ranks[id >> 6] + static_cast<vertex_t>( std::popcount( below ) );
+      }
+
+    private:
+      std::vector<std::uint64_t> words;
+      std::vector<vertex_t>      ranks;
+    };
+
+    struct spill_run {
+      std::filesystem::path path;
+      std::uint64_t         count = 0;
+    };
+
+    void sort_unique( std::vector<raw_edge> &block ) {
+      std::sort( block.begin(), block.end() );
+      block.erase( std::unique( block.begin(), block.end() ), block.end() );
+    }
+
+    spill_run write_run( std::vector<raw_edge> &block, const std::filesystem::path &directory,
+                         std::size_t index ) {
+      sort_unique( block );
+
+      spill_run run;
+      run.count = block.size();
+#ifdef __linux__
+      const auto pid = static_cast<long>( ::getpid() );
+#else
+      const long pid = 0;
+#endif
+      run.path = directory / ( "r3dp-edges-" + std::to_string( pid ) + "-" +
+                               std::to_string( index ) + ".bin" );
+
+      std::ofstream out( run.path, std::ios::binary | std::ios::trunc );
+      out.write( reinterpret_cast<const char *>( block.data() ),
+                 static_cast<std::streamsize>( block.size() * sizeof( raw_edge ) ) );
+      if ( !out ) {
+        throw std::runtime_error( "Falha ao gravar bloco de arestas em " + run.path.string() );
+      }
+      block.clear();
+      return run;
+    }
+
+    class run_reader {
+    public:
+      run_reader( const spill_run &run, std::size_t buffer_edges )
+        : in( run.path, std::ios::binary ), remaining( run.count ), buffer( buffer_edges ) {
+        if ( !in.is_open() ) {
+          throw std::runtime_error( "Erro ao reabrir bloco de arestas: " + run.path.string() );
+        }
+      }
+
+      bool next( raw_edge &edge ) {
+        if ( pos == len ) {
+          const std::size_t take = static_cast<std::size_t>(
+            std::min<std::uint64_t>( remaining, buffer.size() ) );
+          if ( take == 0 ) {
+            return false;
+          }
+          in.read( reinterpret_cast<char *>( buffer.data() ),
+                   static_cast<std::streamsize>( take * sizeof( raw_edge ) ) );
+          if ( !in ) {
+            throw std::runtime_error( "Bloco de arestas truncado" );
+          }
+          remaining -= take;
+          len = take;
+          pos = 0;
+        }
+        edge = buffer[pos++];
+        return true;
+      }
+
+    private:
+      std::ifstream         in;
+      std::uint64_t         remaining;
+      std::vector<raw_edge> buffer;
+      std::size_t           pos = 0;
+      std::size_t           len = 0;
+    };
+
+    // Intercala os blocos ordenados e entrega cada aresta distinta uma vez, em ordem crescente
+    template <class Visit>
+    void for_each_merged( const std::vector<spill_run> &runs, std::size_t buffer_edges,
+                          Visit &&visit ) {
+      std::vector<std::unique_ptr<run_reader>> readers;
+      readers.reserve( runs.size() );
+      for ( const auto &run : runs ) {
+        readers.push_back( std::make_unique<run_reader>( run, buffer_edges ) );
+      }
+
+      using head = std::pair<raw_edge, std::size_t>;
+      std::priority_queue<head, std::vector<head>, std::greater<>> heads;
+      for ( std::size_t r = 0; r < readers.size(); ++r ) {
+        raw_edge edge;
+        if ( readers[r]->next( edge ) ) {
+          heads.emplace( edge, r );
+        }
+      }
+
+      bool     first = true;
+      raw_edge last{};
+      while ( !heads.empty() ) {
+        auto [edge, r] = heads.top();
+        heads.pop();
+        if ( first || edge != last ) {
+          visit( edge );
+          last  = edge;
+          first = false;
+        }
+        raw_edge following;
+        if ( readers[r]->next( following ) ) {
+          heads.emplace( following, r );
+        }
+      }
+    }
+  }  // namespace
+
+  csr_graph::csr_graph( std::vector<std::uint64_t> offsets, std::vector<vertex_t> targets )
+    : offsets( std::move( offsets ) ), targets( std::move( targets ) ) {
+    if ( this->offsets.empty() || this->offsets.back() != this->targets.size() ) {
+      throw std::invalid_argument( "offsets/targets inconsistentes" );
+    }
+  }
+
+  csr_graph build_csr_from_file( const std::string             &file_path,
+                                 const streaming_build_options &options,
+                                 streaming_build_stats         *stats ) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const std::filesystem::path directory = options.spill_directory.empty()
+                                              ? std::filesystem::temp_directory_path()
+                                              : options.spill_directory;
+    const std::size_t block_edges =
+      std::max<std::size_t>( MIN_RUN_BUFFER, options.memory_budget_bytes / sizeof( raw_edge ) );
+
+    streaming_build_stats  local;
+    id_bitmap              ids;
+    std::vector<raw_edge>  block;
+    std::vector<spill_run> runs;
+    block.reserve( block_edges );  // páginas só são ocupadas à medida que o bloco enche
+
+    // Remove os blocos em disco mesmo se algo falhar no meio
+    struct run_cleanup {
+      std::vector<spill_run> &runs;
+      ~run_cleanup() {
+        for ( const auto &run : runs ) {
+          std::error_code ignored;
+          std::filesystem::remove( run.path, ignored );
+        }
+      }
+    } cleanup{ runs };
+
+    // 1. Leitura: registra os ids e acumula arestas normalizadas em blocos. A descompressão e a
+    // conversão do texto rodam nas threads do edge_stream enquanto esta thread monta os blocos.
+    {
+      edge_stream           input( file_path, options.input );
+      std::vector<raw_edge> batch;
+      while ( input.next_batch( batch ) ) {
+        local.edges_read += batch.size();
+        for ( auto edge : batch ) {
+          ids.insert( edge.first );
+          ids.insert( edge.second );
+          if ( edge.first == edge.second ) {
+            continue;
+          }
+          if ( edge.second < edge.first ) {
+            std::swap( edge.first, edge.second );
+          }
+          block.push_back( edge );
+          if ( block.size() >= block_edges ) {
+            runs.push_back( write_run( block, directory, runs.size() ) );
+            local.spilled_bytes += runs.back().count * sizeof( raw_edge );
+          }
+        }
+      }
+    }
+
+    // Se nada foi para o disco o bloco atual já é a lista completa; senão ele vira o último bloco
+    std::size_t merge_buffer = 0;
+    if ( runs.empty() ) {
+      sort_unique( block );
+    } else {
+      if ( !block.empty() ) {
+        runs.push_back( write_run( block, directory, runs.size() ) );
+        local.spilled_bytes += runs.back().count * sizeof( raw_edge );
+      }
+      block.clear();
+      block.shrink_to_fit();
+      merge_buffer = std::max( MIN_RUN_BUFFER, block_edges / runs.size() );
+    }
+    local.spilled_runs = runs.size();
+
+    auto for_each_edge = [&]( auto &&visit ) {
+      if ( runs.empty() ) {
+        for ( const auto &edge : block ) {
+          visit( edge );
+        }
+      } else {
+        for_each_merged( runs, merge_buffer, visit );
+      }
+    };
+
+    // 2. Contagem de graus (offsets[v + 1] = grau de v), depois soma de prefixos
+    const vertex_t             n = ids.freeze();
+    std::vector<std::uint64_t> offsets( static_cast<std::size_t>( n ) + 1, 0 );
+    for_each_edge( [&]( const raw_edge &edge ) {
+      ++offsets[ids.rank( edge.first ) + 1];
+      ++offsets[ids.rank( edge.second ) + 1];
+      ++local.unique_edges;
+    } );
+    for ( std::size_t v = 1; v < offsets.size(); ++v ) {
+      offsets[v] += offsets[v - 1];
+    }
+
+    // 3. Preenchimento: offsets[v] serve de cursor e termina no início de v + 1. Como as arestas
+    // chegam ordenadas e a renumeração preserva a ordem, cada lista já sai crescente.
+    std::vector<vertex_t> targets( offsets.back() );
+    for_each_edge( [&]( const raw_edge &edge ) {
+      const vertex_t u      = ids.rank( edge.first );
+      const vertex_t v      = ids.rank( edge.second );
+      targets[offsets[u]++] = v;
+      targets[offsets[v]++] = u;
+    } );
+    for ( std::size_t v = offsets.size() - 1; v > 0; --v ) {
+      offsets[v] = offsets[v - 1];
+    }
+    offsets[0] = 0;
+
+    local.seconds =
+      std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    if ( stats != nullptr ) {
+      *stats = local;
+    }
+    return csr_graph( std::move( offsets ), std::move( targets ) );
+  }
+
+  csr_graph csr_from( const graph_t &g ) {
+    const std::size_t          n = boost::num_vertices( g );
+    std::vector<std::uint64_t> offsets( n + 1, 0 );
+    for ( std::size_t v = 0; v < n; ++v ) {
+      offsets[v + 1] = offsets[v] + boost::degree( v, g );
+    }
+
+    std::vector<vertex_t> targets( offsets.back() );
+    for ( std::size_t v = 0; v < n; ++v ) {
+      std::size_t at = offsets[v];
+      for ( auto u : neighbors( g, static_cast<vertex_t>( v ) ) ) {
+        targets[at++] = static_cast<vertex_t>( u );
+      }
+      std::sort( targets.begin() + static_cast<std::ptrdiff_t>( offsets[v] ),
+                 targets.begin() + static_cast<std::ptrdiff_t>( at ) );
+    }
+    return csr_graph( std::move( offsets ), std::move( targets ) );
+  }
+
+}  // namespace r3dp::core
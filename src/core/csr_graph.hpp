@@ -0,0 +1,97 @@
+#pragma once
+
+#include "edge_stream.hpp"
+#include "graph.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Grafo simples não dirigido em formato CSR (compressed sparse row).
+   *
+   * Os vizinhos de v ocupam targets[offsets[v], offsets[v + 1]), em ordem crescente, e cada aresta
+   * aparece nas duas listas. Ocupa 8·(n + 1) + 8·m bytes, contra dezenas de bytes por aresta do
+   * adjacency_list com setS.
+   */
+  class csr_graph {
+  public:
+    csr_graph() = default;
+    csr_graph( std::vector<std::uint64_t> offsets, std::vector<vertex_t> targets );
+
+    [[nodiscard]] std::size_t vertex_count() const noexcept {
+      return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    [[nodiscard]] std::uint64_t edge_count() const noexcept {
+      return targets.size() / 2;
+    }
+
+    [[nodiscard]] std::span<const vertex_t> neighbors( vertex_t v ) const noexcept {
+      return { targets.data() + offsets[v], targets.data() + offsets[v + 1] };
+    }
+
+    [[nodiscard]] std::size_t degree( vertex_t v ) const noexcept {
+      return static_cast<std::size_t>( offsets[v + 1] - offsets[v] );
+    }
+
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+      return offsets.size() * sizeof( std::uint64_t ) + targets.size() * sizeof( vertex_t );
+    }
+
+  private:
+    std::vector<std::uint64_t> offsets;
+    std::vector<vertex_t>      targets;
+  };
+
+  inline std::size_t vertex_count( const csr_graph &g ) {
+    return g.vertex_count();
+  }
+
+  inline std::span<const vertex_t> neighbors( const csr_graph &g, vertex_t v ) {
+    return g.neighbors( v );
+  }
+
+  struct streaming_build_options {
+    std::size_t           memory_budget_bytes = std::size_t{ 1 } << 30;  // blocos de arestas
+    std::filesystem::path spill_directory;  // vazio: std::filesystem::temp_directory_path()
+    edge_stream_options   input;            // leitura/descompressão em paralelo
+  };
+
+  struct streaming_build_stats {
+    std::uint64_t edges_read    = 0;  // linhas de aresta lidas (com laços e repetidas)
+    std::uint64_t unique_edges  = 0;
+    std::uint64_t spilled_runs  = 0;  // blocos ordenados gravados em disco (0: coube na memória)
+    std::uint64_t spilled_bytes = 0;
+    double        seconds       = 0.0;
+  };
+
+  /**
+   * @brief Lê uma lista de arestas "u v" e monta o CSR com memória de trabalho limitada.
+   *
+   * O arquivo pode ser texto puro, .gz ou .zst (ver edge_stream); a leitura e a descompressão
+   * rodam em threads próprias, em paralelo com a montagem dos blocos.
+   *
+   * Os ids são renumerados como em read_graph_from_file (posição entre os ids distintos, em ordem
+   * crescente), laços são descartados e arestas repetidas viram uma só. As arestas lidas vão para
+   * blocos de até `memory_budget_bytes`; cada bloco cheio é ordenado, sem repetições, e gravado em
+   * `spill_directory`. Depois, duas intercalações dos blocos contam os graus e preenchem o CSR.
+   * Além do próprio CSR, a memória usada é o bloco, um bitmap de ids (1,5 bit por id possível) e
+   * os buffers de leitura da intercalação. Linhas iniciadas por '#' ou '%' são comentários.
+   *
+   * Lança std::runtime_error se o arquivo não abrir, se a descompressão falhar ou se a gravação dos
+   * blocos falhar.
+   */
+  csr_graph build_csr_from_file( const std::string             &file_path,
+                                 const streaming_build_options &options = {},
+                                 streaming_build_stats         *stats   = nullptr );
+
+  // Converte um graph_t (útil para comparar as duas representações)
+  csr_graph csr_from( const graph_t &g );
+
+}  // namespace r3dp::core
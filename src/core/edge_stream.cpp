@@ -0,0 +1,365 @@
+#include "edge_stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#ifdef R3DP_HAVE_ZLIB
+  #include <zlib.h>
+#endif
+#ifdef R3DP_HAVE_ZSTD
+  #include <zstd.h>
+#endif
+
+namespace r3dp::core {
+  namespace {
+    using raw_edge = edge_stream::raw_edge;
+
+    // Origem dos bytes de texto já descomprimidos; read devolve 0 no fim do arquivo
+    class byte_source {
+    public:
+      virtual ~byte_source()                                  = default;
+      virtual std::size_t read( char *out, std::size_t size ) = 0;
+    };
+
+    class plain_source final : public byte_source {
+    public:
+      explicit plain_source( const std::string &file_path ) : in( file_path, std::ios::binary ) {
+        if ( !in.is_open() ) {
+          throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+        }
+      }
+
+      std::size_t read( char *out, std::size_t size ) override {
+        in.read( out, static_cast<std::streamsize>( size ) );
+        if ( in.bad() ) {
+          throw std::runtime_error( "Erro de leitura" );
+        }
+        return static_cast<std::size_t>( in.gcount() );
+      }
+
+    private:
+      std::ifstream in;
+    };
+
+#ifdef R3DP_HAVE_ZLIB
+    class gzip_source final : public byte_source {
+    public:
+      explicit gzip_source( const std::string &file_path )
+        : file( gzopen( file_path.c_str(), "rb" ) ) {
+        if ( file == nullptr ) {
+          throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+        }
+        gzbuffer( file, 1U << 17 );
+      }
+
+      ~gzip_source() override {
+        gzclose( file );
+      }
+
+      std::size_t read( char *out, std::size_t size ) override {
+        const auto request = static_cast<unsigned>( std::min<std::size_t>( size, 1U << 30 ) );
+        const int  got     = gzread( file, out, request );
+        if ( got < 0 ) {
+          int code = 0;
+          throw std::runtime_error( std::string( "gzip: " ) + gzerror( file, &code ) );
+        }
+        return static_cast<std::size_t>( got );
+      }
+
+    private:
+      gzFile file;
+    };
+#endif
+
+#ifdef R3DP_HAVE_ZSTD
+    class zstd_source final : public byte_source {
+    public:
+      explicit zstd_source( const std::string &file_path )
+        : file( std::fopen( file_path.c_str(), "rb" ) ),
+          context( ZSTD_createDCtx() ),
+          buffer( ZSTD_DStreamInSize() ) {
+        if ( file == nullptr ) {
+          throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+        }
+      }
+
+      ~zstd_source() override {
+        ZSTD_freeDCtx( context );
+        if ( file != nullptr ) {
+          std::fclose( file );
+        }
+      }
+
+      std::size_t read( char *out, std::size_t size ) override {
+        ZSTD_outBuffer output{ out, size, 0 };
+        while ( output.pos < output.size ) {
+          if ( input.pos == input.size ) {
+            input.size = std::fread( buffer.data(), 1, buffer.size(), file );
+            input.pos  = 0;
+            input.src  = buffer.data();
+            if ( input.size == 0 ) {
+              if ( std::ferror( file ) ) {
+                throw std::runtime_error( "Erro de leitura" );
+              }
+              if ( frame_pending ) {
+                throw std::runtime_error( "zstd: arquivo truncado" );
+              }
+              break;
+            }
+          }
+          const std::size_t status = ZSTD_decompressStream( context, &output, &input );
+          if ( ZSTD_isError( status ) ) {
+            throw std::runtime_error( std::string( "zstd: " ) + ZSTD_getErrorName( status ) );
+          }
+          frame_pending = status != 0;
+        }
+        return output.pos;
+      }
+
+    private:
+      std::FILE        *file;
+      ZSTD_DCtx        *context;
+      std::vector<char> buffer;
+      ZSTD_inBuffer     input{ nullptr, 0, 0 };
+      bool              frame_pending = false;
+    };
+#endif
+
+    std::unique_ptr<byte_source> open_source( const std::string &file_path,
+                                              input_compression  format ) {
+      switch ( format ) {
+        case input_compression::gzip:
+#ifdef R3DP_HAVE_ZLIB
+          return std::make_unique<gzip_source>( file_path );
+#else
+          throw std::runtime_error( file_path + ": gzip sem suporte (compilado sem zlib)" );
+#endif
+        case input_compression::zstd:
+#ifdef R3DP_HAVE_ZSTD
+          return std::make_unique<zstd_source>( file_path );
+#else
+          throw std::runtime_error( file_path + ": zstd sem suporte (compilado sem libzstd)" );
+#endif
+        case input_compression::none:
+          break;
+      }
+      return std::make_unique<plain_source>( file_path );
+    }
+
+    // Converte um bloco de linhas inteiras (o primeiro byte está em `offset` no texto) em pares
+    // de ids; std::runtime_error com a posição do erro se uma linha não for "u v"
+    void parse_chunk( const std::vector<char> &chunk,
+                      std::uint64_t            offset,
+                      const std::string       &file_path,
+                      std::vector<raw_edge>   &out ) {
+      constexpr std::uint64_t MAX_ID = std::numeric_limits<vertex_t>::max();
+
+      const char *first = chunk.data();
+      const char *p     = first;
+      const char *last  = first + chunk.size();
+
+      auto fail = [&]( const char *at, const std::string &what ) {
+        throw std::runtime_error( file_path + ": byte " +
+                                  std::to_string( offset + std::uint64_t( at - first ) ) + ": " +
+                                  what );
+      };
+      auto is_blank = []( char c ) { return c == ' ' || c == '\t' || c == '\r' || c == ','; };
+
+      std::array<vertex_t, 2> ids{};
+      while ( p != last ) {
+        // Uma linha: ids separados por brancos, até o '\n' ou um comentário
+        const char *line   = p;
+        std::size_t tokens = 0;
+        while ( p != last && *p != '\n' ) {
+          if ( is_blank( *p ) ) {
+            ++p;
+          } else if ( *p == '#' || *p == '%' ) {
+            p = std::find( p, last, '\n' );
+          } else if ( *p >= '0' && *p <= '9' ) {
+            const char   *start  = p;
+            std::uint64_t number = 0;
+            while ( p != last && *p >= '0' && *p <= '9' ) {
+              number = number * 10 + static_cast<std::uint64_t>( *p - '0' );
+              if ( number > MAX_ID ) {
+                fail( start, "id de vértice maior que " + std::to_string( MAX_ID ) );
+              }
+              ++p;
+            }
+            if ( p != last && *p != '\n' && !is_blank( *p ) && *p != '#' && *p != '%' ) {
+              fail( p, std::string( "caractere inesperado '" ) + *p + "'" );
+            }
+            if ( tokens == ids.size() ) {
+              fail( start, "mais de dois ids na linha" );
+            }
+            ids[tokens++] = static_cast<vertex_t>( number );
+          } else {
+            fail( p, std::string( "caractere inesperado '" ) + *p + "'" );
+          }
+        }
+        if ( tokens == ids.size() ) {
+          out.emplace_back( ids[0], ids[1] );
+        } else if ( tokens != 0 ) {
+          fail( line, "id sem par na linha" );
+        }
+        if ( p != last ) {
+          ++p;  // '\n'
+        }
+      }
+    }
+  }  // namespace
+
+  input_compression detect_compression( const std::string &file_path ) {
+    std::ifstream in( file_path, std::ios::binary );
+    if ( !in.is_open() ) {
+      throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+    }
+    std::array<unsigned char, 4> magic{};
+    in.read( reinterpret_cast<char *>( magic.data() ), magic.size() );
+    const auto got = in.gcount();
+    if ( got >= 2 && magic[0] == 0x1F && magic[1] == 0x8B ) {
+      return input_compression::gzip;
+    }
+    if ( got == 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F &&
+         magic[3] == 0xFD ) {
+      return input_compression::zstd;
+    }
+    return input_compression::none;
+  }
+
+  bool compression_supported( input_compression format ) {
+    switch ( format ) {
+      case input_compression::gzip:
+#ifdef R3DP_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+      case input_compression::zstd:
+#ifdef R3DP_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+      case input_compression::none:
+        break;
+    }
+    return true;
+  }
+
+  edge_stream::edge_stream( const std::string &file_path, const edge_stream_options &options )
+    : format( detect_compression( file_path ) ),
+      chunks( options.queue_depth ),
+      batches( options.queue_depth ) {
+    // Aberto aqui para que falhas de abertura cheguem a quem construiu o stream
+    std::shared_ptr<byte_source> source = open_source( file_path, format );
+
+    const std::size_t chunk_bytes = std::max<std::size_t>( options.chunk_bytes, 4096 );
+    const unsigned    parsers     = std::max( 1U, options.parser_threads );
+    running_parsers.store( parsers );
+
+    // Leitura/descompressão: blocos cortados no último '\n', o resto segue para o próximo bloco
+    threads.emplace_back( [this, source, chunk_bytes] {
+      try {
+        std::vector<char> carry;
+        std::uint64_t     offset = 0;  // posição no texto do primeiro byte do próximo bloco
+        while ( true ) {
+          std::vector<char> chunk = std::move( carry );
+          carry.clear();
+          const std::size_t kept = chunk.size();
+          chunk.resize( kept + chunk_bytes );
+          const std::size_t got = source->read( chunk.data() + kept, chunk_bytes );
+          chunk.resize( kept + got );
+          if ( got == 0 ) {
+            if ( !chunk.empty() ) {
+              chunks.push( text_chunk{ offset, std::move( chunk ) } );
+            }
+            break;
+          }
+
+          const auto line_end = std::find( chunk.rbegin(), chunk.rend(), '\n' );
+          if ( line_end == chunk.rend() ) {
+            carry = std::move( chunk );  // linha maior que o bloco: continua acumulando
+            continue;
+          }
+          const auto cut = chunk.size() - static_cast<std::size_t>( line_end - chunk.rbegin() );
+          carry.assign( chunk.begin() + static_cast<std::ptrdiff_t>( cut ), chunk.end() );
+          chunk.resize( cut );
+          if ( !chunks.push( text_chunk{ offset, std::move( chunk ) } ) ) {
+            return;  // encerrado pelo consumidor
+          }
+          offset += cut;
+        }
+      } catch ( ... ) {
+        fail( std::current_exception() );
+      }
+      chunks.close();
+    } );
+
+    for ( unsigned t = 0; t < parsers; ++t ) {
+      threads.emplace_back( [this, file_path] {
+        try {
+          while ( auto chunk = chunks.pop() ) {
+            std::vector<raw_edge> batch;
+            batch.reserve( chunk->bytes.size() / 8 );
+            parse_chunk( chunk->bytes, chunk->offset, file_path, batch );
+            if ( !batch.empty() && !batches.push( std::move( batch ) ) ) {
+              break;
+            }
+          }
+        } catch ( ... ) {
+          fail( std::current_exception() );
+        }
+        if ( running_parsers.fetch_sub( 1 ) == 1 ) {
+          batches.close();
+        }
+      } );
+    }
+  }
+
+  edge_stream::~edge_stream() {
+    shutdown();
+  }
+
+  bool edge_stream::next_batch( std::vector<raw_edge> &batch ) {
+    if ( auto next = batches.pop() ) {
+      batch = std::move( *next );
+      return true;
+    }
+    shutdown();
+    std::lock_guard lock( error_mutex );
+    if ( error ) {
+      std::rethrow_exception( std::exchange( error, nullptr ) );
+    }
+    batch.clear();
+    return false;
+  }
+
+  void edge_stream::fail( std::exception_ptr e ) {
+    {
+      std::lock_guard lock( error_mutex );
+      if ( !error ) {
+        error = std::move( e );
+      }
+    }
+    chunks.close();
+    batches.close();
+  }
+
+  void edge_stream::shutdown() {
+    chunks.close();
+    batches.close();
+    for ( auto &thread : threads ) {
+      if ( thread.joinable() ) {
+        thread.join();
+      }
+    }
+  }
+
+}  // namespace r3dp::core
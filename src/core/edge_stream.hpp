@@ -0,0 +1,84 @@
+#pragma once
+
+#include "bounded_queue.hpp"
+#include "graph.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace r3dp::core {
+
+  enum class input_compression { none, gzip, zstd };
+
+  // Pelos bytes mágicos do início do arquivo (não pela extensão)
+  input_compression detect_compression( const std::string &file_path );
+
+  // true se o binário foi compilado com suporte ao formato (zlib / zstd opcionais)
+  bool compression_supported( input_compression format );
+
+  struct edge_stream_options {
+    unsigned    parser_threads = 2;
+    std::size_t chunk_bytes    = std::size_t{ 1 } << 20;  // bytes de texto por bloco
+    std::size_t queue_depth    = 8;                       // blocos em trânsito em cada fila
+  };
+
+  /**
+   * @brief Lê uma lista de arestas "u v" (texto puro, .gz ou .zst) em paralelo com quem a consome.
+   *
+   * Uma thread lê e descomprime o arquivo e o corta em blocos terminados em '\n'; `parser_threads`
+   * threads convertem os blocos em arestas; o consumidor recebe lotes com `next_batch`. As filas
+   * entre as etapas são limitadas, então a memória em trânsito é de cerca de
+   * 2·queue_depth·chunk_bytes, e E/S, descompressão e conversão se sobrepõem.
+   *
+   * Os lotes chegam fora da ordem do arquivo (cada parser entrega o seu); os ids são os originais,
+   * com laços e repetições. Cada linha tem exatamente dois ids decimais (0..2^32-1) separados por
+   * espaços, tabs ou vírgula; linhas vazias e o que vem depois de '#' ou '%' são ignorados.
+   *
+   * O construtor lança std::runtime_error se o arquivo não abrir ou se o formato não tiver suporte
+   * compilado; erros de leitura, descompressão ou formato (com a posição em bytes no texto, já
+   * descomprimido) nas threads são relançados por `next_batch`.
+   */
+  class edge_stream {
+  public:
+    using raw_edge = std::pair<vertex_t, vertex_t>;
+
+    explicit edge_stream( const std::string &file_path, const edge_stream_options &options = {} );
+    ~edge_stream();
+
+    edge_stream( const edge_stream & )            = delete;
+    edge_stream &operator=( const edge_stream & ) = delete;
+
+    // Substitui `batch` pelo próximo lote; false quando o arquivo acabou
+    bool next_batch( std::vector<raw_edge> &batch );
+
+    [[nodiscard]] input_compression compression() const noexcept {
+      return format;
+    }
+
+  private:
+    // Bloco de linhas inteiras e sua posição no texto
+    struct text_chunk {
+      std::uint64_t     offset = 0;
+      std::vector<char> bytes;
+    };
+
+    input_compression                    format;
+    bounded_queue<text_chunk>            chunks;
+    bounded_queue<std::vector<raw_edge>> batches;
+    std::atomic<unsigned>                running_parsers{ 0 };
+    std::mutex                           error_mutex;
+    std::exception_ptr                   error;
+    std::vector<std::thread>             threads;
+
+    void fail( std::exception_ptr e );
+    void shutdown();
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,226 @@
+#include "edge_writer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef R3DP_HAVE_ZLIB
+  #include <zlib.h>
+#endif
+#ifdef R3DP_HAVE_ZSTD
+  #include <zstd.h>
+#endif
+
+namespace r3dp::core {
+
+  // Destino dos bytes de texto, que comprime (ou não) antes de gravar
+  class edge_writer::byte_sink {
+  public:
+    virtual ~byte_sink()                                     = default;
+    virtual void write( const char *data, std::size_t size ) = 0;
+    virtual void close()                                     = 0;
+  };
+
+  namespace {
+    class plain_sink final : public edge_writer::byte_sink {
+    public:
+      explicit plain_sink( const std::string &file_path ) : out( file_path, std::ios::binary ) {
+        if ( !out.is_open() ) {
+          throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+        }
+      }
+
+      void write( const char *data, std::size_t size ) override {
+        out.write( data, static_cast<std::streamsize>( size ) );
+        if ( !out ) {
+          throw std::runtime_error( "Erro de escrita" );
+        }
+      }
+
+      void close() override {
+        out.close();
+        if ( !out ) {
+          throw std::runtime_error( "Erro de escrita" );
+        }
+      }
+
+    private:
+      std::ofstream out;
+    };
+
+#ifdef R3DP_HAVE_ZLIB
+    class gzip_sink final : public edge_writer::byte_sink {
+    public:
+      gzip_sink( const std::string &file_path, int level ) {
+        const std::string mode = level > 0 ? "wb" + std::to_string( std::min( level, 9 ) ) : "wb";
+        file                   = gzopen( file_path.c_str(), mode.c_str() );
+        if ( file == nullptr ) {
+          throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+        }
+        gzbuffer( file, 1U << 17 );
+      }
+
+      ~gzip_sink() override {
+        if ( file != nullptr ) {
+          gzclose( file );
+        }
+      }
+
+      void write( const char *data, std::size_t size ) override {
+        while ( size > 0 ) {
+          const auto request = static_cast<unsigned>( std::min<std::size_t>( size, 1U << 30 ) );
+          if ( gzwrite( file, data, request ) != int( request ) ) {
+            int code = 0;
+            throw std::runtime_error( std::string( "gzip: " ) + gzerror( file, &code ) );
+          }
+          data += request;
+          size -= request;
+        }
+      }
+
+      void close() override {
+        const int status = gzclose( file );
+        file             = nullptr;
+        if ( status != Z_OK ) {
+          throw std::runtime_error( "gzip: erro ao fechar o arquivo" );
+        }
+      }
+
+    private:
+      gzFile file = nullptr;
+    };
+#endif
+
+#ifdef R3DP_HAVE_ZSTD
+    class zstd_sink final : public edge_writer::byte_sink {
+    public:
+      zstd_sink( const std::string &file_path, int level )
+        : file( std::fopen( file_path.c_str(), "wb" ) ),
+          context( ZSTD_createCCtx() ),
+          buffer( ZSTD_CStreamOutSize() ) {
+        if ( file == nullptr ) {
+          ZSTD_freeCCtx( context );
+          throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+        }
+        if ( level > 0 ) {
+          ZSTD_CCtx_setParameter( context, ZSTD_c_compressionLevel, level );
+        }
+      }
+
+      ~zstd_sink() override {
+        ZSTD_freeCCtx( context );
+        if ( file != nullptr ) {
+          std::fclose( file );
+        }
+      }
+
+      void write( const char *data, std::size_t size ) override {
+        ZSTD_inBuffer input{ data, size, 0 };
+        while ( input.pos < input.size ) {
+          compress( input, ZSTD_e_continue );
+        }
+      }
+
+      void close() override {
+        ZSTD_inBuffer input{ nullptr, 0, 0 };
+        while ( compress( input, ZSTD_e_end ) != 0 ) {
+        }
+        const int status = std::fclose( file );
+        file             = nullptr;
+        if ( status != 0 ) {
+          throw std::runtime_error( "Erro de escrita" );
+        }
+      }
+
+    private:
+      std::FILE        *file;
+      ZSTD_CCtx        *context;
+      std::vector<char> buffer;
+
+      // Comprime o que couber em `buffer` e grava; retorna o que ainda falta descarregar
+      std::size_t compress( ZSTD_inBuffer &input, ZSTD_EndDirective mode ) {
+        ZSTD_outBuffer    output{ buffer.data(), buffer.size(), 0 };
+        const std::size_t remaining = ZSTD_compressStream2( context, &output, &input, mode );
+        if ( ZSTD_isError( remaining ) ) {
+          throw std::runtime_error( std::string( "zstd: " ) + ZSTD_getErrorName( remaining ) );
+        }
+        if ( std::fwrite( buffer.data(), 1, output.pos, file ) != output.pos ) {
+          throw std::runtime_error( "Erro de escrita" );
+        }
+        return remaining;
+      }
+    };
+#endif
+
+    std::unique_ptr<edge_writer::byte_sink> open_sink( const std::string  &file_path,
+                                                       input_compression   format,
+                                                       [[maybe_unused]] int level ) {
+      switch ( format ) {
+        case input_compression::gzip:
+#ifdef R3DP_HAVE_ZLIB
+          return std::make_unique<gzip_sink>( file_path, level );
+#else
+          throw std::runtime_error( file_path + ": gzip sem suporte (compilado sem zlib)" );
+#endif
+        case input_compression::zstd:
+#ifdef R3DP_HAVE_ZSTD
+          return std::make_unique<zstd_sink>( file_path, level );
+#else
+          throw std::runtime_error( file_path + ": zstd sem suporte (compilado sem libzstd)" );
+#endif
+        case input_compression::none:
+          break;
+      }
+      return std::make_unique<plain_sink>( file_path );
+    }
+  }  // namespace
+
+  input_compression compression_for_path( const std::string &file_path ) {
+    const auto ends_with = [&]( std::string_view suffix ) {
+      return file_path.size() >= suffix.size() &&
+             file_path.compare( file_path.size() - suffix.size(), suffix.size(), suffix ) == 0;
+    };
+    if ( ends_with( ".gz" ) ) {
+      return input_compression::gzip;
+    }
+    if ( ends_with( ".zst" ) ) {
+      return input_compression::zstd;
+    }
+    return input_compression::none;
+  }
+
+  void append_edge( std::string &out, vertex_t u, vertex_t v ) {
+    constexpr std::size_t DIGITS = 10;  // de um vertex_t de 32 bits
+
+    char  line[2 * DIGITS + 2];
+    char *end = std::to_chars( line, line + DIGITS, u ).ptr;
+    *end++    = ' ';
+    end       = std::to_chars( end, end + DIGITS, v ).ptr;
+    *end++    = '\n';
+    out.append( line, end );
+  }
+
+  edge_writer::edge_writer( const std::string &file_path, input_compression format, int level )
+    : sink( open_sink( file_path, format, level ) ) {}
+
+  edge_writer::~edge_writer() = default;
+
+  void edge_writer::write( std::string_view text ) {
+    if ( !sink ) {
+      throw std::logic_error( "edge_writer: escrita depois de close" );
+    }
+    sink->write( text.data(), text.size() );
+    written += text.size();
+  }
+
+  void edge_writer::close() {
+    if ( sink ) {
+      auto closing = std::move( sink );
+      closing->close();
+    }
+  }
+
+}  // namespace r3dp::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "edge_stream.hpp"
+#include "graph.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace r3dp::core {
+
+  // Pela extensão do nome (.gz ou .zst); quem lê depois reconhece o formato pelos bytes mágicos
+  input_compression compression_for_path( const std::string &file_path );
+
+  // Acrescenta a linha "u v\n" a `out`
+  void append_edge( std::string &out, vertex_t u, vertex_t v );
+
+  /**
+   * @brief Grava uma lista de arestas em texto puro, .gz ou .zst: os formatos que edge_stream lê.
+   *
+   * Recebe texto já formatado (ex.: blocos montados com append_edge em outras threads) e só
+   * comprime e grava, na ordem das chamadas. O construtor lança std::runtime_error se o arquivo
+   * não abrir ou se o formato não tiver suporte compilado; `write` e `close` lançam em erros de
+   * escrita. O destrutor fecha o arquivo sem relatar erros: quem precisa saber chama `close`.
+   */
+  class edge_writer {
+  public:
+    // level: nível de compressão (0 = padrão da biblioteca; ignorado em texto puro)
+    edge_writer( const std::string &file_path, input_compression format, int level = 0 );
+    ~edge_writer();
+
+    edge_writer( const edge_writer & )            = delete;
+    edge_writer &operator=( const edge_writer & ) = delete;
+
+    void write( std::string_view text );
+    void close();
+
+    // Bytes de texto recebidos (antes da compressão)
+    [[nodiscard]] std::uint64_t text_bytes() const noexcept {
+      return written;
+    }
+
+    class byte_sink;
+
+  private:
+    std::unique_ptr<byte_sink> sink;
+    std::uint64_t              written = 0;
+  };
+
+}  // namespace r3dp::core
@@ -1,25 +1,29 @@
 #include "graph.hpp"
 
-#include <fstream>
+#include "edge_stream.hpp"
+
 #include <iostream>
 
 namespace r3dp::core {
-  std::pair<vertex_t, std::set<edge_t>> read_graph_from_file( const std::string &file_path ) {
-    std::ifstream file( file_path );
-    if ( !file.is_open() ) {
-      std::cerr << "Erro ao abrir o arquivo: " << file_path << std::endl;
-      return { 0, {} };
-    }
-
+  std::pair<vertex_t, std::set<edge_t>> read_graph_from_file( const std::string         &file_path,
+                                                              const edge_stream_options &options ) {
     std::set<vertex_t>  uniqueVertices;
     std::vector<edge_t> originaledge_ts;
-    vertex_t            u = 0, v = 0;
 
-    // Lê todas as arestas e todos os vértices
-    while ( file >> u >> v ) {
-      uniqueVertices.insert( u );
-      uniqueVertices.insert( v );
-      originaledge_ts.emplace_back( u, v );
+    // Lê todas as arestas e todos os vértices (texto puro, .gz ou .zst)
+    try {
+      edge_stream         input( file_path, options );
+      std::vector<edge_t> batch;
+      while ( input.next_batch( batch ) ) {
+        for ( const auto &[u, v] : batch ) {
+          uniqueVertices.insert( u );
+          uniqueVertices.insert( v );
+        }
+        originaledge_ts.insert( originaledge_ts.end(), batch.begin(), batch.end() );
+      }
+    } catch ( const std::runtime_error &e ) {
+      std::cerr << e.what() << std::endl;
+      return { 0, {} };
     }
 
     std::unordered_map<vertex_t, vertex_t> remapping;
@@ -45,6 +49,10 @@ namespace r3dp::core {
     return { counter, uniqueRemappededge_ts };
   }
 
+  std::pair<vertex_t, std::set<edge_t>> read_graph_from_file( const std::string &file_path ) {
+    return read_graph_from_file( file_path, edge_stream_options{} );
+  }
+
   graph_t build_graph_from( vertex_t n, const std::set<edge_t> &edges ) {
     graph_t g( static_cast<std::size_t>( n ) );  // Aqui está sendo criado um grafo de 0..n-1
     for ( auto [u, v] : edges ) {
@@ -1,6 +1,12 @@
+#pragma once
+
+#include <algorithm>
 #include <boost/graph/adjacency_list.hpp>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 namespace r3dp::core {
   using vertex_t = uint32_t;
@@ -10,7 +16,48 @@ namespace r3dp::core {
                           boost::vecS,        // Vértices armazenados de 0 a n
                           boost::undirectedS  // Grafo não dirigido
                           >;
-  // lê o arquivo da lista de arestas e devolve o número de vértices e as arestas normalizadas
+  /**
+   * @brief Par de iteradores utilizável em range-for.
+   */
+  template <class Iterator>
+  struct iterator_range {
+    Iterator first;
+    Iterator last;
+
+    [[nodiscard]] Iterator begin() const noexcept {
+      return first;
+    }
+    [[nodiscard]] Iterator end() const noexcept {
+      return last;
+    }
+  };
+
+  /*
+   * Interface mínima que os algoritmos genéricos (decodificador, coloração, avaliação em lote)
+   * usam de um grafo: `vertex_count(g)` e `neighbors(g, v)`. Qualquer representação que ofereça
+   * essas duas funções (ex.: core::csr_graph) serve no lugar do graph_t do Boost.
+   */
+  inline std::size_t vertex_count( const graph_t &g ) {
+    return boost::num_vertices( g );
+  }
+
+  inline auto neighbors( const graph_t &g, vertex_t v ) {
+    auto [first, last] = boost::adjacent_vertices( v, g );
+    return iterator_range<decltype( first )>{ first, last };
+  }
+
+  template <class Graph>
+  concept adjacency_graph = requires( const Graph &g, vertex_t v ) {
+    { vertex_count( g ) } -> std::convertible_to<std::size_t>;
+    { *neighbors( g, v ).begin() } -> std::convertible_to<std::size_t>;
+  };
+
+  struct edge_stream_options;
+
+  // lê o arquivo da lista de arestas (texto puro, .gz ou .zst) e devolve o número de vértices e
+  // as arestas normalizadas
+  std::pair<vertex_t, std::set<edge_t>> read_graph_from_file( const std::string         &file_path,
+                                                              const edge_stream_options &options );
   std::pair<vertex_t, std::set<edge_t>> read_graph_from_file( const std::string &file_path );
 
   // Monta o grafo a partir da função de read_graph_from_file
@@ -26,4 +73,66 @@ namespace r3dp::core {
    * Pré-condição: o grafo é simples (sem múltiplas arestas paralelas e sem laços).
    */
   size_t max_degree( const graph_t &g );
+
+  /**
+   * @brief Classes de cor de um grafo: vértices de uma mesma classe nunca são adjacentes.
+   *
+   * `order` lista os vértices agrupados por cor (em ordem crescente dentro de cada classe) e a
+   * classe c ocupa order[offsets[c], offsets[c + 1]).
+   */
+  struct color_classes {
+    std::vector<vertex_t>    order;
+    std::vector<std::size_t> offsets;
+
+    [[nodiscard]] std::size_t count() const noexcept {
+      return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+  };
+
+  /**
+   * @brief Coloração gulosa (menor cor livre, vértices em ordem crescente), com até Δ(G) + 1 cores.
+   *
+   * Determinística: depende apenas do grafo.
+   */
+  template <adjacency_graph Graph>
+  color_classes greedy_color_classes( const Graph &g ) {
+    const std::size_t n = vertex_count( g );
+
+    // used[c] == v + 1 marca a cor c como ocupada por algum vizinho de v (evita limpar o vetor)
+    std::vector<vertex_t>    color( n, 0 );
+    std::vector<std::size_t> used;
+    vertex_t                 colors = 0;
+    for ( std::size_t v = 0; v < n; ++v ) {
+      for ( auto u : neighbors( g, static_cast<vertex_t>( v ) ) ) {
+        if ( static_cast<std::size_t>( u ) < v ) {
+          if ( color[u] >= used.size() ) {
+            used.resize( color[u] + 1, 0 );
+          }
+          used[color[u]] = v + 1;
+        }
+      }
+      vertex_t c = 0;
+      while ( c < used.size() && used[c] == v + 1 ) {
+        ++c;
+      }
+      color[v] = c;
+      colors   = std::max( colors, c + 1 );
+    }
+
+    // Ordenação por contagem: agrupa por cor mantendo a ordem crescente dentro de cada classe
+    color_classes classes;
+    classes.offsets.assign( static_cast<std::size_t>( colors ) + 1, 0 );
+    for ( std::size_t v = 0; v < n; ++v ) {
+      ++classes.offsets[color[v] + 1];
+    }
+    for ( std::size_t c = 1; c < classes.offsets.size(); ++c ) {
+      classes.offsets[c] += classes.offsets[c - 1];
+    }
+    classes.order.resize( n );
+    std::vector<std::size_t> next( classes.offsets.begin(), classes.offsets.end() - 1 );
+    for ( std::size_t v = 0; v < n; ++v ) {
+      classes.order[next[color[v]]++] = static_cast<vertex_t>( v );
+    }
+    return classes;
+  }
 }  // namespace r3dp::core
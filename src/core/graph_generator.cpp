@@ -0,0 +1,413 @@
+#include "graph_generator.hpp"
+
+#include "counter_rng.hpp"
+#include "edge_writer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace r3dp::core {
+  namespace {
+    constexpr std::uint64_t EDGES_PER_BLOCK = std::uint64_t{ 1 } << 16;  // alvo por bloco
+    constexpr std::uint64_t MAX_VERTICES    = std::uint64_t{ 1 } << 32;  // ids cabem em vertex_t
+
+    // counter_rng como UniformRandomBitGenerator, para as distribuições da biblioteca padrão
+    struct counter_bits {
+      using result_type = std::uint64_t;
+
+      counter_rng rng;
+
+      static constexpr result_type min() noexcept {
+        return 0;
+      }
+
+      static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+      }
+
+      result_type operator()() noexcept {
+        return rng.next_u64();
+      }
+    };
+
+    // Pares u < v em ordem lexicográfica: a linha u começa em u(2n - u - 1)/2
+    __uint128_t pair_offset( std::uint64_t n, std::uint64_t u ) {
+      return __uint128_t{ u } * ( 2 * n - u - 1 ) / 2;
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> pair_at( std::uint64_t n, std::uint64_t k ) {
+      const long double half = static_cast<long double>( n ) - 0.5L;
+      const long double root = std::sqrt( std::max( 0.0L, half * half - 2.0L * k ) );
+      auto              u    = static_cast<std::uint64_t>( std::max( 0.0L, half - root ) );
+      u                      = std::min( u, n - 2 );
+      while ( u > 0 && pair_offset( n, u ) > k ) {
+        --u;
+      }
+      while ( u + 2 < n && pair_offset( n, u + 1 ) <= k ) {
+        ++u;
+      }
+      return { u, u + 1 + static_cast<std::uint64_t>( k - pair_offset( n, u ) ) };
+    }
+
+    std::uint64_t emit( std::string &out, std::uint64_t u, std::uint64_t v ) {
+      append_edge( out, static_cast<vertex_t>( u ), static_cast<vertex_t>( v ) );
+      return 1;
+    }
+  }  // namespace
+
+  graph_model parse_graph_model( const std::string &name ) {
+    for ( auto model : { graph_model::gnp,
+                         graph_model::gnm,
+                         graph_model::geometric,
+                         graph_model::grid,
+                         graph_model::torus,
+                         graph_model::barabasi_albert,
+                         graph_model::rmat } ) {
+      if ( name == graph_model_name( model ) ) {
+        return model;
+      }
+    }
+    throw std::invalid_argument( "Modelo de grafo desconhecido: " + name );
+  }
+
+  const char *graph_model_name( graph_model model ) {
+    switch ( model ) {
+      case graph_model::gnp:
+        return "gnp";
+      case graph_model::gnm:
+        return "gnm";
+      case graph_model::geometric:
+        return "geometric";
+      case graph_model::grid:
+        return "grid";
+      case graph_model::torus:
+        return "torus";
+      case graph_model::barabasi_albert:
+        return "ba";
+      case graph_model::rmat:
+        return "rmat";
+    }
+    return "?";
+  }
+
+  graph_generator::graph_generator( const generator_options &_options ) : options( _options ) {
+    using std::invalid_argument;
+    switch ( options.model ) {
+      case graph_model::grid:
+      case graph_model::torus:
+        if ( options.rows == 0 || options.columns == 0 ||
+             options.rows > MAX_VERTICES / options.columns ) {
+          throw invalid_argument( "A grade precisa de 1 <= linhas * colunas <= 2^32" );
+        }
+        n = options.rows * options.columns;
+        break;
+      case graph_model::rmat:
+        if ( options.scale == 0 || options.scale > 32 ) {
+          throw invalid_argument( "R-MAT: a escala deve estar em [1, 32]" );
+        }
+        n = std::uint64_t{ 1 } << options.scale;
+        break;
+      default:
+        if ( options.vertices < 2 || options.vertices > MAX_VERTICES ) {
+          throw invalid_argument( "O número de vértices deve estar em [2, 2^32]" );
+        }
+        n = options.vertices;
+        break;
+    }
+
+    switch ( options.model ) {
+      case graph_model::gnp: {
+        if ( !( options.probability >= 0.0 && options.probability <= 1.0 ) ) {
+          throw invalid_argument( "G(n,p): a probabilidade deve estar em [0, 1]" );
+        }
+        // Linhas por bloco para cerca de EDGES_PER_BLOCK arestas (as linhas têm n - 1 - u pares)
+        const double per_row = std::max( 1.0, options.probability * double( n - 1 ) / 2.0 );
+        span   = std::clamp<std::uint64_t>( std::uint64_t( EDGES_PER_BLOCK / per_row ), 1, n );
+        blocks = ( n + span - 1 ) / span;
+        break;
+      }
+
+      case graph_model::gnm: {
+        const __uint128_t pairs = pair_offset( n, n - 1 );
+        if ( options.edges > pairs ) {
+          throw invalid_argument( "G(n,m): mais arestas que pares de vértices" );
+        }
+        blocks = ( options.edges + EDGES_PER_BLOCK - 1 ) / EDGES_PER_BLOCK;
+        blocks = std::clamp<std::uint64_t>( blocks, 1, static_cast<std::uint64_t>( pairs ) );
+        span   = static_cast<std::uint64_t>( pairs / blocks );
+
+        // Quantas arestas caem em cada faixa, em sequência: binomial sobre o que resta, limitada
+        // para que as faixas seguintes ainda comportem o restante
+        counter_bits  bits{ counter_rng( options.seed, 0 ) };
+        std::uint64_t edges_left = options.edges;
+        __uint128_t   pairs_left = pairs;
+        block_edges.resize( blocks );
+        for ( std::uint64_t b = 0; b < blocks; ++b ) {
+          const auto   size  = b + 1 < blocks ? span : static_cast<std::uint64_t>( pairs_left );
+          const double share = std::min( 1.0, double( size ) / double( pairs_left ) );
+          std::binomial_distribution<std::uint64_t> draw( edges_left, share );
+
+          const __uint128_t   after = pairs_left - size;
+          const std::uint64_t least = edges_left > after ? edges_left - std::uint64_t( after ) : 0;
+          const std::uint64_t most  = std::min( size, edges_left );
+          block_edges[b]            = std::clamp( draw( bits ), least, most );
+          edges_left -= block_edges[b];
+          pairs_left = after;
+        }
+        break;
+      }
+
+      case graph_model::geometric: {
+        if ( !( options.radius > 0.0 && options.radius <= std::sqrt( 2.0 ) ) ) {
+          throw invalid_argument( "Geométrico: o raio deve estar em (0, sqrt(2)]" );
+        }
+        // Células de lado >= radius; no máximo uma por vértice
+        const double side_cells = std::floor( 1.0 / options.radius );
+        cells_per_side          = std::clamp<std::uint64_t>(
+          std::uint64_t( std::min( side_cells, std::sqrt( double( n ) ) ) ), 1, n );
+        blocks = cells_per_side;
+
+        x.resize( n );
+        y.resize( n );
+        std::vector<std::uint64_t> cell_of( n );
+        cell_start.assign( cells_per_side * cells_per_side + 1, 0 );
+        for ( std::uint64_t i = 0; i < n; ++i ) {
+          counter_rng rng( options.seed, i );
+          x[i] = rng.uniform();
+          y[i] = rng.uniform();
+
+          const auto cx = std::min( std::uint64_t( x[i] * cells_per_side ), cells_per_side - 1 );
+          const auto cy = std::min( std::uint64_t( y[i] * cells_per_side ), cells_per_side - 1 );
+          cell_of[i]    = cy * cells_per_side + cx;
+          ++cell_start[cell_of[i] + 1];
+        }
+        for ( std::size_t c = 1; c < cell_start.size(); ++c ) {
+          cell_start[c] += cell_start[c - 1];
+        }
+        by_cell.resize( n );
+        std::vector<std::uint64_t> fill( cell_start.begin(), cell_start.end() - 1 );
+        for ( std::uint64_t i = 0; i < n; ++i ) {
+          by_cell[fill[cell_of[i]]++] = static_cast<std::uint32_t>( i );
+        }
+        break;
+      }
+
+      case graph_model::grid:
+      case graph_model::torus:
+        span = std::clamp<std::uint64_t>( EDGES_PER_BLOCK / ( 2 * options.columns ),
+                                          1,
+                                          options.rows );
+        blocks = ( options.rows + span - 1 ) / span;
+        break;
+
+      case graph_model::barabasi_albert:
+        if ( options.attachments == 0 ) {
+          throw invalid_argument( "Barabási–Albert: cada vértice precisa de ao menos uma aresta" );
+        }
+        span   = EDGES_PER_BLOCK;
+        blocks = ( n * options.attachments + span - 1 ) / span;
+        break;
+
+      case graph_model::rmat: {
+        const double d = 1.0 - options.rmat_a - options.rmat_b - options.rmat_c;
+        if ( options.rmat_a < 0.0 || options.rmat_b < 0.0 || options.rmat_c < 0.0 || d < -1e-12 ) {
+          throw invalid_argument( "R-MAT: a, b e c devem ser >= 0 com a + b + c <= 1" );
+        }
+        if ( !( options.edge_factor > 0.0 ) ) {
+          throw invalid_argument( "R-MAT: o fator de arestas deve ser positivo" );
+        }
+        span   = EDGES_PER_BLOCK;
+        blocks = ( std::uint64_t( options.edge_factor * double( n ) ) + span - 1 ) / span;
+        break;
+      }
+    }
+  }
+
+  std::uint64_t graph_generator::generate( std::uint64_t block, std::string &out ) const {
+    switch ( options.model ) {
+      case graph_model::gnp:
+        return generate_gnp( block, out );
+      case graph_model::gnm:
+        return generate_gnm( block, out );
+      case graph_model::geometric:
+        return generate_geometric( block, out );
+      case graph_model::grid:
+      case graph_model::torus:
+        return generate_grid( block, out );
+      case graph_model::barabasi_albert:
+        return generate_barabasi_albert( block, out );
+      case graph_model::rmat:
+        return generate_rmat( block, out );
+    }
+    return 0;
+  }
+
+  std::uint64_t graph_generator::generate_gnp( std::uint64_t block, std::string &out ) const {
+    const double        p     = options.probability;
+    const double        log_q = std::log1p( -p );
+    const std::uint64_t last  = std::min( n, ( block + 1 ) * span );
+    std::uint64_t       count = 0;
+    for ( std::uint64_t u = block * span; u < last; ++u ) {
+      if ( p <= 0.0 ) {
+        break;
+      }
+      counter_rng   rng( options.seed, u );  // um fluxo por linha
+      std::uint64_t v = u;
+      while ( true ) {
+        // Pares pulados até o próximo sucesso: geométrica de parâmetro p
+        const double skip = p >= 1.0 ? 0.0 : std::floor( std::log1p( -rng.uniform() ) / log_q );
+        if ( skip >= double( n - v - 1 ) ) {
+          break;
+        }
+        v += 1 + std::uint64_t( skip );
+        count += emit( out, u, v );
+      }
+    }
+    return count;
+  }
+
+  std::uint64_t graph_generator::generate_gnm( std::uint64_t block, std::string &out ) const {
+    const std::uint64_t first = block * span;
+    const std::uint64_t pairs = static_cast<std::uint64_t>( pair_offset( n, n - 1 ) );
+    const std::uint64_t size  = block + 1 < blocks ? span : pairs - first;
+    const std::uint64_t count = block_edges[block];
+
+    // Algoritmo de Floyd: `count` posições distintas da faixa, sem percorrê-la
+    counter_rng                       rng( options.seed, block + 1 );
+    std::unordered_set<std::uint64_t> chosen;
+    chosen.reserve( count );
+    for ( std::uint64_t j = size - count; j < size; ++j ) {
+      if ( !chosen.insert( rng.below_or_equal( j ) ).second ) {
+        chosen.insert( j );
+      }
+    }
+    std::vector<std::uint64_t> sorted( chosen.begin(), chosen.end() );
+    std::sort( sorted.begin(), sorted.end() );
+    for ( auto k : sorted ) {
+      const auto [u, v] = pair_at( n, first + k );
+      emit( out, u, v );
+    }
+    return count;
+  }
+
+  std::uint64_t graph_generator::generate_geometric( std::uint64_t block, std::string &out ) const {
+    const std::uint64_t g     = cells_per_side;
+    const double        r2    = options.radius * options.radius;
+    std::uint64_t       count = 0;
+
+    auto close = [&]( std::uint32_t i, std::uint32_t j ) {
+      const double dx = x[i] - x[j];
+      const double dy = y[i] - y[j];
+      return dx * dx + dy * dy <= r2;
+    };
+
+    // Cada par de células vizinhas é visitado uma vez: a própria e as de "depois" dela
+    constexpr int FORWARD[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+    const std::uint64_t cy = block;
+    for ( std::uint64_t cx = 0; cx < g; ++cx ) {
+      const std::uint64_t cell = cy * g + cx;
+      for ( std::uint64_t a = cell_start[cell]; a < cell_start[cell + 1]; ++a ) {
+        const std::uint32_t i = by_cell[a];
+        for ( std::uint64_t b = a + 1; b < cell_start[cell + 1]; ++b ) {
+          if ( close( i, by_cell[b] ) ) {
+            count += emit( out, i, by_cell[b] );
+          }
+        }
+        for ( const auto &d : FORWARD ) {
+          const std::int64_t nx = std::int64_t( cx ) + d[0];
+          const std::int64_t ny = std::int64_t( cy ) + d[1];
+          if ( nx < 0 || nx >= std::int64_t( g ) || ny >= std::int64_t( g ) ) {
+            continue;
+          }
+          const std::uint64_t other = std::uint64_t( ny ) * g + std::uint64_t( nx );
+          for ( std::uint64_t b = cell_start[other]; b < cell_start[other + 1]; ++b ) {
+            if ( close( i, by_cell[b] ) ) {
+              count += emit( out, i, by_cell[b] );
+            }
+          }
+        }
+      }
+    }
+    return count;
+  }
+
+  std::uint64_t graph_generator::generate_grid( std::uint64_t block, std::string &out ) const {
+    const std::uint64_t rows    = options.rows;
+    const std::uint64_t columns = options.columns;
+    const bool          torus   = options.model == graph_model::torus;
+    const std::uint64_t last    = std::min( rows, ( block + 1 ) * span );
+    std::uint64_t       count   = 0;
+    for ( std::uint64_t r = block * span; r < last; ++r ) {
+      for ( std::uint64_t c = 0; c < columns; ++c ) {
+        const std::uint64_t v = r * columns + c;
+        if ( c + 1 < columns ) {
+          count += emit( out, v, v + 1 );
+        } else if ( torus && columns > 2 ) {
+          count += emit( out, v, r * columns );
+        }
+        if ( r + 1 < rows ) {
+          count += emit( out, v, v + columns );
+        } else if ( torus && rows > 2 ) {
+          count += emit( out, v, c );
+        }
+      }
+    }
+    return count;
+  }
+
+  std::uint64_t graph_generator::generate_barabasi_albert( std::uint64_t block,
+                                                           std::string  &out ) const {
+    // Vetor implícito M: M[2e] = origem da aresta e (o vértice e / d) e M[2e + 1] = M[r], com r
+    // uniforme em [0, 2e]. Cada posição ímpar é recalculada pela cadeia de sorteios até uma par.
+    const std::uint64_t d     = options.attachments;
+    const std::uint64_t total = n * d;
+    const std::uint64_t last  = std::min( total, ( block + 1 ) * span );
+    std::uint64_t       count = 0;
+    for ( std::uint64_t e = block * span; e < last; ++e ) {
+      std::uint64_t at = e;
+      std::uint64_t r  = 0;
+      while ( true ) {
+        counter_rng rng( options.seed, at );
+        r = rng.below_or_equal( 2 * at );
+        if ( r % 2 == 0 ) {
+          break;
+        }
+        at = ( r - 1 ) / 2;
+      }
+      const std::uint64_t source = e / d;
+      const std::uint64_t target = r / 2 / d;
+      if ( source != target ) {
+        count += emit( out, source, target );
+      }
+    }
+    return count;
+  }
+
+  std::uint64_t graph_generator::generate_rmat( std::uint64_t block, std::string &out ) const {
+    const double        ab    = options.rmat_a + options.rmat_b;
+    const double        abc   = ab + options.rmat_c;
+    const std::uint64_t total = std::uint64_t( options.edge_factor * double( n ) );
+    const std::uint64_t last  = std::min( total, ( block + 1 ) * span );
+    std::uint64_t       count = 0;
+    for ( std::uint64_t e = block * span; e < last; ++e ) {
+      counter_rng   rng( options.seed, e );
+      std::uint64_t u = 0;
+      std::uint64_t v = 0;
+      for ( unsigned level = 0; level < options.scale; ++level ) {
+        const double q     = rng.uniform();
+        const bool   right = ( q >= options.rmat_a && q < ab ) || q >= abc;  // quadrantes b e d
+        u                  = ( u << 1 ) | std::uint64_t( q >= ab );          // quadrantes c e d
+        v                  = ( v << 1 ) | std::uint64_t( right );
+      }
+      if ( u != v ) {
+        count += emit( out, u, v );
+      }
+    }
+    return count;
+  }
+
+}  // namespace r3dp::core
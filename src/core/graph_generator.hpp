@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace r3dp::core {
+
+  enum class graph_model { gnp, gnm, geometric, grid, torus, barabasi_albert, rmat };
+
+  // Nomes aceitos na linha de comando: gnp, gnm, geometric, grid, torus, ba e rmat
+  graph_model parse_graph_model( const std::string &name );  // std::invalid_argument se não houver
+  const char *graph_model_name( graph_model model );
+
+  struct generator_options {
+    graph_model   model       = graph_model::gnp;
+    std::uint64_t vertices    = 0;     // gnp, gnm, geometric e ba
+    std::uint64_t edges       = 0;     // gnm
+    double        probability = 0.0;   // gnp
+    double        radius      = 0.0;   // geometric: pontos no quadrado unitário
+    std::uint64_t rows        = 0;     // grid e torus
+    std::uint64_t columns     = 0;     // grid e torus
+    unsigned      attachments = 0;     // ba: arestas de cada vértice novo
+    unsigned      scale       = 0;     // rmat: 2^scale vértices
+    double        edge_factor = 16.0;  // rmat: arestas por vértice
+    double        rmat_a      = 0.57;  // rmat: probabilidades dos quadrantes (d = 1 - a - b - c)
+    double        rmat_b      = 0.19;
+    double        rmat_c      = 0.19;
+    std::uint64_t seed        = 1;
+  };
+
+  /**
+   * @brief Gerador de grafos sintéticos em blocos independentes.
+   *
+   * A saída é dividida em `block_count()` blocos que podem ser gerados em qualquer thread e em
+   * qualquer ordem: cada bloco sorteia de fluxos counter_rng ligados só à semente e ao que ele
+   * gera (linha, aresta ou célula), então o arquivo concatenado na ordem dos blocos é o mesmo para
+   * qualquer número de threads. Modelos:
+   *
+   * - gnp: G(n, p), por saltos geométricos entre os vizinhos maiores de cada vértice (O(n + m));
+   * - gnm: G(n, m) com m pares distintos; os blocos dividem os n(n-1)/2 pares em faixas iguais e
+   *   recebem quantidades por divisão binomial condicional (multinomial), que coincide com a
+   *   hipergeométrica exata quando m é pequeno perto de n²;
+   * - geometric: n pontos uniformes no quadrado unitário ligados a distância <= radius, com uma
+   *   grade de células de lado radius (um bloco por linha de células);
+   * - grid / torus: grade rows x columns com vizinhança de 4 (o toro liga as bordas);
+   * - ba: Barabási–Albert com `attachments` arestas por vértice, pela formulação em vetor de
+   *   Batagelj e Brandes; o destino de cada aresta é recalculado a partir do próprio sorteio, como
+   *   na versão paralela de Sanders e Schulz, em vez de depender das arestas anteriores;
+   * - rmat: R-MAT com 2^scale vértices e edge_factor · 2^scale arestas.
+   *
+   * Laços não são gerados; ba e rmat podem repetir arestas, que a leitura descarta.
+   */
+  class graph_generator {
+  public:
+    explicit graph_generator( const generator_options &options );  // std::invalid_argument
+
+    [[nodiscard]] std::uint64_t vertex_count() const noexcept {
+      return n;
+    }
+
+    [[nodiscard]] std::uint64_t block_count() const noexcept {
+      return blocks;
+    }
+
+    // Acrescenta a `out` as arestas do bloco como linhas "u v"; retorna quantas
+    std::uint64_t generate( std::uint64_t block, std::string &out ) const;
+
+  private:
+    generator_options options;
+    std::uint64_t     n      = 0;
+    std::uint64_t     blocks = 0;
+    std::uint64_t     span   = 0;  // linhas, arestas ou pares por bloco, conforme o modelo
+
+    std::vector<std::uint64_t> block_edges;  // gnm: arestas sorteadas em cada bloco
+
+    // geometric: pontos agrupados por célula
+    std::uint64_t              cells_per_side = 0;
+    std::vector<double>        x;
+    std::vector<double>        y;
+    std::vector<std::uint64_t> cell_start;  // início de cada célula em `by_cell`
+    std::vector<std::uint32_t> by_cell;     // vértices em ordem de célula
+
+    std::uint64_t generate_gnp( std::uint64_t block, std::string &out ) const;
+    std::uint64_t generate_gnm( std::uint64_t block, std::string &out ) const;
+    std::uint64_t generate_geometric( std::uint64_t block, std::string &out ) const;
+    std::uint64_t generate_grid( std::uint64_t block, std::string &out ) const;
+    std::uint64_t generate_barabasi_albert( std::uint64_t block, std::string &out ) const;
+    std::uint64_t generate_rmat( std::uint64_t block, std::string &out ) const;
+  };
+
+}  // namespace r3dp::core
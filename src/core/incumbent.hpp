@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace r3dp::core {
+
+  // Uma solução publicada: chaves no formato do BRKGA (um gene em [0, 1] por vértice)
+  struct incumbent_solution {
+    std::vector<double>                   keys;
+    double                                fitness = std::numeric_limits<double>::infinity();
+    unsigned                              source  = 0;  // quem publicou (índice do motor)
+    std::chrono::steady_clock::time_point found_at;
+  };
+
+  /**
+   * @brief Melhor solução compartilhada entre motores que rodam ao mesmo tempo (minimização).
+   *
+   * `best_fitness()` e `version()` são leituras atômicas simples, baratas o bastante para serem
+   * consultadas a cada geração ou iteração. `offer` só aloca quando a oferta melhora o fitness: a
+   * disputa é decidida por compare-and-swap no fitness, e a cópia das chaves é publicada depois por
+   * troca atômica de ponteiro, sem mutex. Entre as duas etapas `best_fitness()` pode estar um passo
+   * à frente de `snapshot()`; quem lê o instantâneo deve conferir o fitness que veio nele.
+   */
+  class shared_incumbent {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    // Publica (keys, fitness) se for melhor que o incumbente; retorna true se publicou
+    bool offer( std::span<const double> keys, double fitness, unsigned source ) {
+      double current = best.load( std::memory_order_acquire );
+      while ( fitness < current ) {
+        if ( !best.compare_exchange_weak( current, fitness, std::memory_order_acq_rel ) ) {
+          continue;  // 'current' foi recarregado
+        }
+
+        auto entry = std::make_shared<const incumbent_solution>(
+          incumbent_solution{ { keys.begin(), keys.end() }, fitness, source, clock::now() } );
+
+        // Um publicador com fitness ainda melhor pode ter gravado antes: o slot só melhora
+        auto previous = slot.load( std::memory_order_acquire );
+        while ( ( !previous || entry->fitness < previous->fitness ) &&
+                !slot.compare_exchange_weak( previous, entry, std::memory_order_acq_rel ) ) {
+        }
+        updates.fetch_add( 1, std::memory_order_release );
+        return true;
+      }
+      return false;
+    }
+
+    [[nodiscard]] double best_fitness() const noexcept {
+      return best.load( std::memory_order_acquire );
+    }
+
+    // Número de publicações; muda sempre que há um instantâneo novo
+    [[nodiscard]] std::uint64_t version() const noexcept {
+      return updates.load( std::memory_order_acquire );
+    }
+
+    // Última solução publicada (nulo se ninguém publicou ainda)
+    [[nodiscard]] std::shared_ptr<const incumbent_solution> snapshot() const {
+      return slot.load( std::memory_order_acquire );
+    }
+
+  private:
+    static constexpr double NO_FITNESS = std::numeric_limits<double>::infinity();
+
+    std::atomic<double>                                    best{ NO_FITNESS };
+    std::atomic<std::uint64_t>                             updates{ 0 };
+    std::atomic<std::shared_ptr<const incumbent_solution>> slot;
+  };
+
+}  // namespace r3dp::core
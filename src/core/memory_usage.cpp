@@ -0,0 +1,33 @@
+#include "memory_usage.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace r3dp::core {
+  namespace {
+    // Lê um campo "Nome:   123 kB" de /proc/self/status
+    std::size_t read_status_kib( const std::string &field ) {
+      std::ifstream status( "/proc/self/status" );
+      std::string   line;
+      while ( std::getline( status, line ) ) {
+        if ( line.compare( 0, field.size(), field ) == 0 ) {
+          std::istringstream value( line.substr( field.size() ) );
+          std::size_t        kib = 0;
+          value >> kib;
+          return kib * 1024;
+        }
+      }
+      return 0;
+    }
+  }  // namespace
+
+  std::size_t peak_rss_bytes() {
+    return read_status_kib( "VmHWM:" );
+  }
+
+  std::size_t current_rss_bytes() {
+    return read_status_kib( "VmRSS:" );
+  }
+
+}  // namespace r3dp::core
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Pico de memória residente do processo (VmHWM em /proc/self/status), em bytes.
+   *
+   * Retorna 0 quando a informação não está disponível (fora do Linux, por exemplo).
+   */
+  std::size_t peak_rss_bytes();
+
+  /// @brief Memória residente atual (VmRSS), em bytes; 0 se indisponível.
+  std::size_t current_rss_bytes();
+
+}  // namespace r3dp::core
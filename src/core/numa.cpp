@@ -0,0 +1,176 @@
+#include "numa.hpp"
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace r3dp::core {
+  namespace {
+    // Modos de linux/mempolicy.h (ABI estável do kernel)
+    constexpr int MEMPOLICY_DEFAULT    = 0;
+    constexpr int MEMPOLICY_INTERLEAVE = 3;
+
+    constexpr const char *NODE_DIRECTORY = "/sys/devices/system/node";
+
+    bool set_memory_policy( int mode, const std::vector<unsigned long> &mask ) noexcept {
+#ifdef __linux__
+      // O kernel lê maxnode - 1 bits da máscara
+      const unsigned long bits = mask.size() * sizeof( unsigned long ) * 8;
+      const unsigned long *nodes = mask.empty() ? nullptr : mask.data();
+      return syscall( SYS_set_mempolicy, mode, nodes, bits + 1 ) == 0;
+#else
+      (void)mode;
+      (void)mask;
+      return false;
+#endif
+    }
+  }  // namespace
+
+  std::vector<unsigned> parse_cpu_list( const std::string &text ) {
+    std::vector<unsigned> cpus;
+    const char           *at  = text.data();
+    const char           *end = text.data() + text.size();
+    while ( end > at && ( end[-1] == '\n' || end[-1] == ' ' ) ) {
+      --end;
+    }
+
+    while ( at < end ) {
+      unsigned first = 0;
+      auto     read  = std::from_chars( at, end, first );
+      if ( read.ec != std::errc{} ) {
+        throw std::invalid_argument( "lista de CPUs inválida: " + text );
+      }
+      unsigned last = first;
+      at            = read.ptr;
+      if ( at < end && *at == '-' ) {
+        read = std::from_chars( at + 1, end, last );
+        if ( read.ec != std::errc{} || last < first ) {
+          throw std::invalid_argument( "lista de CPUs inválida: " + text );
+        }
+        at = read.ptr;
+      }
+      for ( unsigned cpu = first; cpu <= last; ++cpu ) {
+        cpus.push_back( cpu );
+      }
+      if ( at < end && *at++ != ',' ) {
+        throw std::invalid_argument( "lista de CPUs inválida: " + text );
+      }
+    }
+    std::sort( cpus.begin(), cpus.end() );
+    cpus.erase( std::unique( cpus.begin(), cpus.end() ), cpus.end() );
+    return cpus;
+  }
+
+  std::vector<numa_node> numa_nodes() {
+    const auto               allowed_list = thread_pool::allowed_cpus();
+    const std::set<unsigned> allowed( allowed_list.begin(), allowed_list.end() );
+    std::vector<numa_node>   nodes;
+    std::error_code          error;
+    for ( const auto &entry : std::filesystem::directory_iterator( NODE_DIRECTORY, error ) ) {
+      const std::string name = entry.path().filename().string();
+      unsigned          id   = 0;
+      if ( !name.starts_with( "node" ) ||
+           std::from_chars( name.data() + 4, name.data() + name.size(), id ).ec != std::errc{} ) {
+        continue;
+      }
+
+      std::ifstream in( entry.path() / "cpulist" );
+      std::string   text;
+      if ( !in || !std::getline( in, text ) ) {
+        continue;
+      }
+      numa_node node{ id, {} };
+      try {
+        for ( unsigned cpu : parse_cpu_list( text ) ) {
+          if ( allowed.contains( cpu ) ) {
+            node.cpus.push_back( cpu );
+          }
+        }
+      } catch ( const std::invalid_argument & ) {
+        continue;
+      }
+      if ( !node.cpus.empty() ) {
+        nodes.push_back( std::move( node ) );
+      }
+    }
+
+    if ( nodes.empty() ) {
+      nodes.push_back( { 0, allowed_list } );
+    }
+    std::sort( nodes.begin(), nodes.end(), []( const numa_node &a, const numa_node &b ) {
+      return a.id < b.id;
+    } );
+    return nodes;
+  }
+
+  unsigned thread_placement::domain_count() const noexcept {
+    return domains.empty() ? 1 : *std::max_element( domains.begin(), domains.end() ) + 1;
+  }
+
+  thread_placement numa_placement( unsigned threads, const std::vector<numa_node> &nodes ) {
+    if ( nodes.empty() ) {
+      throw std::invalid_argument( "numa_placement: nenhum nó" );
+    }
+    const unsigned participants = std::max( threads, 1U );
+    const unsigned used = std::min<unsigned>( participants, static_cast<unsigned>( nodes.size() ) );
+
+    thread_placement placement;
+    for ( unsigned s = 0; s < participants; ++s ) {
+      const unsigned d    = s % used;
+      const auto    &cpus = nodes[d].cpus;
+      placement.cpus.push_back( cpus[( s / used ) % cpus.size()] );
+      placement.domains.push_back( d );
+    }
+    return placement;
+  }
+
+  void bind_current_thread( const numa_node &node ) noexcept {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for ( unsigned cpu : node.cpus ) {
+      if ( cpu < CPU_SETSIZE ) {
+        CPU_SET( cpu, &set );
+      }
+    }
+    pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );  // falha não é fatal
+#else
+    (void)node;
+#endif
+  }
+
+  scoped_interleave::scoped_interleave( const std::vector<numa_node> &nodes ) {
+    if ( nodes.size() < 2 ) {
+      return;
+    }
+    unsigned highest = 0;
+    for ( const auto &node : nodes ) {
+      highest = std::max( highest, node.id );
+    }
+    constexpr unsigned         WORD_BITS = sizeof( unsigned long ) * 8;
+    std::vector<unsigned long> mask( highest / WORD_BITS + 1, 0 );
+    for ( const auto &node : nodes ) {
+      mask[node.id / WORD_BITS] |= 1UL << ( node.id % WORD_BITS );
+    }
+    interleaving = set_memory_policy( MEMPOLICY_INTERLEAVE, mask );
+  }
+
+  scoped_interleave::~scoped_interleave() {
+    if ( interleaving ) {
+      set_memory_policy( MEMPOLICY_DEFAULT, {} );
+    }
+  }
+
+}  // namespace r3dp::core
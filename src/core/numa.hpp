@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace r3dp::core {
+
+  struct numa_node {
+    unsigned              id = 0;  // número do nó no sysfs
+    std::vector<unsigned> cpus;    // CPUs do nó em que o processo pode executar
+  };
+
+  // Lista de CPUs do sysfs ("0-3,8,10-11") em ordem crescente; std::invalid_argument se malformada
+  std::vector<unsigned> parse_cpu_list( const std::string &text );
+
+  /**
+   * @brief Nós NUMA lidos de /sys/devices/system/node, restritos às CPUs permitidas ao processo.
+   *
+   * Nós sem CPUs permitidas (ex.: só memória) ficam de fora. Sem o sysfs, ou se nenhum nó tiver
+   * CPUs permitidas, devolve um único nó 0 com todas as CPUs permitidas.
+   */
+  std::vector<numa_node> numa_nodes();
+
+  // Onde fica cada participante de um thread_pool: cpus[s] e domains[s] para o slot s
+  struct thread_placement {
+    std::vector<unsigned> cpus;
+    std::vector<unsigned> domains;  // índice em `nodes`, não o id do nó
+
+    [[nodiscard]] unsigned domain_count() const noexcept;
+  };
+
+  /**
+   * Distribui `threads` participantes pelos nós em rodízio (slot s no nó s mod D, com D =
+   * min(threads, nós)), cada um fixado na próxima CPU livre do seu nó; as CPUs de um nó se repetem
+   * quando ele recebe mais threads do que tem. O slot 0 (a thread chamadora) fica no primeiro nó.
+   */
+  thread_placement numa_placement( unsigned threads, const std::vector<numa_node> &nodes );
+
+  // Restringe a thread chamadora às CPUs de `node` (as threads que ela criar depois herdam isso)
+  void bind_current_thread( const numa_node &node ) noexcept;
+
+  /**
+   * @brief Intercala pelas páginas dos nós dados a memória que a thread atual tocar primeiro
+   * enquanto o objeto existir (set_mempolicy com MPOL_INTERLEAVE, sem libnuma).
+   *
+   * Serve para estruturas somente leitura usadas por threads de todos os nós, como o grafo: é
+   * criado antes da leitura e destruído depois dela. Com um só nó, ou se o kernel recusar a
+   * política, não faz nada (`active()` é false). O destrutor volta à política padrão.
+   */
+  class scoped_interleave {
+  public:
+    explicit scoped_interleave( const std::vector<numa_node> &nodes );
+    ~scoped_interleave();
+
+    scoped_interleave( const scoped_interleave & )            = delete;
+    scoped_interleave &operator=( const scoped_interleave & ) = delete;
+
+    [[nodiscard]] bool active() const noexcept {
+      return interleaving;
+    }
+
+  private:
+    bool interleaving = false;
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,200 @@
+#include "perf_counters.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+  #include <cerrno>
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace r3dp::core {
+  namespace {
+    std::uint64_t now_ns() noexcept {
+      return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch() )
+          .count() );
+    }
+
+#ifdef __linux__
+    constexpr std::array<std::uint64_t, hw_counter_count> hw_configs{
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES };
+
+    int open_counter( std::uint64_t config, int group_fd ) noexcept {
+      perf_event_attr attr{};
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.size           = sizeof( attr );
+      attr.config         = config;
+      attr.disabled       = 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      // pid = 0, cpu = -1: mede apenas a thread chamadora, em qualquer CPU
+      return static_cast<int>( syscall( SYS_perf_event_open, &attr, 0, -1, group_fd, 0 ) );
+    }
+#endif
+  }  // namespace
+
+  perf_counter_group::perf_counter_group() {
+    fds.fill( -1 );
+#ifdef __linux__
+    leader_fd = open_counter( hw_configs[0], -1 );
+    if ( leader_fd < 0 ) {
+      error_message = std::string( "perf_event_open: " ) + std::strerror( errno );
+      return;
+    }
+    fds[0]  = leader_fd;
+    slot[0] = opened++;
+    for ( std::size_t c = 1; c < hw_counter_count; ++c ) {
+      fds[c] = open_counter( hw_configs[c], leader_fd );
+      if ( fds[c] >= 0 ) {
+        slot[c] = opened++;
+      }
+    }
+#else
+    error_message = "contadores de hardware disponíveis apenas no Linux";
+#endif
+  }
+
+  perf_counter_group::~perf_counter_group() {
+#ifdef __linux__
+    for ( int fd : fds ) {
+      if ( fd >= 0 ) {
+        close( fd );
+      }
+    }
+#endif
+  }
+
+  perf_counter_group &perf_counter_group::for_this_thread() {
+    thread_local perf_counter_group group;
+    return group;
+  }
+
+  counter_values perf_counter_group::read() const noexcept {
+    counter_values out;
+#ifdef __linux__
+    if ( leader_fd < 0 ) {
+      return out;
+    }
+
+    // Formato do grupo: nr, time_enabled, time_running, valor[nr]
+    std::array<std::uint64_t, 3 + hw_counter_count> buffer{};
+    const auto bytes = ::read( leader_fd, buffer.data(), sizeof( buffer ) );
+    if ( bytes < static_cast<ssize_t>( 3 * sizeof( std::uint64_t ) ) ) {
+      return out;
+    }
+
+    const std::uint64_t enabled = buffer[1];
+    const std::uint64_t running = buffer[2];
+    const double scale = ( running > 0 && running < enabled )
+                           ? static_cast<double>( enabled ) / static_cast<double>( running )
+                           : 1.0;
+    for ( std::size_t c = 0; c < hw_counter_count; ++c ) {
+      if ( fds[c] >= 0 && slot[c] < buffer[0] ) {
+        out.value[c] =
+          static_cast<std::uint64_t>( static_cast<double>( buffer[3 + slot[c]] ) * scale );
+      }
+    }
+#endif
+    return out;
+  }
+
+  perf_recorder::perf_recorder( unsigned threads ) : slots( threads == 0 ? 1 : threads ) {}
+
+  void perf_recorder::add( unsigned                  thread_slot,
+                           perf_region               region,
+                           const perf_region_totals &sample ) noexcept {
+    auto &totals = slots[thread_slot].regions[static_cast<std::size_t>( region )];
+    totals.counters += sample.counters;
+    totals.elapsed_ns += sample.elapsed_ns;
+    totals.samples += sample.samples;
+  }
+
+  void perf_recorder::reset() noexcept {
+    for ( auto &s : slots ) {
+      s = thread_slot{};
+    }
+  }
+
+  perf_report perf_recorder::report() const {
+    perf_report out;
+    out.enabled = enabled;
+    if ( !enabled ) {
+      return out;
+    }
+
+    const auto &group = perf_counter_group::for_this_thread();
+    out.available     = group.available();
+    out.error         = group.error();
+    for ( std::size_t c = 0; c < hw_counter_count; ++c ) {
+      out.counter_available[c] = group.has( static_cast<hw_counter>( c ) );
+    }
+
+    for ( std::size_t r = 0; r < perf_region_count; ++r ) {
+      auto &region = out.regions[r];
+      for ( const auto &s : slots ) {
+        region.totals.counters += s.regions[r].counters;
+        region.totals.elapsed_ns += s.regions[r].elapsed_ns;
+        region.totals.samples += s.regions[r].samples;
+      }
+
+      const auto &counters      = region.totals.counters;
+      const auto  cycles        = static_cast<double>( counters[hw_counter::cycles] );
+      const auto  instructions  = static_cast<double>( counters[hw_counter::instructions] );
+      const auto  cache_misses  = static_cast<double>( counters[hw_counter::cache_misses] );
+      const auto  branch_misses = static_cast<double>( counters[hw_counter::branch_misses] );
+      if ( cycles > 0.0 ) {
+        region.ipc = instructions / cycles;
+      }
+      if ( instructions > 0.0 ) {
+        region.cache_misses_per_kinstr  = 1000.0 * cache_misses / instructions;
+        region.branch_misses_per_kinstr = 1000.0 * branch_misses / instructions;
+      }
+      if ( region.totals.elapsed_ns > 0 ) {
+        // elapsed_ns soma o tempo de todas as threads, então isto é a banda média por thread
+        region.memory_bandwidth_gbps =
+          cache_misses * 64.0 / static_cast<double>( region.totals.elapsed_ns );
+      }
+    }
+    return out;
+  }
+
+  scoped_perf_region::scoped_perf_region( perf_recorder *recorder,
+                                          unsigned       thread_slot,
+                                          perf_region    region ) noexcept
+    : thread_slot( thread_slot ), region( region ) {
+    if ( recorder == nullptr || !recorder->is_enabled() ) {
+      return;
+    }
+    this->recorder = recorder;
+    group          = &perf_counter_group::for_this_thread();
+    start_values   = group->read();
+    start_ns       = now_ns();
+  }
+
+  scoped_perf_region::~scoped_perf_region() {
+    if ( recorder == nullptr ) {
+      return;
+    }
+    const counter_values end_values = group->read();
+    perf_region_totals   sample;
+    sample.elapsed_ns = now_ns() - start_ns;
+    sample.samples    = 1;
+    for ( std::size_t c = 0; c < hw_counter_count; ++c ) {
+      // A escala por multiplexação pode variar entre leituras; diferenças negativas viram zero
+      sample.counters.value[c] = end_values.value[c] > start_values.value[c]
+                                   ? end_values.value[c] - start_values.value[c]
+                                   : 0;
+    }
+    recorder->add( thread_slot, region, sample );
+  }
+
+}  // namespace r3dp::core
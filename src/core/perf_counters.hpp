@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Contadores de hardware lidos em grupo (o primeiro é o líder do grupo).
+   */
+  enum class hw_counter : std::uint8_t { cycles, instructions, cache_misses, branch_misses, count };
+
+  inline constexpr std::size_t hw_counter_count = static_cast<std::size_t>( hw_counter::count );
+
+  constexpr std::string_view hw_counter_name( hw_counter c ) noexcept {
+    switch ( c ) {
+      case hw_counter::cycles       : return "cycles";
+      case hw_counter::instructions : return "instructions";
+      case hw_counter::cache_misses : return "cache_misses";
+      case hw_counter::branch_misses: return "branch_misses";
+      default                       : return "unknown";
+    }
+  }
+
+  /**
+   * @brief Regiões do código medidas com contadores de hardware.
+   *
+   * `repair` é uma sub-região de `decode` (o laço de reparo do decodificador).
+   */
+  enum class perf_region : std::uint8_t { crossover, decode, repair, count };
+
+  inline constexpr std::size_t perf_region_count = static_cast<std::size_t>( perf_region::count );
+
+  constexpr std::string_view perf_region_name( perf_region region ) noexcept {
+    switch ( region ) {
+      case perf_region::crossover: return "crossover";
+      case perf_region::decode   : return "decode";
+      case perf_region::repair   : return "repair";
+      default                    : return "unknown";
+    }
+  }
+
+  /**
+   * @brief Leitura (ou soma de leituras) de um grupo de contadores.
+   */
+  struct counter_values {
+    std::array<std::uint64_t, hw_counter_count> value{};
+
+    [[nodiscard]] std::uint64_t operator[]( hw_counter c ) const noexcept {
+      return value[static_cast<std::size_t>( c )];
+    }
+
+    counter_values &operator+=( const counter_values &other ) noexcept {
+      for ( std::size_t i = 0; i < hw_counter_count; ++i ) {
+        value[i] += other.value[i];
+      }
+      return *this;
+    }
+  };
+
+  /**
+   * @brief Grupo de contadores `perf_event_open` da thread chamadora.
+   *
+   * Os contadores são abertos já habilitados e nunca são zerados; uma região é medida pela
+   * diferença entre duas leituras, o que permite aninhar regiões (ex.: repair dentro de decode).
+   * Quando o kernel não permite a abertura (perf_event_paranoid, seccomp, VM sem PMU ou sistema
+   * não Linux), `available()` retorna false e `read()` devolve zeros.
+   */
+  class perf_counter_group {
+  public:
+    perf_counter_group();
+    ~perf_counter_group();
+
+    perf_counter_group( const perf_counter_group & )            = delete;
+    perf_counter_group &operator=( const perf_counter_group & ) = delete;
+
+    /// @brief Grupo da thread chamadora, aberto na primeira chamada.
+    static perf_counter_group &for_this_thread();
+
+    [[nodiscard]] bool available() const noexcept {
+      return leader_fd >= 0;
+    }
+
+    /// @brief Indica se o contador `c` pôde ser aberto (o líder pode existir sem os demais).
+    [[nodiscard]] bool has( hw_counter c ) const noexcept {
+      return fds[static_cast<std::size_t>( c )] >= 0;
+    }
+
+    [[nodiscard]] const std::string &error() const noexcept {
+      return error_message;
+    }
+
+    /// @brief Valores acumulados desde a abertura, escalados por multiplexação.
+    [[nodiscard]] counter_values read() const noexcept;
+
+  private:
+    int                                       leader_fd = -1;
+    std::array<int, hw_counter_count>         fds{};
+    std::array<std::size_t, hw_counter_count> slot{};  // posição de cada contador na leitura
+    std::size_t                               opened = 0;
+    std::string                               error_message;
+  };
+
+  /**
+   * @brief Totais de uma região: contadores somados, tempo e número de medições.
+   */
+  struct perf_region_totals {
+    counter_values counters;
+    std::uint64_t  elapsed_ns = 0;
+    std::uint64_t  samples    = 0;
+  };
+
+  /**
+   * @brief Métricas derivadas de uma região.
+   *
+   * A banda de memória é uma estimativa: falhas de cache de último nível × 64 bytes / tempo.
+   */
+  struct perf_region_report {
+    perf_region_totals totals;
+    double             ipc                      = 0.0;
+    double             cache_misses_per_kinstr  = 0.0;
+    double             branch_misses_per_kinstr = 0.0;
+    double             memory_bandwidth_gbps    = 0.0;
+  };
+
+  struct perf_report {
+    bool                                              enabled   = false;
+    bool                                              available = false;
+    std::string                                       error;
+    std::array<bool, hw_counter_count>                counter_available{};
+    std::array<perf_region_report, perf_region_count> regions{};
+  };
+
+  /**
+   * @brief Acumula medições de regiões em um slot por thread, sem travas.
+   *
+   * Quando desabilitado (padrão), as regiões custam apenas um teste de ponteiro.
+   */
+  class perf_recorder {
+  public:
+    explicit perf_recorder( unsigned threads );
+
+    void enable( bool on ) noexcept {
+      enabled = on;
+    }
+
+    [[nodiscard]] bool is_enabled() const noexcept {
+      return enabled;
+    }
+
+    void add( unsigned thread_slot, perf_region region, const perf_region_totals &sample ) noexcept;
+
+    void reset() noexcept;
+
+    [[nodiscard]] perf_report report() const;
+
+  private:
+    struct alignas( 64 ) thread_slot {
+      std::array<perf_region_totals, perf_region_count> regions{};
+    };
+
+    std::vector<thread_slot> slots;
+    bool                     enabled = false;
+  };
+
+  /**
+   * @brief Mede uma região com o grupo da thread chamadora e soma o resultado ao recorder.
+   */
+  class scoped_perf_region {
+  public:
+    scoped_perf_region( perf_recorder *recorder, unsigned thread_slot, perf_region region ) noexcept;
+    ~scoped_perf_region();
+
+    scoped_perf_region( const scoped_perf_region & )            = delete;
+    scoped_perf_region &operator=( const scoped_perf_region & ) = delete;
+
+  private:
+    perf_recorder      *recorder = nullptr;
+    perf_counter_group *group    = nullptr;
+    unsigned            thread_slot;
+    perf_region         region;
+    counter_values      start_values;
+    std::uint64_t       start_ns = 0;
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Fases instrumentadas de um motor evolutivo.
+   *
+   * `count` não é uma fase: serve apenas para dimensionar os vetores de contadores.
+   */
+  enum class phase : std::uint8_t { initialize, crossover, decode, sort, exchange_elite, count };
+
+  inline constexpr std::size_t phase_count = static_cast<std::size_t>( phase::count );
+
+  constexpr std::string_view phase_name( phase ph ) noexcept {
+    switch ( ph ) {
+      case phase::initialize    : return "initialize";
+      case phase::crossover     : return "crossover";
+      case phase::decode        : return "decode";
+      case phase::sort          : return "sort";
+      case phase::exchange_elite: return "exchange_elite";
+      default                   : return "unknown";
+    }
+  }
+
+  /**
+   * @brief Contadores de uma única thread.
+   *
+   * Cada thread escreve apenas no seu próprio slot; o alinhamento em linha de cache evita
+   * false sharing entre slots vizinhos, então nenhuma sincronização é necessária no caminho
+   * quente.
+   */
+  struct alignas( 64 ) thread_phase_counters {
+    std::array<std::uint64_t, phase_count> elapsed_ns{};  // tempo gasto por esta thread em cada fase
+    std::uint64_t                          evaluations       = 0;
+    std::uint64_t                          repair_passes     = 0;
+    std::uint64_t                          delta_evaluations = 0;  // decodificações incrementais
+  };
+
+  /**
+   * @brief Agregado das medições de uma execução.
+   */
+  struct phase_report {
+    double                          engine_seconds             = 0.0;  // tempo de parede
+    double                          busy_seconds               = 0.0;  // soma entre threads
+    std::uint64_t                   evaluations                = 0;
+    double                          evaluations_per_second     = 0.0;
+    double                          repair_passes_per_decode   = 0.0;
+    double                          delta_decode_fraction      = 0.0;  // das avaliações
+    double                          thread_utilization         = 0.0;
+    std::array<double, phase_count> phase_seconds{};
+    std::array<double, phase_count> phase_fraction{};
+  };
+
+  /**
+   * @brief Coleta tempos por fase e contadores de avaliação por thread.
+   *
+   * Cada thread soma no próprio slot o tempo que gastou em cada fase, então as fases podem rodar
+   * em paralelo (várias ilhas, por exemplo) sem disputa. O tempo de parede do motor é informado
+   * por quem o dirige, com `add_wall`. A fração de cada fase é relativa ao tempo ocupado somado
+   * de todas as threads, e a utilização compara esse total com parede × threads.
+   */
+  class phase_stats {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    explicit phase_stats( unsigned threads ) : per_thread( threads == 0 ? 1 : threads ) {}
+
+    [[nodiscard]] thread_phase_counters &local( unsigned thread_id ) noexcept {
+      return per_thread[thread_id];
+    }
+
+    [[nodiscard]] unsigned thread_count() const noexcept {
+      return static_cast<unsigned>( per_thread.size() );
+    }
+
+    /// @brief Acumulador de tempo da fase `ph` no slot `thread_id`.
+    [[nodiscard]] std::uint64_t &elapsed( unsigned thread_id, phase ph ) noexcept {
+      return per_thread[thread_id].elapsed_ns[static_cast<std::size_t>( ph )];
+    }
+
+    /// @brief Soma tempo de parede do motor (chamado apenas pela thread que o dirige).
+    void add_wall( std::uint64_t ns ) noexcept {
+      wall_ns += ns;
+    }
+
+    void reset() noexcept {
+      for ( auto &counters : per_thread ) {
+        counters = thread_phase_counters{};
+      }
+      wall_ns = 0;
+    }
+
+    [[nodiscard]] phase_report report() const {
+      phase_report  out;
+      std::uint64_t passes = 0;
+      std::uint64_t delta  = 0;
+      for ( const auto &counters : per_thread ) {
+        for ( std::size_t ph = 0; ph < phase_count; ++ph ) {
+          out.phase_seconds[ph] += static_cast<double>( counters.elapsed_ns[ph] ) * 1e-9;
+        }
+        out.evaluations += counters.evaluations;
+        passes += counters.repair_passes;
+        delta += counters.delta_evaluations;
+      }
+
+      for ( double seconds : out.phase_seconds ) {
+        out.busy_seconds += seconds;
+      }
+      if ( out.busy_seconds > 0.0 ) {
+        for ( std::size_t ph = 0; ph < phase_count; ++ph ) {
+          out.phase_fraction[ph] = out.phase_seconds[ph] / out.busy_seconds;
+        }
+      }
+
+      out.engine_seconds = static_cast<double>( wall_ns ) * 1e-9;
+      if ( out.engine_seconds > 0.0 ) {
+        out.evaluations_per_second = static_cast<double>( out.evaluations ) / out.engine_seconds;
+        out.thread_utilization =
+          out.busy_seconds / ( out.engine_seconds * static_cast<double>( per_thread.size() ) );
+      }
+      if ( out.evaluations > 0 ) {
+        out.repair_passes_per_decode =
+          static_cast<double>( passes ) / static_cast<double>( out.evaluations );
+        out.delta_decode_fraction =
+          static_cast<double>( delta ) / static_cast<double>( out.evaluations );
+      }
+      return out;
+    }
+
+  private:
+    std::vector<thread_phase_counters> per_thread;
+    std::uint64_t                      wall_ns = 0;
+  };
+
+  /**
+   * @brief Cronômetro RAII: soma o tempo decorrido em `target` ao sair do escopo.
+   */
+  class scoped_timer {
+  public:
+    explicit scoped_timer( std::uint64_t &target ) noexcept
+      : target( target ), start( phase_stats::clock::now() ) {}
+
+    scoped_timer( const scoped_timer & )            = delete;
+    scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    ~scoped_timer() {
+      target += elapsed_ns();
+    }
+
+    [[nodiscard]] std::uint64_t elapsed_ns() const noexcept {
+      return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( phase_stats::clock::now() - start )
+          .count() );
+    }
+
+  private:
+    std::uint64_t                  &target;
+    phase_stats::clock::time_point start;
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+
+// Estruturas de resultado comuns aos executáveis (brkga_main, hho_main, ...)
+namespace r3dp::core {
+
+  struct convergence_point {
+    double elapsed_seconds{};
+    double fitness_value{};
+
+    friend void to_json( nlohmann::json &j, const convergence_point &p ) {
+      j = nlohmann::json{ { "elapsed_seconds", p.elapsed_seconds },
+                          { "fitness_value", p.fitness_value } };
+    }
+  };
+
+  struct graph_summary {
+    std::string   graph_name;
+    std::uint32_t vertex_count = 0;
+    std::uint64_t edge_count   = 0;
+    double        density      = 0.0;
+
+    static constexpr double compute_density( std::uint32_t n, std::uint64_t m ) noexcept {
+      if ( n < 2 ) {
+        return 0.0;
+      }
+      const long double num = 2.0L * static_cast<long double>( m );
+      const long double den = static_cast<long double>( n ) * static_cast<long double>( n - 1U );
+      return static_cast<double>( num / den );
+    }
+
+    friend void to_json( nlohmann::json &j, const graph_summary &g ) {
+      j = nlohmann::json{ { "graph_name", g.graph_name },
+                          { "vertex_count", g.vertex_count },
+                          { "edge_count", g.edge_count },
+                          { "density", g.density } };
+    }
+  };
+
+  inline graph_summary create_graph_summary( std::string name, std::uint32_t n, std::uint64_t m ) {
+    return graph_summary{ .graph_name   = std::move( name ),
+                          .vertex_count = n,
+                          .edge_count   = m,
+                          .density      = graph_summary::compute_density( n, m ) };
+  }
+
+}  // namespace r3dp::core
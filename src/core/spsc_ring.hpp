@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Fila circular sem trava entre exatamente uma thread produtora e uma consumidora.
+   *
+   * Os `capacity` itens são alocados uma vez e reaproveitados: `try_push` preenche o próximo slot
+   * livre no lugar (quem preenche atribui, o que reusa a memória de vetores já alocados) e
+   * `try_pop` entrega o slot mais antigo para leitura. Nenhuma das duas espera: com a fila cheia
+   * ou vazia elas devolvem false. Os índices ficam em linhas de cache separadas, e cada um só é
+   * escrito por um dos lados (acquire/release publicam o conteúdo do slot).
+   */
+  template <class T>
+  class spsc_ring {
+  public:
+    explicit spsc_ring( std::size_t capacity ) : slots( ( capacity > 0 ? capacity : 1 ) + 1 ) {}
+
+    spsc_ring( const spsc_ring & )            = delete;
+    spsc_ring &operator=( const spsc_ring & ) = delete;
+
+    // Produtor: fill( T & ) preenche o slot; false (sem chamar fill) se a fila estiver cheia
+    template <class Fill>
+    bool try_push( Fill &&fill ) {
+      const std::size_t t    = tail.load( std::memory_order_relaxed );
+      const std::size_t next = t + 1 == slots.size() ? 0 : t + 1;
+      if ( next == head.load( std::memory_order_acquire ) ) {
+        return false;
+      }
+      fill( slots[t] );
+      tail.store( next, std::memory_order_release );
+      return true;
+    }
+
+    // Consumidor: read( T & ) lê (ou move) o item mais antigo; false se a fila estiver vazia
+    template <class Read>
+    bool try_pop( Read &&read ) {
+      const std::size_t h = head.load( std::memory_order_relaxed );
+      if ( h == tail.load( std::memory_order_acquire ) ) {
+        return false;
+      }
+      read( slots[h] );
+      head.store( h + 1 == slots.size() ? 0 : h + 1, std::memory_order_release );
+      return true;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+      return slots.size() - 1;
+    }
+
+  private:
+    std::vector<T> slots;  // um slot fica sempre vazio para distinguir cheia de vazia
+
+    alignas( 64 ) std::atomic<std::size_t> head{ 0 };  // próximo a ler (só o consumidor escreve)
+    alignas( 64 ) std::atomic<std::size_t> tail{ 0 };  // próximo a escrever (só o produtor)
+  };
+
+}  // namespace r3dp::core
@@ -0,0 +1,505 @@
+#include "telemetry.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace r3dp::core {
+  namespace {
+    constexpr int         LISTEN_BACKLOG  = 16;
+    constexpr std::size_t MAX_REQUEST     = 4096;
+    constexpr int         REQUEST_TIMEOUT = 200;  // ms para o cliente mandar a requisição
+    constexpr int         REPLY_TIMEOUT   = 1000;  // ms para o cliente aceitar a resposta
+
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;  // cliente que fechou não derruba o processo
+#else
+    constexpr int SEND_FLAGS = 0;
+#endif
+
+    constexpr double NOT_AVAILABLE = std::numeric_limits<double>::quiet_NaN();
+
+    [[noreturn]] void fail( const std::string &what ) {
+      throw std::runtime_error( "telemetria: " + what + ": " + std::strerror( errno ) );
+    }
+
+    void set_timeout( int fd, int option, int milliseconds ) noexcept {
+      timeval tv{ milliseconds / 1000, ( milliseconds % 1000 ) * 1000 };
+      setsockopt( fd, SOL_SOCKET, option, &tv, sizeof( tv ) );
+    }
+
+    void close_fd( int &fd ) noexcept {
+      if ( fd >= 0 ) {
+        close( fd );
+        fd = -1;
+      }
+    }
+
+    // Socket Unix em escuta; um arquivo de socket abandonado por outra execução é substituído
+    int listen_unix( const std::string &path ) {
+      sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      if ( path.size() >= sizeof( address.sun_path ) ) {
+        throw std::runtime_error( "telemetria: caminho de socket longo demais: " + path );
+      }
+      std::memcpy( address.sun_path, path.c_str(), path.size() + 1 );
+
+      const int fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+      if ( fd < 0 ) {
+        fail( "socket" );
+      }
+      struct stat status{};
+      if ( lstat( path.c_str(), &status ) == 0 ) {
+        const bool live =
+          S_ISSOCK( status.st_mode ) &&
+          connect( fd, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) == 0;
+        if ( live || !S_ISSOCK( status.st_mode ) ) {
+          close( fd );
+          throw std::runtime_error( "telemetria: " + path + " já existe" +
+                                    ( live ? " e está em uso" : " e não é um socket" ) );
+        }
+        unlink( path.c_str() );
+      }
+      if ( bind( fd, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) != 0 ||
+           listen( fd, LISTEN_BACKLOG ) != 0 ) {
+        const int error = errno;
+        close( fd );
+        errno = error;
+        fail( "não foi possível escutar em " + path );
+      }
+      return fd;
+    }
+
+    int listen_http( unsigned port ) {
+      const int fd = socket( AF_INET, SOCK_STREAM, 0 );
+      if ( fd < 0 ) {
+        fail( "socket" );
+      }
+      const int reuse = 1;
+      setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+
+      sockaddr_in address{};
+      address.sin_family      = AF_INET;
+      address.sin_port        = htons( static_cast<std::uint16_t>( port ) );
+      address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+      if ( port > 65535 ||
+           bind( fd, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) != 0 ||
+           listen( fd, LISTEN_BACKLOG ) != 0 ) {
+        const int error = errno;
+        close( fd );
+        errno = error;
+        fail( "não foi possível escutar em 127.0.0.1:" + std::to_string( port ) );
+      }
+      return fd;
+    }
+
+    void send_all( int fd, std::string_view data ) noexcept {
+      while ( !data.empty() ) {
+        const ssize_t sent = send( fd, data.data(), data.size(), SEND_FLAGS );
+        if ( sent <= 0 ) {
+          return;
+        }
+        data.remove_prefix( std::size_t( sent ) );
+      }
+    }
+
+    // Valor no formato de texto do Prometheus (NaN e ±Inf são permitidos)
+    void append_value( std::string &out, double value ) {
+      if ( std::isnan( value ) ) {
+        out += "NaN";
+      } else if ( std::isinf( value ) ) {
+        out += value > 0 ? "+Inf" : "-Inf";
+      } else {
+        char buffer[32];
+        out.append( buffer, std::to_chars( buffer, buffer + sizeof( buffer ), value ).ptr );
+      }
+    }
+
+    std::string escape_label( std::string_view value ) {
+      std::string out;
+      for ( char c : value ) {
+        if ( c == '\\' || c == '"' ) {
+          out += '\\';
+          out += c;
+        } else if ( c == '\n' ) {
+          out += "\\n";
+        } else {
+          out += c;
+        }
+      }
+      return out;
+    }
+
+    double finite_or_nan( double value ) noexcept {
+      return std::isfinite( value ) ? value : NOT_AVAILABLE;
+    }
+  }  // namespace
+
+  struct telemetry::sample {
+    bool                running         = true;
+    unsigned            trial           = 0;
+    unsigned            trials          = 0;  // 0: nenhuma tentativa começou (grafo em leitura)
+    std::uint64_t       generation      = 0;
+    std::uint64_t       max_generations = 0;
+    double              best            = NOT_AVAILABLE;
+    double              run_best        = NOT_AVAILABLE;
+    std::uint64_t       evaluations     = 0;
+    double              evaluation_rate = 0.0;
+    double              uptime          = 0.0;
+    double              trial_elapsed   = NOT_AVAILABLE;
+    double              trial_eta       = NOT_AVAILABLE;
+    double              run_eta         = NOT_AVAILABLE;
+    std::vector<double> diversity;  // NaN: ilha ainda sem medida
+  };
+
+  telemetry::telemetry( telemetry_options options, unsigned islands )
+    : options( std::move( options ) ),
+      islands( std::max( islands, 1U ) ),
+      best( std::numeric_limits<double>::infinity() ),
+      run_best( std::numeric_limits<double>::infinity() ),
+      diversity( new std::atomic<double>[this->islands] ) {
+    static_assert( std::atomic<double>::is_always_lock_free );
+    for ( unsigned k = 0; k < this->islands; ++k ) {
+      diversity[k].store( NOT_AVAILABLE, std::memory_order_relaxed );
+    }
+
+    try {
+      if ( !this->options.socket_path.empty() ) {
+        socket_fd = listen_unix( this->options.socket_path );
+      }
+      if ( this->options.http_port > 0 ) {
+        http_fd = listen_http( this->options.http_port );
+      }
+      if ( pipe( wake ) != 0 ) {
+        fail( "pipe" );
+      }
+    } catch ( ... ) {
+      if ( socket_fd >= 0 ) {
+        unlink( this->options.socket_path.c_str() );
+      }
+      close_fd( socket_fd );
+      close_fd( http_fd );
+      throw;
+    }
+
+    rate_time = clock::now();
+    server    = std::thread( [this] { serve(); } );
+  }
+
+  telemetry::~telemetry() {
+    running.store( false, std::memory_order_relaxed );
+    const char byte = 0;
+    (void)!write( wake[1], &byte, 1 );
+    server.join();
+
+    if ( socket_fd >= 0 ) {
+      unlink( options.socket_path.c_str() );
+    }
+    close_fd( socket_fd );
+    close_fd( http_fd );
+    close_fd( wake[0] );
+    close_fd( wake[1] );
+    write_file();
+  }
+
+  void telemetry::begin_trial( unsigned          trial,
+                               unsigned          trials,
+                               clock::time_point deadline,
+                               std::uint64_t     max_generations ) noexcept {
+    evaluations_before = evaluations.load( std::memory_order_relaxed );
+    generation.store( 0, std::memory_order_relaxed );
+    best.store( std::numeric_limits<double>::infinity(), std::memory_order_relaxed );
+    for ( unsigned k = 0; k < islands; ++k ) {
+      diversity[k].store( NOT_AVAILABLE, std::memory_order_relaxed );
+    }
+    this->max_generations.store( max_generations, std::memory_order_relaxed );
+    trial_start.store( clock::now().time_since_epoch().count(), std::memory_order_relaxed );
+    trial_deadline.store( deadline.time_since_epoch().count(), std::memory_order_relaxed );
+    this->trial.store( trial, std::memory_order_relaxed );
+    this->trials.store( trials, std::memory_order_relaxed );
+  }
+
+  telemetry::sample telemetry::take_sample() const {
+    const auto now = clock::now();
+    sample     s;
+    s.running         = running.load( std::memory_order_relaxed );
+    s.trial           = trial.load( std::memory_order_relaxed );
+    s.trials          = trials.load( std::memory_order_relaxed );
+    s.generation      = generation.load( std::memory_order_relaxed );
+    s.max_generations = max_generations.load( std::memory_order_relaxed );
+    s.best            = finite_or_nan( best.load( std::memory_order_relaxed ) );
+    s.run_best        = finite_or_nan( run_best.load( std::memory_order_relaxed ) );
+    s.evaluations     = evaluations.load( std::memory_order_relaxed );
+    s.evaluation_rate = evaluation_rate.load( std::memory_order_relaxed );
+    s.uptime          = std::chrono::duration<double>( now - started ).count();
+    for ( unsigned k = 0; k < islands; ++k ) {
+      s.diversity.push_back( diversity[k].load( std::memory_order_relaxed ) );
+    }
+    if ( !s.running ) {
+      s.trial_eta = s.run_eta = 0.0;
+      return s;
+    }
+    if ( s.trials == 0 ) {
+      return s;
+    }
+
+    // Término da tentativa: o mais cedo entre o prazo e o ritmo de gerações até o limite delas
+    const clock::duration since_epoch( trial_start.load( std::memory_order_relaxed ) );
+    const clock::duration until_deadline( trial_deadline.load( std::memory_order_relaxed ) );
+    const clock::time_point start( since_epoch );
+    const clock::time_point deadline( until_deadline );
+    s.trial_elapsed = std::chrono::duration<double>( now - start ).count();
+    double eta      = std::numeric_limits<double>::infinity();
+    if ( deadline != clock::time_point::max() ) {
+      eta = std::max( 0.0, std::chrono::duration<double>( deadline - now ).count() );
+    }
+    if ( s.max_generations > 0 && s.generation > 0 ) {
+      const double left = double( s.max_generations - std::min( s.generation, s.max_generations ) );
+      eta               = std::min( eta, left * s.trial_elapsed / double( s.generation ) );
+    }
+    if ( std::isfinite( eta ) ) {
+      // As tentativas seguintes devem durar o mesmo que a atual
+      const unsigned after = s.trials - std::min( s.trial + 1, s.trials );
+      s.trial_eta          = eta;
+      s.run_eta            = eta + after * ( s.trial_elapsed + eta );
+    }
+    return s;
+  }
+
+  std::string telemetry::prometheus_text() const {
+    const sample      s     = take_sample();
+    const std::string label = "run=\"" + escape_label( options.run ) + "\"";
+    std::string       out;
+
+    const auto header = [&]( const char *name, const char *type, const char *help ) {
+      out += "# HELP ";
+      out += name;
+      out += ' ';
+      out += help;
+      out += "\n# TYPE ";
+      out += name;
+      out += ' ';
+      out += type;
+      out += '\n';
+    };
+    const auto line = [&]( const char *name, const std::string &labels, double value ) {
+      out += name;
+      out += '{';
+      out += labels;
+      out += "} ";
+      append_value( out, value );
+      out += '\n';
+    };
+    const auto metric = [&]( const char *name, const char *type, const char *help, double value ) {
+      header( name, type, help );
+      line( name, label, value );
+    };
+
+    metric( "r3dp_running", "gauge", "1 enquanto a execução roda, 0 depois", s.running );
+    metric( "r3dp_uptime_seconds", "gauge", "Segundos desde o início da execução", s.uptime );
+    metric( "r3dp_trial", "gauge", "Tentativa atual (a partir de 0)", s.trial );
+    metric( "r3dp_trials", "gauge", "Tentativas da execução (0 antes da primeira)", s.trials );
+    metric( "r3dp_generation", "gauge", "Geração da tentativa atual", double( s.generation ) );
+    metric( "r3dp_best_fitness",
+            "gauge",
+            "Melhor fitness da tentativa atual (NaN antes da primeira geração)",
+            s.best );
+    metric( "r3dp_run_best_fitness", "gauge", "Melhor fitness entre as tentativas", s.run_best );
+    metric( "r3dp_evaluations_total",
+            "counter",
+            "Decodificações somadas nas tentativas",
+            double( s.evaluations ) );
+    metric( "r3dp_evaluations_per_second",
+            "gauge",
+            "Decodificações por segundo no último intervalo",
+            s.evaluation_rate );
+    metric( "r3dp_trial_elapsed_seconds", "gauge", "Segundos na tentativa atual", s.trial_elapsed );
+    metric( "r3dp_trial_eta_seconds",
+            "gauge",
+            "Estimativa de segundos até o fim da tentativa atual",
+            s.trial_eta );
+    metric( "r3dp_run_eta_seconds",
+            "gauge",
+            "Estimativa de segundos até o fim da execução",
+            s.run_eta );
+
+    bool any_diversity = false;
+    for ( unsigned k = 0; k < s.diversity.size(); ++k ) {
+      if ( std::isnan( s.diversity[k] ) ) {
+        continue;
+      }
+      if ( !any_diversity ) {
+        header( "r3dp_island_diversity", "gauge", "Diversidade de rótulos da ilha em [0,1]" );
+        any_diversity = true;
+      }
+      line( "r3dp_island_diversity",
+            label + ",island=\"" + std::to_string( k ) + "\"",
+            s.diversity[k] );
+    }
+    return out;
+  }
+
+  std::string telemetry::json_text() const {
+    const sample   s = take_sample();
+    nlohmann::json islands_json = nlohmann::json::array();
+    for ( double d : s.diversity ) {
+      islands_json.push_back( std::isnan( d ) ? nlohmann::json() : nlohmann::json( d ) );
+    }
+    // nlohmann grava NaN como null
+    const nlohmann::json j{ { "run", options.run },
+                            { "uptime_seconds", s.uptime },
+                            { "trial", s.trial },
+                            { "trials", s.trials },
+                            { "generation", s.generation },
+                            { "best_fitness", s.best },
+                            { "run_best_fitness", s.run_best },
+                            { "evaluations", s.evaluations },
+                            { "evaluations_per_second", s.evaluation_rate },
+                            { "trial_elapsed_seconds", s.trial_elapsed },
+                            { "trial_eta_seconds", s.trial_eta },
+                            { "run_eta_seconds", s.run_eta },
+                            { "island_diversity", islands_json } };
+    return j.dump() + "\n";
+  }
+
+  void telemetry::take_rate_sample() {
+    const auto          now     = clock::now();
+    const std::uint64_t current = evaluations.load( std::memory_order_relaxed );
+    const double        seconds = std::chrono::duration<double>( now - rate_time ).count();
+    if ( seconds > 0.0 ) {
+      evaluation_rate.store( double( current - std::min( rate_evaluations, current ) ) / seconds,
+                             std::memory_order_relaxed );
+    }
+    rate_evaluations = current;
+    rate_time        = now;
+  }
+
+  void telemetry::serve() {
+    std::vector<pollfd> fds{ { wake[0], POLLIN, 0 } };
+    for ( int fd : { socket_fd, http_fd } ) {
+      if ( fd >= 0 ) {
+        fds.push_back( { fd, POLLIN, 0 } );
+      }
+    }
+
+    const auto interval = std::max( options.interval, std::chrono::milliseconds( 1 ) );
+    auto       next     = clock::now() + interval;
+    write_file();
+    while ( running.load( std::memory_order_relaxed ) ) {
+      const auto left    = std::chrono::ceil<std::chrono::milliseconds>( next - clock::now() );
+      const int  timeout = int( std::max<long long>( left.count(), 0 ) );
+      const int  ready   = poll( fds.data(), fds.size(), timeout );
+      if ( ready < 0 && errno != EINTR ) {
+        return;
+      }
+      if ( ready > 0 ) {
+        if ( fds[0].revents != 0 ) {
+          return;
+        }
+        for ( std::size_t i = 1; i < fds.size(); ++i ) {
+          if ( fds[i].revents & POLLIN ) {
+            const int client = accept( fds[i].fd, nullptr, nullptr );
+            if ( client >= 0 ) {
+              answer( client );
+              close( client );
+            }
+          }
+        }
+      }
+
+      const auto now = clock::now();
+      if ( now >= next ) {
+        take_rate_sample();
+        refresh.store( true, std::memory_order_relaxed );
+        write_file();
+        next = std::max( next + interval, now );
+      }
+    }
+  }
+
+  void telemetry::answer( int client ) const {
+    set_timeout( client, SO_RCVTIMEO, REQUEST_TIMEOUT );
+    set_timeout( client, SO_SNDTIMEO, REPLY_TIMEOUT );
+
+    // Cabeçalho da requisição até a linha em branco; um cliente mudo recebe o texto puro
+    std::string request;
+    char        buffer[512];
+    while ( request.size() < MAX_REQUEST && request.find( "\r\n\r\n" ) == std::string::npos &&
+            request.find( "\n\n" ) == std::string::npos ) {
+      const ssize_t got = recv( client, buffer, sizeof( buffer ), 0 );
+      if ( got <= 0 ) {
+        break;
+      }
+      request.append( buffer, std::size_t( got ) );
+    }
+
+    const bool head = request.starts_with( "HEAD " );
+    if ( !head && !request.starts_with( "GET " ) ) {
+      send_all( client, prometheus_text() );
+      return;
+    }
+    const std::size_t from = request.find( ' ' ) + 1;
+    std::string_view  path( request.data() + from,
+                           std::min( request.find_first_of( " ?\r\n", from ), request.size() ) -
+                             from );
+
+    std::string status = "200 OK";
+    std::string type;
+    std::string body;
+    if ( path == "/metrics" ) {
+      type = "text/plain; version=0.0.4; charset=utf-8";
+      body = prometheus_text();
+    } else if ( path == "/" || path == "/status" ) {
+      type = "application/json";
+      body = json_text();
+    } else {
+      status = "404 Not Found";
+      type   = "text/plain; charset=utf-8";
+      body   = "use /metrics ou /status\n";
+    }
+    std::string reply = "HTTP/1.0 " + status + "\r\nContent-Type: " + type +
+                        "\r\nContent-Length: " + std::to_string( body.size() ) +
+                        "\r\nConnection: close\r\n\r\n";
+    if ( !head ) {
+      reply += body;
+    }
+    send_all( client, reply );
+  }
+
+  void telemetry::write_file() const {
+    if ( options.file_path.empty() ) {
+      return;
+    }
+    const std::string text = prometheus_text();
+
+    // Quem lê o arquivo nunca vê uma gravação pela metade
+    const std::string temporary = options.file_path + ".tmp";
+    {
+      std::ofstream out( temporary, std::ios::binary | std::ios::trunc );
+      out << text;
+      if ( !out.flush() ) {
+        return;
+      }
+    }
+    std::error_code error;
+    std::filesystem::rename( temporary, options.file_path, error );
+  }
+
+}  // namespace r3dp::core
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace r3dp::core {
+
+  struct telemetry_options {
+    std::string               socket_path;          // socket Unix com HTTP (vazio: desligado)
+    unsigned                  http_port = 0;        // HTTP em 127.0.0.1 (0: desligado)
+    std::string               file_path;            // texto do Prometheus (vazio: desligado)
+    std::chrono::milliseconds interval{ 5000 };     // período do arquivo e das amostras de taxa
+    std::string               run;                  // valor do rótulo run="..." das métricas
+
+    [[nodiscard]] bool enabled() const noexcept {
+      return !socket_path.empty() || http_port > 0 || !file_path.empty();
+    }
+  };
+
+  /**
+   * @brief Estado de uma execução longa visto de fora: melhor fitness, geração, avaliações por
+   * segundo, diversidade por ilha e tempo restante estimado.
+   *
+   * O motor publica com stores relaxados em atômicos, sem trava nem alocação: `publish` a cada
+   * geração, e as medidas caras (avaliações e diversidade) só quando `refresh_due()` diz que a
+   * thread de telemetria tirou uma amostra desde a última vez, ou seja, uma vez por intervalo. Os
+   * campos são lidos um a um, então uma resposta pode misturar gerações vizinhas.
+   *
+   * A thread própria atende conexões no socket Unix e/ou na porta HTTP local (GET /metrics devolve
+   * o formato de texto do Prometheus, GET / um JSON; um cliente que não fala HTTP recebe o texto
+   * do Prometheus sem cabeçalhos) e a cada intervalo reescreve o arquivo por rename atômico, como
+   * espera o coletor textfile do node_exporter. O construtor lança std::runtime_error se não
+   * conseguir abrir os sockets; falhas ao gravar o arquivo só adiam a gravação para o próximo
+   * intervalo. O destrutor grava o arquivo uma última vez (com r3dp_running 0) e remove o socket.
+   */
+  class telemetry {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    telemetry( telemetry_options options, unsigned islands );
+    ~telemetry();
+
+    telemetry( const telemetry & )            = delete;
+    telemetry &operator=( const telemetry & ) = delete;
+
+    // Thread do motor. Nova tentativa de `trials`; max_generations = 0 se só o prazo limita
+    void begin_trial( unsigned          trial,
+                      unsigned          trials,
+                      clock::time_point deadline,
+                      std::uint64_t     max_generations ) noexcept;
+
+    void publish( std::uint64_t generation, double best_fitness ) noexcept {
+      this->generation.store( generation, std::memory_order_relaxed );
+      this->best.store( best_fitness, std::memory_order_relaxed );
+      if ( best_fitness < run_best.load( std::memory_order_relaxed ) ) {
+        run_best.store( best_fitness, std::memory_order_relaxed );  // só o motor escreve
+      }
+    }
+
+    // true uma vez por amostra da thread de telemetria: hora de publicar as medidas caras
+    [[nodiscard]] bool refresh_due() noexcept {
+      return refresh.load( std::memory_order_relaxed ) &&
+             refresh.exchange( false, std::memory_order_relaxed );
+    }
+
+    // Avaliações da tentativa atual (as das anteriores são somadas aqui)
+    void publish_evaluations( std::uint64_t evaluations ) noexcept {
+      this->evaluations.store( evaluations_before + evaluations, std::memory_order_relaxed );
+    }
+
+    void publish_diversity( unsigned island, double diversity ) noexcept {
+      if ( island < islands ) {
+        this->diversity[island].store( diversity, std::memory_order_relaxed );
+      }
+    }
+
+    // Qualquer thread
+    [[nodiscard]] std::string prometheus_text() const;
+    [[nodiscard]] std::string json_text() const;
+
+  private:
+    // Instantâneo dos atômicos com as grandezas derivadas (taxa e estimativas de término)
+    struct sample;
+
+    [[nodiscard]] sample take_sample() const;
+    void                 serve();
+    void                 take_rate_sample();
+    void                 answer( int client ) const;
+    void                 write_file() const;
+
+    const telemetry_options options;
+    const unsigned          islands;
+
+    // Escritos só pelo motor
+    std::atomic<unsigned>                  trial{ 0 };
+    std::atomic<unsigned>                  trials{ 0 };
+    std::atomic<clock::rep>                trial_start{ 0 };
+    std::atomic<clock::rep>                trial_deadline{ 0 };
+    std::atomic<std::uint64_t>             max_generations{ 0 };
+    std::atomic<std::uint64_t>             generation{ 0 };
+    std::atomic<double>                    best;
+    std::atomic<double>                    run_best;
+    std::atomic<std::uint64_t>             evaluations{ 0 };
+    std::unique_ptr<std::atomic<double>[]> diversity;
+    std::uint64_t                          evaluations_before = 0;
+
+    // Escritos só pela thread de telemetria
+    std::atomic<double> evaluation_rate{ 0.0 };
+    std::uint64_t       rate_evaluations = 0;
+    clock::time_point   rate_time;
+
+    std::atomic<bool>       refresh{ true };
+    std::atomic<bool>       running{ true };
+    const clock::time_point started = clock::now();
+
+    int         socket_fd = -1;
+    int         http_fd   = -1;
+    int         wake[2]   = { -1, -1 };  // pipe que acorda a thread no destrutor
+    std::thread server;
+  };
+
+}  // namespace r3dp::core
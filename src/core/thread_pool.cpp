@@ -0,0 +1,252 @@
+#include "thread_pool.hpp"
+
+#include <iterator>
+#include <stdexcept>
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+namespace r3dp::core {
+  namespace {
+    // Pool e slot da thread atual (workers de pools diferentes não se confundem)
+    thread_local const thread_pool *current_pool = nullptr;
+    thread_local unsigned           current_slot = 0;
+
+    constexpr int SPINS_BEFORE_SLEEP = 64;
+  }  // namespace
+
+  thread_pool::thread_pool( unsigned              threads,
+                            std::vector<unsigned> cpus,
+                            std::vector<unsigned> domains ) {
+    const unsigned participants = threads == 0 ? 1 : threads;
+    if ( domains.empty() ) {
+      domains.assign( participants, 0 );
+    }
+    if ( domains.size() != participants ) {
+      throw std::invalid_argument( "thread_pool: um domínio por slot" );
+    }
+    slot_domain = std::move( domains );
+    domain_slots.resize( *std::max_element( slot_domain.begin(), slot_domain.end() ) + 1 );
+    for ( unsigned s = 0; s < participants; ++s ) {
+      domain_slots[slot_domain[s]].push_back( s );
+    }
+    for ( const auto &slots : domain_slots ) {
+      if ( slots.empty() ) {
+        throw std::invalid_argument( "thread_pool: domínio sem slots" );
+      }
+    }
+
+    queues.reserve( participants );
+    for ( unsigned s = 0; s < participants; ++s ) {
+      queues.push_back( std::make_unique<task_queue>() );
+    }
+
+    workers.reserve( participants - 1 );
+    for ( unsigned s = 1; s < participants; ++s ) {
+      const int cpu = cpus.empty() ? -1 : static_cast<int>( cpus[s % cpus.size()] );
+      workers.emplace_back( [this, s, cpu] { worker_loop( s, cpu ); } );
+    }
+  }
+
+  thread_pool::~thread_pool() {
+    {
+      std::lock_guard lock( signal_mutex );
+      stopping = true;
+    }
+    signal.notify_all();
+    for ( auto &worker : workers ) {
+      worker.join();
+    }
+  }
+
+  unsigned thread_pool::slot() const noexcept {
+    return current_pool == this ? current_slot : 0;
+  }
+
+  std::size_t thread_pool::domain_position( unsigned slot ) const noexcept {
+    const auto &slots = domain_slots[slot_domain[slot]];
+    return static_cast<std::size_t>( std::lower_bound( slots.begin(), slots.end(), slot ) -
+                                     slots.begin() );
+  }
+
+  std::vector<unsigned> thread_pool::allowed_cpus() {
+    std::vector<unsigned> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    if ( sched_getaffinity( 0, sizeof( set ), &set ) == 0 ) {
+      for ( unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+        if ( CPU_ISSET( cpu, &set ) ) {
+          cpus.push_back( cpu );
+        }
+      }
+    }
+#endif
+    if ( cpus.empty() ) {
+      const unsigned hw = std::max( 1U, std::thread::hardware_concurrency() );
+      for ( unsigned cpu = 0; cpu < hw; ++cpu ) {
+        cpus.push_back( cpu );
+      }
+    }
+    return cpus;
+  }
+
+  void thread_pool::pin_current_thread( unsigned cpu ) noexcept {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu, &set );
+    pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );  // falha não é fatal
+#else
+    (void)cpu;
+#endif
+  }
+
+  void thread_pool::push( unsigned slot, const task &t ) {
+    auto &queue = *queues[slot];
+    t.owner->queued.fetch_add( 1, std::memory_order_release );  // antes de ficar visível na fila
+    {
+      std::lock_guard lock( queue.mutex );
+      queue.tasks.push_back( t );
+    }
+    queued.fetch_add( 1, std::memory_order_release );
+  }
+
+  void thread_pool::notify() {
+    // Passar pelo mutex impede que um worker perca o aviso entre testar 'queued' e dormir
+    { std::lock_guard lock( signal_mutex ); }
+    signal.notify_all();
+  }
+
+  bool thread_pool::take( task_queue &queue, bool from_back, task &out, group *only ) {
+    std::lock_guard lock( queue.mutex );
+    auto           &tasks = queue.tasks;
+    if ( tasks.empty() ) {
+      return false;
+    }
+    if ( only == nullptr ) {
+      if ( from_back ) {
+        out = tasks.back();
+        tasks.pop_back();
+      } else {
+        out = tasks.front();
+        tasks.pop_front();
+      }
+    } else {
+      // Filas curtas (poucas tarefas por participante): a busca linear é barata
+      const auto mine = [only]( const task &t ) { return t.owner == only; };
+      auto       it   = tasks.end();
+      if ( from_back ) {
+        const auto found = std::find_if( tasks.rbegin(), tasks.rend(), mine );
+        if ( found != tasks.rend() ) {
+          it = std::prev( found.base() );
+        }
+      } else {
+        it = std::find_if( tasks.begin(), tasks.end(), mine );
+      }
+      if ( it == tasks.end() ) {
+        return false;
+      }
+      out = *it;
+      tasks.erase( it );
+    }
+    out.owner->queued.fetch_sub( 1, std::memory_order_relaxed );
+    queued.fetch_sub( 1, std::memory_order_relaxed );
+    return true;
+  }
+
+  bool thread_pool::pop_or_steal( unsigned slot, task &out, group *only ) {
+    const auto &left = only == nullptr ? queued : only->queued;
+    if ( left.load( std::memory_order_acquire ) == 0 ) {
+      return false;
+    }
+
+    // Primeiro a própria fila (pelo fim), depois as dos outros (pelo início), começando pelas
+    // do mesmo domínio:
+    if ( take( *queues[slot], true, out, only ) ) {
+      return true;
+    }
+    const unsigned home = slot_domain[slot];
+    for ( const bool same_domain : { true, false } ) {
+      if ( !same_domain && domain_slots.size() == 1 ) {
+        break;
+      }
+      for ( std::size_t k = 1; k < queues.size(); ++k ) {
+        const std::size_t v = ( slot + k ) % queues.size();
+        if ( ( slot_domain[v] == home ) != same_domain ) {
+          continue;
+        }
+        if ( take( *queues[v], false, out, only ) ) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void thread_pool::execute( const task &t ) {
+    t.run( t.context, t.begin, t.end );
+    if ( t.owner->pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+      // Depois do decremento 't.owner' pode já ter sido destruído; só o pool é tocado aqui
+      notify();
+    }
+  }
+
+  void thread_pool::wait_for( group &g, unsigned slot ) {
+    // Só ajuda com tarefas do próprio grupo: uma tarefa alheia poderia durar muito mais que ele
+    int  idle = 0;
+    task t;
+    while ( g.pending.load( std::memory_order_acquire ) != 0 ) {
+      if ( pop_or_steal( slot, t, &g ) ) {
+        execute( t );
+        idle = 0;
+        continue;
+      }
+      if ( ++idle < SPINS_BEFORE_SLEEP ) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock lock( signal_mutex );
+      signal.wait( lock, [&] {
+        return g.pending.load( std::memory_order_acquire ) == 0 ||
+               g.queued.load( std::memory_order_acquire ) > 0;
+      } );
+      idle = 0;
+    }
+  }
+
+  void thread_pool::worker_loop( unsigned slot, int cpu ) {
+    current_pool = this;
+    current_slot = slot;
+
+    if ( cpu >= 0 ) {
+      pin_current_thread( static_cast<unsigned>( cpu ) );
+    }
+
+    int  idle = 0;
+    task t;
+    while ( true ) {
+      if ( pop_or_steal( slot, t ) ) {
+        execute( t );
+        idle = 0;
+        continue;
+      }
+      if ( ++idle < SPINS_BEFORE_SLEEP ) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock lock( signal_mutex );
+      signal.wait(
+        lock, [&] { return stopping || queued.load( std::memory_order_acquire ) > 0; } );
+      if ( stopping && queued.load( std::memory_order_acquire ) == 0 ) {
+        return;
+      }
+      idle = 0;
+    }
+  }
+
+}  // namespace r3dp::core
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace r3dp::core {
+
+  /**
+   * @brief Pool persistente de threads com filas de roubo de trabalho (work stealing).
+   *
+   * O pool tem `size()` participantes: a thread que chama `parallel_for` (slot 0 para threads de
+   * fora do pool) e `size() - 1` workers criados uma única vez, opcionalmente fixados em CPUs.
+   * Cada participante tem sua fila; o dono retira do fim (LIFO, dados quentes em cache) e os
+   * ladrões do início. Quem espera o fim de um `parallel_for` executa tarefas do mesmo
+   * `parallel_for` enquanto espera, o que permite chamadas aninhadas (ex.: ilhas em paralelo, cada
+   * uma decodificando em paralelo). Tarefas de outros grupos ficam para os workers ociosos: uma
+   * delas pode ser longa (ex.: uma ilha inteira) e prenderia quem espera muito além do seu grupo.
+   *
+   * Os slots podem ser agrupados em domínios (ex.: nós NUMA, ver core::numa_placement): um
+   * `parallel_for` distribui as tarefas só entre os slots do domínio de quem chama,
+   * `parallel_for_placed` escolhe o domínio de cada tarefa, e quem fica sem trabalho rouba primeiro
+   * do próprio domínio e só depois dos outros. Sem domínios, todos os slots formam um só.
+   *
+   * Não depende de OpenMP.
+   */
+  class thread_pool {
+  public:
+    /**
+     * @param threads número de participantes, contando a thread chamadora (>= 1).
+     * @param cpus CPUs onde fixar os workers (o worker w usa cpus[w % cpus.size()]); vazio não
+     * fixa nenhum.
+     * @param domains domínio de cada slot (0..D-1, todos com algum slot), com `threads` entradas;
+     * vazio põe todos no domínio 0. std::invalid_argument se inconsistente.
+     */
+    explicit thread_pool( unsigned              threads,
+                          std::vector<unsigned> cpus    = {},
+                          std::vector<unsigned> domains = {} );
+    ~thread_pool();
+
+    thread_pool( const thread_pool & )            = delete;
+    thread_pool &operator=( const thread_pool & ) = delete;
+
+    [[nodiscard]] unsigned size() const noexcept {
+      return static_cast<unsigned>( queues.size() );
+    }
+
+    /// @brief Slot da thread chamadora neste pool: 1..size()-1 para workers, 0 para as demais.
+    [[nodiscard]] unsigned slot() const noexcept;
+
+    [[nodiscard]] unsigned domain_count() const noexcept {
+      return static_cast<unsigned>( domain_slots.size() );
+    }
+
+    /// @brief CPUs em que o processo pode executar (sched_getaffinity), em ordem crescente.
+    static std::vector<unsigned> allowed_cpus();
+
+    /// @brief Fixa a thread chamadora em `cpu` (ex.: o slot 0 de um pool com CPUs próprias).
+    static void pin_current_thread( unsigned cpu ) noexcept;
+
+    /**
+     * @brief Executa body(i) para todo i em [first, last) e retorna quando todos terminarem.
+     * @param grain índices por tarefa (0 escolhe automaticamente ~8 tarefas por participante).
+     *
+     * A primeira exceção lançada por body é relançada na thread chamadora.
+     */
+    template <class Body>
+    void parallel_for( std::size_t first, std::size_t last, Body &&body, std::size_t grain = 0 );
+
+    /**
+     * @brief Executa body(i) para todo i em [0, domain_of.size()), uma tarefa por índice, na fila
+     * de um slot do domínio domain_of[i] (em rodízio dentro do domínio). Sem domínios equivale a
+     * parallel_for( 0, domain_of.size(), body, 1 ).
+     */
+    template <class Body>
+    void parallel_for_placed( const std::vector<unsigned> &domain_of, Body &&body );
+
+  private:
+    // Tarefas de um mesmo parallel_for
+    struct group {
+      std::atomic<std::size_t> pending{ 0 };  // ainda não terminadas
+      std::atomic<std::size_t> queued{ 0 };   // ainda nas filas
+    };
+
+    struct task {
+      void ( *run )( void *, std::size_t, std::size_t ) = nullptr;
+      void       *context                                = nullptr;
+      std::size_t begin                                  = 0;
+      std::size_t end                                    = 0;
+      group      *owner                                  = nullptr;
+    };
+
+    struct alignas( 64 ) task_queue {
+      std::mutex       mutex;
+      std::deque<task> tasks;
+    };
+
+    std::vector<std::unique_ptr<task_queue>> queues;  // uma por slot
+    std::vector<std::thread>                 workers;
+    std::vector<unsigned>                    slot_domain;   // domínio de cada slot
+    std::vector<std::vector<unsigned>>       domain_slots;  // slots de cada domínio, crescentes
+
+    std::mutex                 signal_mutex;
+    std::condition_variable    signal;  // novas tarefas ou fim de um grupo
+    std::atomic<std::size_t>   queued{ 0 };
+    bool                       stopping = false;
+
+    void push( unsigned slot, const task &t );
+    void notify();
+    // only != nullptr: só tarefas desse grupo
+    bool pop_or_steal( unsigned slot, task &out, group *only = nullptr );
+    bool take( task_queue &queue, bool from_back, task &out, group *only );
+    void execute( const task &t );
+    void wait_for( group &g, unsigned slot );
+    void worker_loop( unsigned slot, int cpu );
+
+    // Posição de `slot` entre os slots do seu domínio
+    [[nodiscard]] std::size_t domain_position( unsigned slot ) const noexcept;
+
+    // Divide [first, last) em tarefas de `grain` índices; a tarefa c vai para a fila place(c)
+    template <class Body, class Place>
+    void run_group( std::size_t first,
+                    std::size_t last,
+                    Body       &body,
+                    std::size_t grain,
+                    Place       place );
+  };
+
+  template <class Body>
+  void thread_pool::parallel_for( std::size_t first, std::size_t last, Body &&body, std::size_t grain ) {
+    if ( first >= last ) {
+      return;
+    }
+
+    const std::size_t count = last - first;
+    if ( grain == 0 ) {
+      grain = std::max<std::size_t>( 1, count / ( std::size_t{ size() } * 8 ) );
+    }
+    if ( size() == 1 || count <= grain ) {
+      for ( std::size_t i = first; i < last; ++i ) {
+        body( i );
+      }
+      return;
+    }
+
+    // Distribui as tarefas em rodízio pelo domínio, a partir da fila da própria thread:
+    const unsigned    self   = slot();
+    const auto       &mine   = domain_slots[slot_domain[self]];
+    const std::size_t offset = domain_position( self );
+    run_group( first, last, body, grain, [&]( std::size_t c ) {
+      return mine[( offset + c ) % mine.size()];
+    } );
+  }
+
+  template <class Body>
+  void thread_pool::parallel_for_placed( const std::vector<unsigned> &domain_of, Body &&body ) {
+    if ( size() == 1 || domain_of.size() <= 1 ) {
+      for ( std::size_t i = 0; i < domain_of.size(); ++i ) {
+        body( i );
+      }
+      return;
+    }
+
+    // Rodízio por domínio; no domínio de quem chama ele começa pela fila da própria thread
+    const unsigned           self = slot();
+    std::vector<std::size_t> next( domain_slots.size(), 0 );
+    next[slot_domain[self]] = domain_position( self );
+    run_group( 0, domain_of.size(), body, 1, [&]( std::size_t c ) {
+      const std::size_t d     = domain_of[c] % domain_slots.size();
+      const auto       &slots = domain_slots[d];
+      return slots[next[d]++ % slots.size()];
+    } );
+  }
+
+  template <class Body, class Place>
+  void thread_pool::run_group( std::size_t first,
+                               std::size_t last,
+                               Body       &body,
+                               std::size_t grain,
+                               Place       place ) {
+    struct group_context {
+      Body              &body;
+      std::exception_ptr error;
+      std::atomic<bool>  failed{ false };
+    } context{ body, nullptr };
+
+    auto run = []( void *raw, std::size_t begin, std::size_t end ) {
+      auto &ctx = *static_cast<group_context *>( raw );
+      if ( ctx.failed.load( std::memory_order_relaxed ) ) {
+        return;
+      }
+      try {
+        for ( std::size_t i = begin; i < end; ++i ) {
+          ctx.body( i );
+        }
+      } catch ( ... ) {
+        if ( !ctx.failed.exchange( true ) ) {
+          ctx.error = std::current_exception();
+        }
+      }
+    };
+
+    const std::size_t chunks = ( last - first + grain - 1 ) / grain;
+    group             tasks;
+    tasks.pending.store( chunks, std::memory_order_relaxed );
+    for ( std::size_t c = 0; c < chunks; ++c ) {
+      const std::size_t begin = first + c * grain;
+      push( place( c ), task{ run, &context, begin, std::min( last, begin + grain ), &tasks } );
+    }
+    notify();
+
+    wait_for( tasks, slot() );
+    if ( context.error ) {
+      std::rethrow_exception( context.error );
+    }
+  }
+
+}  // namespace r3dp::core
@@ -0,0 +1,181 @@
+#define DEBUG
+#include "CLI/CLI.hpp"
+#include "core/compressed_graph.hpp"
+#include "core/csr_graph.hpp"
+#include "core/graph.hpp"
+#include "core/log.hpp"
+#include "core/memory_usage.hpp"
+#include "meta/brkga/brkga_decoder.hpp"
+#include "meta/brkga/mt_rand.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+/*
+ * Compara as representações do grafo usadas pela busca: memória de cada uma, vazão da varredura
+ * de vizinhos e decodificações R3DP por segundo sobre os mesmos cromossomos aleatórios. O CSR é
+ * medido primeiro e descartado depois da compressão, então cada RSS reflete uma representação.
+ */
+
+constexpr unsigned DEFAULT_CHROMOSOMES = 32;
+constexpr unsigned DEFAULT_SWEEPS      = 5;
+constexpr uint32_t DEFAULT_RNG_SEED    = 1;
+
+struct representation_result {
+  std::string name;
+  std::size_t graph_bytes{};
+  std::size_t rss_bytes{};  // RSS do processo (grafo + cromossomos) com só esta representação
+  double      build_seconds{};
+  double      sweep_edges_per_second{};
+  double      decodes_per_second{};
+  double      fitness_sum{};
+
+  friend void to_json( nlohmann::json &j, const representation_result &r ) {
+    j = nlohmann::json{ { "name", r.name },
+                        { "graph_bytes", r.graph_bytes },
+                        { "rss_bytes", r.rss_bytes },
+                        { "build_seconds", r.build_seconds },
+                        { "sweep_edges_per_second", r.sweep_edges_per_second },
+                        { "decodes_per_second", r.decodes_per_second },
+                        { "fitness_sum", r.fitness_sum } };
+  }
+};
+
+static double seconds_since( std::chrono::steady_clock::time_point start ) {
+  return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Soma dos ids de todos os vizinhos: mede só o custo de percorrer (e decodificar) as listas
+template <class Graph>
+static double sweep_edges_per_second( const Graph &graph, unsigned sweeps ) {
+  const auto    n        = r3dp::core::vertex_count( graph );
+  std::uint64_t checksum = 0;
+  std::uint64_t visited  = 0;
+  const auto    start    = std::chrono::steady_clock::now();
+  for ( unsigned s = 0; s < sweeps; ++s ) {
+    for ( std::size_t v = 0; v < n; ++v ) {
+      for ( auto u : r3dp::core::neighbors( graph, static_cast<r3dp::core::vertex_t>( v ) ) ) {
+        checksum += u;
+        ++visited;
+      }
+    }
+  }
+  const double elapsed = seconds_since( start );
+  LOG_VAR( checksum );
+  return elapsed > 0.0 ? static_cast<double>( visited ) / elapsed : 0.0;
+}
+
+template <class Graph>
+static void measure_decoding( const Graph                            &graph,
+                              const std::vector<std::vector<double>> &chromosomes,
+                              representation_result                  &result ) {
+  const r3dp::brkga::basic_r3dp_decoder<Graph> decoder( graph );
+  const auto                                   start = std::chrono::steady_clock::now();
+  for ( const auto &chromosome : chromosomes ) {
+    result.fitness_sum += decoder.decode( chromosome );
+  }
+  const double elapsed = seconds_since( start );
+  result.decodes_per_second =
+    elapsed > 0.0 ? static_cast<double>( chromosomes.size() ) / elapsed : 0.0;
+}
+
+int main( int argc, char *argv[] ) {
+  CLI::App app{ "Compara memória e vazão das representações de grafo (csr e comprimida)" };
+  argv = app.ensure_utf8( argv );
+
+  std::string input_file_path;
+  app.add_option( "-f,--file", input_file_path, "Arquivo de arestas (edges.txt)" )
+    ->required()
+    ->check( CLI::ExistingFile );
+
+  unsigned chromosomes_count = DEFAULT_CHROMOSOMES;
+  app
+    .add_option(
+      "--chromosomes", chromosomes_count, "Cromossomos aleatórios decodificados por representação" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned sweeps = DEFAULT_SWEEPS;
+  app.add_option( "--sweeps", sweeps, "Varreduras completas da adjacência por representação" )
+    ->check( CLI::PositiveNumber );
+
+  uint32_t rng_seed = DEFAULT_RNG_SEED;
+  app.add_option( "-s,--seed", rng_seed, "Semente dos cromossomos" );
+
+  std::string output_file_path;
+  app.add_option( "-o,--output", output_file_path, "Arquivo de resultados (opcional)" );
+
+  CLI11_PARSE( app, argc, argv );
+
+  representation_result csr_result{ .name = "csr" };
+  representation_result compressed_result{ .name = "compressed" };
+
+  try {
+    auto start               = std::chrono::steady_clock::now();
+    auto csr                 = r3dp::core::build_csr_from_file( input_file_path );
+    csr_result.build_seconds = seconds_since( start );
+    csr_result.graph_bytes   = csr.memory_bytes();
+
+    LOG_VAR( csr.vertex_count() );
+    LOG_VAR( csr.edge_count() );
+
+    r3dp::brkga::MTRand              rng( rng_seed );
+    std::vector<std::vector<double>> chromosomes( chromosomes_count,
+                                                  std::vector<double>( csr.vertex_count() ) );
+    for ( auto &chromosome : chromosomes ) {
+      for ( auto &gene : chromosome ) {
+        gene = rng.rand();
+      }
+    }
+
+    csr_result.rss_bytes              = r3dp::core::current_rss_bytes();
+    csr_result.sweep_edges_per_second = sweep_edges_per_second( csr, sweeps );
+    measure_decoding( csr, chromosomes, csr_result );
+
+    // Só a versão comprimida fica residente daqui em diante
+    start                           = std::chrono::steady_clock::now();
+    const auto compressed           = r3dp::core::compress( csr );
+    compressed_result.build_seconds = seconds_since( start );
+    compressed_result.graph_bytes   = compressed.memory_bytes();
+    csr                             = {};
+
+    compressed_result.rss_bytes              = r3dp::core::current_rss_bytes();
+    compressed_result.sweep_edges_per_second = sweep_edges_per_second( compressed, sweeps );
+    measure_decoding( compressed, chromosomes, compressed_result );
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "Falha na execução: " << e.what() );
+    return 1;
+  }
+
+  if ( csr_result.fitness_sum != compressed_result.fitness_sum ) {
+    LOG_ERR( "As representações produziram fitness diferentes" );
+    return 1;
+  }
+
+  const double compression_ratio = static_cast<double>( csr_result.graph_bytes ) /
+                                   static_cast<double>( compressed_result.graph_bytes );
+  for ( const auto *result : { &csr_result, &compressed_result } ) {
+    LOG_VAR( result->name );
+    LOG_VAR( result->graph_bytes );
+    LOG_VAR( result->rss_bytes );
+    LOG_VAR( result->sweep_edges_per_second );
+    LOG_VAR( result->decodes_per_second );
+  }
+  LOG_VAR( compression_ratio );
+  LOG_VAR( r3dp::core::peak_rss_bytes() );
+
+  if ( !output_file_path.empty() ) {
+    nlohmann::json j{
+      { "graph", std::filesystem::path( input_file_path ).stem().string() },
+      { "compression_ratio", compression_ratio },
+      { "representations", { csr_result, compressed_result } }
+    };
+    std::ofstream out( output_file_path );
+    out << j.dump( 2 );
+  }
+  return 0;
+}
@@ -0,0 +1,220 @@
+#define DEBUG
+#include "CLI/CLI.hpp"
+#include "core/cancellation.hpp"
+#include "core/graph.hpp"
+#include "core/log.hpp"
+#include "core/run_summary.hpp"
+#include "meta/hho/hho.hpp"
+#include "meta/hho/hho_problem.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+
+static uint64_t generate_random_seed() {
+  std::random_device                      rd;
+  std::mt19937_64                         gen( rd() );
+  std::uniform_int_distribution<uint64_t> dist( 1 );  // 0 é reservado para "aleatória"
+  return dist( gen );
+}
+
+constexpr unsigned DEFAULT_POPULATION_SIZE    = 30;   // >= 1
+constexpr unsigned DEFAULT_MAX_ITERATIONS     = 500;  // >= 1 (também define o decaimento de E)
+constexpr unsigned DEFAULT_NUM_THREADS        = 1;    // >= 1
+constexpr double   DEFAULT_TIME_LIMIT_SECONDS = 0.0;  // obrigatório (>0, resolução de 1 ms)
+constexpr uint64_t DEFAULT_RNG_SEED           = 0;    // 0 = aleatória
+constexpr unsigned DEFAULT_NUM_TRIALS         = 1;    // >= 1
+
+constexpr double INFINITY_FITNESS = std::numeric_limits<double>::infinity();
+
+using r3dp::core::convergence_point;
+using r3dp::core::create_graph_summary;
+using r3dp::core::graph_summary;
+
+struct trial_result {
+  double                                best_fitness_value = INFINITY_FITNESS;
+  std::vector<convergence_point>        convergence_points;
+  std::chrono::steady_clock::time_point start_time_point;
+  std::string                           stop_reason;
+  double                                overshoot_seconds = 0.0;
+  std::uint64_t                         iterations        = 0;
+  std::uint64_t                         evaluations       = 0;
+  std::uint64_t                         seed              = 0;
+
+  void add_point( double fitness_value_now ) {
+    const double t =
+      std::chrono::duration<double>( std::chrono::steady_clock::now() - start_time_point ).count();
+    convergence_points.push_back( { t, fitness_value_now } );
+  }
+
+  // Mesmos campos de brkga_main, para comparar os dois sob o mesmo limite de tempo
+  friend void to_json( nlohmann::json &j, const trial_result &t ) {
+    j = nlohmann::json{ { "best_fitness_value", t.best_fitness_value },
+                        { "stop_reason", t.stop_reason },
+                        { "overshoot_seconds", t.overshoot_seconds },
+                        { "iterations", t.iterations },
+                        { "evaluations", t.evaluations },
+                        { "seed", t.seed },
+                        { "convergence_points", t.convergence_points } };
+  }
+};
+
+struct run_results {
+  graph_summary             graph;
+  double                    time_limit_seconds = 0.0;
+  std::uint64_t             seed               = 0;
+  unsigned                  population_size    = 0;
+  unsigned                  max_iterations     = 0;
+  std::vector<trial_result> trials;
+
+  friend void to_json( nlohmann::json &j, const run_results &r ) {
+    j = nlohmann::json{ { "graph", r.graph },
+                        { "engine", "hho" },
+                        { "time_limit_seconds", r.time_limit_seconds },
+                        { "seed", r.seed },
+                        { "population_size", r.population_size },
+                        { "max_iterations", r.max_iterations },
+                        { "trial_count", r.trials.size() },
+                        { "trials", r.trials } };
+  }
+
+  void save_json( const std::string &filename, int indent = 2 ) const {
+    nlohmann::json j = *this;
+    std::ofstream  ofs( filename );
+    if ( ofs ) {
+      ofs << j.dump( indent );
+      LOG_MESSAGE( "Resultado salvo em: " << filename );
+    } else {
+      LOG_ERR( "Erro ao salvar arquivo JSON em: " << filename );
+    }
+  }
+};
+
+int main( int argc, char *argv[] ) {
+  CLI::App app{ "Harris Hawks Optimization para o problema da dominação {3}-romana" };
+  argv = app.ensure_utf8( argv );
+
+  std::string input_file_path = "default.txt";
+  app.add_option( "-f,--file", input_file_path, "Arquivo de arestas (edges.txt, .gz ou .zst)" )
+    ->required()
+    ->check( CLI::ExistingFile );
+
+  unsigned population_size = DEFAULT_POPULATION_SIZE;
+  app.add_option( "-p,--pop-size", population_size, "Número de falcões (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned max_iterations = DEFAULT_MAX_ITERATIONS;
+  app
+    .add_option( "--max-iterations",
+                 max_iterations,
+                 "Máximo de iterações; a energia de fuga decai de 2 a 0 ao longo delas (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned num_threads = DEFAULT_NUM_THREADS;
+  app.add_option( "-j,--threads", num_threads, "Número de threads (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  double time_limit_seconds = DEFAULT_TIME_LIMIT_SECONDS;
+  app
+    .add_option( "--time-limit",
+                 time_limit_seconds,
+                 "Tempo máximo em segundos (> 0; aceita frações, resolução de 1 ms)" )
+    ->check( CLI::PositiveNumber )
+    ->required();
+
+  std::string output_file_path = "default.json";
+  app.add_option( "-o,--output", output_file_path, "Arquivo de resultados (results.json)" )
+    ->required();
+
+  unsigned num_trials = DEFAULT_NUM_TRIALS;
+  app.add_option( "-r,--runs", num_trials, "Número de tentativas (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  uint64_t rng_seed_cli = DEFAULT_RNG_SEED;
+  app.add_option( "-s,--seed", rng_seed_cli, "Semente (0 = aleatória)" );
+
+  CLI11_PARSE( app, argc, argv );
+
+  const uint64_t rng_seed_to_use = ( rng_seed_cli == 0 ) ? generate_random_seed() : rng_seed_cli;
+  const std::chrono::milliseconds time_limit{ std::max<long long>(
+    1, std::llround( time_limit_seconds * 1000.0 ) ) };
+
+  LOG_VAR( input_file_path );
+  LOG_VAR( population_size );
+  LOG_VAR( max_iterations );
+  LOG_VAR( num_threads );
+  LOG_VAR( time_limit_seconds );
+  LOG_VAR( num_trials );
+  LOG_VAR( output_file_path );
+  LOG_VAR( rng_seed_to_use );
+
+  auto [vertex_count_total, edge_list] = r3dp::core::read_graph_from_file( input_file_path );
+  const auto graph = r3dp::core::build_graph_from( vertex_count_total, edge_list );
+
+  const std::string graph_name = std::filesystem::path( input_file_path ).stem().string();
+  LOG_VAR( vertex_count_total );
+  LOG_VAR( edge_list.size() );
+  LOG_VAR( graph_name );
+
+  run_results run_result;
+  run_result.graph = create_graph_summary( graph_name, vertex_count_total, edge_list.size() );
+  run_result.time_limit_seconds = std::chrono::duration<double>( time_limit ).count();
+  run_result.seed               = rng_seed_to_use;
+  run_result.population_size    = population_size;
+  run_result.max_iterations     = max_iterations;
+  edge_list                     = {};
+
+  const r3dp::hho::r3dp_hho_problem problem( graph );
+
+  for ( unsigned trial = 0; trial < num_trials; ++trial ) {
+    LOG_MESSAGE( "Iniciando tentativa " << trial + 1 << " de " << num_trials );
+
+    trial_result &result    = run_result.trials.emplace_back();
+    result.seed             = rng_seed_to_use + trial;  // HHO trata 0 como semente aleatória
+    result.start_time_point = std::chrono::steady_clock::now();
+
+    const auto                           deadline = result.start_time_point + time_limit;
+    const r3dp::core::cancellation_token cancel( deadline );
+
+    r3dp::hho::HHO<r3dp::hho::r3dp_hho_problem> algorithm(
+      population_size, max_iterations, num_threads, problem, result.seed );
+
+    bool stopped_by_time = false;
+    while ( algorithm.get_iteration() < max_iterations ) {
+      const bool completed =
+        num_threads > 1 ? algorithm.step_parallel( &cancel ) : algorithm.step( &cancel );
+
+      const double best_fitness_now = algorithm.get_best_fitness();
+      if ( best_fitness_now < result.best_fitness_value ) {
+        result.best_fitness_value = best_fitness_now;
+        result.add_point( best_fitness_now );
+        LOG_MESSAGE( "Novo melhor fitness na iteração " << algorithm.get_iteration() << ": "
+                                                        << best_fitness_now );
+      }
+      if ( !completed ) {
+        stopped_by_time = true;
+        break;
+      }
+    }
+
+    const auto now           = std::chrono::steady_clock::now();
+    result.stop_reason       = stopped_by_time ? "time_limit" : "max_iterations";
+    result.overshoot_seconds =
+      now > deadline ? std::chrono::duration<double>( now - deadline ).count() : 0.0;
+    result.iterations  = algorithm.get_iteration();
+    result.evaluations = algorithm.get_evaluations();
+    LOG_VAR( result.best_fitness_value );
+    LOG_VAR( result.iterations );
+    LOG_VAR( result.evaluations );
+  }
+
+  run_result.save_json( output_file_path );
+  return 0;
+}
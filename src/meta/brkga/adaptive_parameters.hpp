@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace r3dp::brkga {
+  /**
+   * One setting of the BRKGA hyperparameters that change between generations (same meaning as the
+   * pe, pm and rhoe arguments of BRKGA::setParameters).
+   */
+  struct parameter_arm {
+    double elite_fraction         = 0.0;
+    double mutant_fraction        = 0.0;
+    double elite_inheritance_prob = 0.0;
+  };
+
+  /**
+   * Online choice of BRKGA hyperparameters as a multi-armed bandit (discounted UCB1).
+   *
+   * Every generation the caller asks for an arm, runs the generation with it and reports a reward
+   * in [0, 1] (e.g. the fraction of populations whose best improved). Rewards and pull counts are
+   * discounted by 'discount' each round, so the choice keeps up with the search moving from
+   * exploration to intensification. When the label-space diversity passed to choose() is below
+   * 'diversity_floor', only the arms with the most mutants compete: a converged population gets
+   * fresh keys instead of more of the arm that converged it.
+   */
+  class adaptive_parameters {
+  public:
+    static constexpr double DEFAULT_EXPLORATION     = 0.5;   // weight of the UCB bonus
+    static constexpr double DEFAULT_DISCOUNT        = 0.99;  // ~100 generations of memory
+    static constexpr double DEFAULT_DIVERSITY_FLOOR = 0.02;  // see BRKGA::getDiversity()
+
+    explicit adaptive_parameters( std::vector<parameter_arm> _arms,
+                                  double _diversity_floor = DEFAULT_DIVERSITY_FLOOR,
+                                  double _exploration     = DEFAULT_EXPLORATION,
+                                  double _discount        = DEFAULT_DISCOUNT ) noexcept( false )
+      : arms( std::move( _arms ) )
+      , diversity_floor( _diversity_floor )
+      , exploration( _exploration )
+      , discount( _discount )
+      , weight( arms.size(), 0.0 )
+      , gain( arms.size(), 0.0 )
+      , pulls( arms.size(), 0 ) {
+      if ( arms.empty() ) {
+        throw std::range_error( "No parameter arms to choose from." );
+      }
+    }
+
+    /**
+     * The base setting plus its neighbours along each axis (elite and mutant fractions halved and
+     * increased by half, inheritance probability -/+ 0.1). Settings that give the same set sizes
+     * for a population of p, or that BRKGA would reject, are dropped. The base comes first.
+     */
+    static std::vector<parameter_arm> arms_around( const parameter_arm &base, unsigned p ) {
+      const double rhoe = base.elite_inheritance_prob;
+
+      std::vector<parameter_arm> candidates{
+        base,
+        { base.elite_fraction * 0.5, base.mutant_fraction, rhoe },
+        { base.elite_fraction * 1.5, base.mutant_fraction, rhoe },
+        { base.elite_fraction, base.mutant_fraction * 0.5, rhoe },
+        { base.elite_fraction, base.mutant_fraction * 1.5, rhoe },
+        { base.elite_fraction, base.mutant_fraction, std::max( 0.5, rhoe - 0.1 ) },
+        { base.elite_fraction, base.mutant_fraction, std::min( 1.0, rhoe + 0.1 ) } };
+
+      std::vector<parameter_arm> distinct;
+      for ( const auto &c : candidates ) {
+        const auto pe = unsigned( c.elite_fraction * p );
+        const auto pm = unsigned( c.mutant_fraction * p );
+        if ( pe == 0 || pe + pm > p ) {
+          continue;
+        }
+        const bool duplicate = std::any_of( distinct.begin(), distinct.end(), [&]( const auto &a ) {
+          return unsigned( a.elite_fraction * p ) == pe &&
+                 unsigned( a.mutant_fraction * p ) == pm &&
+                 a.elite_inheritance_prob == c.elite_inheritance_prob;
+        } );
+        if ( !duplicate ) {
+          distinct.push_back( c );
+        }
+      }
+      return distinct;
+    }
+
+    // Arm for the next generation ('diversity' as measured after the last one)
+    [[nodiscard]] unsigned choose( double diversity ) const {
+      double most_mutants = 0.0;
+      if ( diversity < diversity_floor ) {
+        for ( const auto &a : arms ) {
+          most_mutants = std::max( most_mutants, a.mutant_fraction );
+        }
+      }
+
+      double total = 0.0;
+      for ( double w : weight ) {
+        total += w;
+      }
+
+      unsigned best       = 0;
+      double   best_score = -std::numeric_limits<double>::infinity();
+      for ( unsigned a = 0; a < arms.size(); ++a ) {
+        if ( arms[a].mutant_fraction < most_mutants ) {
+          continue;
+        }
+        if ( weight[a] < MIN_WEIGHT ) {
+          return a;  // never tried (or forgotten): try it before trusting the others
+        }
+        const double score =
+          gain[a] / weight[a] + exploration * std::sqrt( std::log( total ) / weight[a] );
+        if ( score > best_score ) {
+          best       = a;
+          best_score = score;
+        }
+      }
+      return best;
+    }
+
+    // Reward in [0, 1] observed after running one generation with 'arm'
+    void reward( unsigned arm, double value ) {
+      for ( unsigned a = 0; a < arms.size(); ++a ) {
+        weight[a] *= discount;
+        gain[a] *= discount;
+      }
+      weight[arm] += 1.0;
+      gain[arm] += value;
+      ++pulls[arm];
+    }
+
+    [[nodiscard]] const std::vector<parameter_arm> &get_arms() const noexcept {
+      return arms;
+    }
+
+    // Generations run with each arm (not discounted)
+    [[nodiscard]] const std::vector<std::uint64_t> &get_pulls() const noexcept {
+      return pulls;
+    }
+
+  private:
+    static constexpr double MIN_WEIGHT = 1e-3;
+
+    std::vector<parameter_arm> arms;
+    double                     diversity_floor;
+    double                     exploration;
+    double                     discount;
+    std::vector<double>        weight;  // discounted pull counts
+    std::vector<double>        gain;    // discounted reward sums
+    std::vector<std::uint64_t> pulls;
+  };
+}  // namespace r3dp::brkga
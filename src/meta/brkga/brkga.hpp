@@ -1,24 +1,53 @@
 #pragma once
 
+#include "../../core/cancellation.hpp"
+#include "../../core/counter_rng.hpp"
+#include "../../core/perf_counters.hpp"
+#include "../../core/phase_timer.hpp"
+#include "../../core/thread_pool.hpp"
+#include "../../core/spsc_ring.hpp"
+#include "decode_context.hpp"
+#include "migration.hpp"
 #include "population.hpp"
 
 #include <algorithm>
-#include <omp.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <vector>
 
 namespace r3dp::brkga {
   template <class Decoder, class RNG>
   class BRKGA {
   public:
-    BRKGA( unsigned       n,
-           unsigned       p,
-           double         pe,
-           double         pm,
-           double         rhoe,
-           const Decoder &refDecoder,
-           RNG           &refRNG,
-           unsigned       K           = 1,
-           unsigned       MAX_THREADS = 1 ) noexcept( false );
+    /**
+     * The MAX_THREADS - 1 worker threads are created once; they are pinned to 'cpus' only when
+     * given (e.g. by a NUMA placement), and left to the OS scheduler otherwise. They step the K
+     * islands in parallel and, within each island, build and decode the offspring in parallel.
+     * Each island draws one seed per generation from refRNG and every offspring uses its own
+     * counter-based stream, so results for a given seed do not depend on MAX_THREADS.
+     *
+     * 'domains' optionally groups the threads (one entry per thread, e.g. the NUMA node of each
+     * CPU, see core::numa_placement); the calling thread is thread 0 and should run on cpus[0].
+     * Island k then belongs to domain k mod D: its populations are allocated, first-touched and
+     * evolved by threads of that domain, which steal from other domains only when idle.
+     */
+    BRKGA( unsigned                     n,
+           unsigned                     p,
+           double                       pe,
+           double                       pm,
+           double                       rhoe,
+           const Decoder               &refDecoder,
+           RNG                         &refRNG,
+           unsigned                     K           = 1,
+           unsigned                     MAX_THREADS = 1,
+           const std::vector<unsigned> &cpus        = {},
+           const std::vector<unsigned> &domains     = {} ) noexcept( false );
 
     /**
      * Destructor
@@ -30,6 +59,21 @@ namespace r3dp::brkga {
      */
     void reset();
 
+    /**
+     * Partial restart of the given populations: each keeps its 'keep' best chromosomes and the
+     * others get brand new keys. The populations are rebuilt in parallel, and so are the
+     * chromosomes within each one. Must not run concurrently with evolve().
+     */
+    void restart( const std::vector<unsigned> &islands, unsigned keep ) noexcept( false );
+
+    /**
+     * Warm start: the given chromosomes (e.g. encoded heuristic solutions) are dealt round-robin
+     * over the populations and take the place of their worst members (never elite ones). They
+     * are decoded in parallel and each population is re-ranked. Must not run concurrently with
+     * evolve().
+     */
+    void seedPopulations( const std::vector<std::vector<double>> &chromosomes ) noexcept( false );
+
     /**
      * Evolve the current populations following the guidelines of BRKGAs
      * @param generations number of generations (must be even and nonzero)
@@ -39,11 +83,73 @@ namespace r3dp::brkga {
     void evolve( unsigned generations = 1 );
 
     /**
-     * Exchange elite-solutions between the populations
+     * Same as evolve(generations), but stops as soon as 'token' fires. The token is also polled
+     * inside decoders that take a decode_context, so a long generation is interrupted mid-way.
+     * A generation interrupted this way is discarded: the populations stay as they were after
+     * the last complete generation.
+     * @return true if all 'generations' were completed
+     */
+    bool evolve( unsigned generations, const core::cancellation_token &token );
+
+    /**
+     * Exchange elite-solutions between the populations: each one receives the M best of every
+     * population that sends to it in the migration topology (all of them by default)
      * @param M number of elite chromosomes to select from each population
      */
     void exchangeElite( unsigned M ) noexcept( false );
 
+    /**
+     * Sets where each population sends its elite, both in exchangeElite() and in asynchronous
+     * migration (see migration_topology). Must not run concurrently with evolve().
+     */
+    void setMigrationTopology( migration_topology topology );
+
+    /**
+     * Asynchronous migration: from now on evolve() lets every population go through its
+     * generations on its own, without waiting for the others. Every 'interval' generations of
+     * its own, a population offers copies of its M best to its targets in the topology through
+     * lock-free single-producer/single-consumer buffers (room for M chromosomes per sender and
+     * receiver pair); an offer that finds the buffer still full is dropped. At the start of each
+     * generation a population takes in whatever has arrived, in place of its worst chromosomes.
+     * Results then depend on thread timing. interval == 0 turns it off and frees the buffers.
+     * Must not run concurrently with evolve().
+     */
+    void setAsyncMigration( unsigned interval, unsigned M ) noexcept( false );
+
+    /**
+     * Returns the chromosomes sent, dropped and received through the asynchronous buffers
+     */
+    migration_stats getMigrationStats() const;
+
+    /**
+     * Inserts a chromosome found elsewhere (e.g. by another solver) into every population whose
+     * best fitness is worse than 'fitness', replacing that population's worst member. The caller
+     * vouches for 'fitness' (it is not re-decoded). Must not run concurrently with evolve().
+     * @return true if at least one population received the migrant
+     */
+    bool injectMigrant( const std::vector<double> &chromosome, double fitness ) noexcept( false );
+
+    /**
+     * Replaces the elite fraction, mutant fraction and inheritance probability used from the next
+     * generation on (same meaning and checks as in the constructor). Populations whose ranked
+     * prefix is shorter than the new elite set are re-ranked. Must not run concurrently with
+     * evolve().
+     */
+    void setParameters( double pe, double pm, double rhoe ) noexcept( false );
+
+    /**
+     * Returns how much population k disagrees with its own best chromosome, in [0, 1]: the
+     * fraction of genes, over a sample of up to DIVERSITY_SAMPLE members, whose label differs
+     * from the best one's (Decoder::label_of, see quantizing_decoder), or the mean absolute key
+     * difference when the Decoder does not quantize keys.
+     */
+    double getDiversity( unsigned k ) const;
+
+    /**
+     * Returns getDiversity(k) averaged over all populations
+     */
+    double getDiversity() const;
+
     /**
      * Returns the current population
      */
@@ -59,6 +165,46 @@ namespace r3dp::brkga {
      */
     double getBestFitness() const;
 
+    /**
+     * Returns the per-phase timers and evaluation counters accumulated since construction
+     * (or since the last resetPhaseStats())
+     */
+    core::phase_report getPhaseReport() const;
+
+    /**
+     * Clears the per-phase timers and evaluation counters
+     */
+    void resetPhaseStats();
+
+    /**
+     * Enables hardware performance counters (perf_event_open) around the crossover, decode and
+     * repair regions. When the counters cannot be opened, the report says so and BRKGA runs as
+     * usual.
+     */
+    void setPerfCounters( bool enabled );
+
+    /**
+     * Decodes each generation in batches of Decoder::BATCH_LANES chromosomes (one task per batch)
+     * instead of one chromosome per task, when the Decoder supports it (see batch_decoder).
+     * @return whether batch decoding is now in use
+     */
+    bool setBatchDecoding( bool enabled );
+
+    /**
+     * Keeps the decoded solution of every chromosome and decodes each mated offspring starting
+     * from the solution of its elite parent (Decoder::decode_delta, see delta_decoder). Fitness
+     * values are the same as with full decoding. Elites decoded before this call get their
+     * solution the next time they are copied. Takes precedence over batch decoding, which is
+     * turned off.
+     * @return whether delta decoding is now in use
+     */
+    bool setDeltaDecoding( bool enabled );
+
+    /**
+     * Returns the hardware counters accumulated per region (see setPerfCounters())
+     */
+    core::perf_report getPerfReport() const;
+
     // Return copies to the internal parameters:
     unsigned getN() const;
     unsigned getP() const;
@@ -74,9 +220,11 @@ namespace r3dp::brkga {
     // Hyperparameters:
     const unsigned n;     // number of genes in the chromosome
     const unsigned p;     // number of elements in the population
-    const unsigned pe;    // number of elite items in the population
-    const unsigned pm;    // number of mutants introduced at each generation into the population
-    const double   rhoe;  // probability that an offspring inherits the allele of its elite parent
+    unsigned       pe;    // number of elite items in the population (see setParameters())
+    unsigned       pm;    // number of mutants introduced at each generation into the population
+    double         rhoe;  // probability that an offspring inherits the allele of its elite parent
+
+    static constexpr unsigned DIVERSITY_SAMPLE = 8;  // members compared by getDiversity()
 
     // Templates:
     RNG           &refRNG;      // reference to the random number generator
@@ -90,22 +238,84 @@ namespace r3dp::brkga {
     std::vector<Population *> previous;  // previous populations
     std::vector<Population *> current;   // current populations
 
+    // Persistent executor for island steps, offspring construction and decoding:
+    core::thread_pool     pool;
+    std::vector<unsigned> islandDomain;  // pool domain that steps each island
+
+    bool batchDecoding = false;
+    bool deltaDecoding = false;  // Population::solutions are kept (see setDeltaDecoding())
+
+    // Migration (see setMigrationTopology() and setAsyncMigration()):
+    struct Migrant {
+      std::vector<double>       chromosome;
+      double                    fitness = 0.0;
+      std::vector<std::uint8_t> solution;  // with delta decoding
+    };
+    struct alignas( 64 ) IslandState {  // written only by the task stepping the island
+      unsigned             generation = 0;  // generations since asynchronous migration was enabled
+      migration_stats      migration;
+      std::vector<Migrant> inbox;  // migrants taken from the buffers, before they land
+    };
+    using MigrantBuffer = core::spsc_ring<Migrant>;
+    migration_topology                          topology      = migration_topology::all_to_all;
+    unsigned                                    asyncInterval = 0;  // 0: synchronous only
+    unsigned                                    asyncSize     = 0;  // M
+    std::uint64_t                               asyncSeed     = 0;  // for the random topology
+    std::vector<std::unique_ptr<MigrantBuffer>> buffers;            // [from * K + to], or null
+    std::vector<IslandState>                    islandState;
+
+    // Cancellation of the generation in progress (set only while evolve() runs). The abort is kept
+    // per island, so an island cut short does not make the others drop their generation:
+    const core::cancellation_token      *cancel = nullptr;
+    std::unique_ptr<std::atomic<bool>[]> aborted;  // [k]: an offspring was skipped or cut short
+
+    // Instrumentation (one cache-line-aligned slot per pool thread, no locking):
+    core::phase_stats   stats;
+    core::perf_recorder perf;
+
     // Local operations:
-    void initialize( const unsigned i );  // initialize current population 'i' with random keys
-    void evolution( Population &curr, Population &next );
+    void          initialize( const unsigned i, std::uint64_t seed );  // random keys for pop 'i'
+    void          evolution( unsigned k, Population &curr, Population &next, std::uint64_t seed );
+    void          restartPopulation( unsigned      k,
+                                     Population   &curr,
+                                     Population   &next,
+                                     unsigned      keep,
+                                     std::uint64_t seed );
+    double        decodeOne( unsigned                         k,
+                             const std::vector<double>       &chromosome,
+                             std::vector<std::uint8_t>       *solution = nullptr,
+                             const std::vector<std::uint8_t> *parent   = nullptr );
+    void          decodeBatches( unsigned k, Population &pop, unsigned first, unsigned last );
+    void          checkSetSizes() const noexcept( false );
+    bool          stopRequested( unsigned k );  // polls 'cancel' and records island k's abort
+    void          clearAborts();
+    bool          anyAborted() const;
+    std::uint64_t drawSeed();       // 64 bits from refRNG
+    void          addWallSince( core::phase_stats::clock::time_point start );
+    void          exchangeEliteCopy( unsigned                                  M,
+                                     const std::vector<std::vector<unsigned>> &sources );
+    bool          evolveIslands( unsigned generations );  // asynchronous evolve()
+    void          sendMigrants( unsigned k );
+    void          receiveMigrants( unsigned k );
+    void          buildBuffers();
     bool isRepeated( const std::vector<double> &chrA, const std::vector<double> &chrB ) const;
+
+    // &pop.solutions[i] with delta decoding, null otherwise
+    std::vector<std::uint8_t> *solutionOf( Population &pop, unsigned i );
   };
 
   template <class Decoder, class RNG>
-  BRKGA<Decoder, RNG>::BRKGA( unsigned       _n,
-                              unsigned       _p,
-                              double         _pe,
-                              double         _pm,
-                              double         _rhoe,
-                              const Decoder &decoder,
-                              RNG           &rng,
-                              unsigned       _K,
-                              unsigned       MAX ) noexcept( false )
+  BRKGA<Decoder, RNG>::BRKGA( unsigned                     _n,
+                              unsigned                     _p,
+                              double                       _pe,
+                              double                       _pm,
+                              double                       _rhoe,
+                              const Decoder               &decoder,
+                              RNG                         &rng,
+                              unsigned                     _K,
+                              unsigned                     MAX,
+                              const std::vector<unsigned> &cpus,
+                              const std::vector<unsigned> &domains ) noexcept( false )
     : n( _n )
     , p( _p )
     , pe( unsigned( _pe * p ) )
@@ -116,7 +326,13 @@ namespace r3dp::brkga {
     , K( _K )
     , MAX_THREADS( MAX )
     , previous( K, 0 )
-    , current( K, 0 ) {
+    , current( K, 0 )
+    , pool( MAX, cpus, domains )
+    , islandDomain( K )
+    , islandState( K )
+    , aborted( std::make_unique<std::atomic<bool>[]>( K ) )
+    , stats( pool.size() )
+    , perf( pool.size() ) {
     // Error check:
     using std::range_error;
     if ( n == 0 ) {
@@ -125,33 +341,33 @@ namespace r3dp::brkga {
     if ( p == 0 ) {
       throw range_error( "Population size equals zero." );
     }
-    if ( pe == 0 ) {
-      throw range_error( "Elite-set size equals zero." );
-    }
-    if ( pe > p ) {
-      throw range_error( "Elite-set size greater than population size (pe > p)." );
-    }
-    if ( pm > p ) {
-      throw range_error( "Mutant-set size (pm) greater than population size (p)." );
-    }
-    if ( pe + pm > p ) {
-      throw range_error( "elite + mutant sets greater than population size (p)." );
-    }
+    checkSetSizes();
     if ( K == 0 ) {
       throw range_error( "Number of parallel populations cannot be zero." );
     }
 
-    // Initialize and decode each chromosome of the current population, then copy to previous:
     for ( unsigned i = 0; i < K; ++i ) {
+      islandDomain[i] = i % pool.domain_count();
+    }
+
+    // Initialize and decode each chromosome of the current population, then copy to previous.
+    // Each island is built by a thread of its domain, so its pages are first touched there:
+    const auto                 start = core::phase_stats::clock::now();
+    std::vector<std::uint64_t> seeds( K );
+    for ( auto &seed : seeds ) {
+      seed = drawSeed();
+    }
+    pool.parallel_for_placed( islandDomain, [&]( std::size_t i ) {
       // Allocate:
       current[i] = new Population( n, p );
 
       // Initialize:
-      initialize( i );
+      initialize( unsigned( i ), seeds[i] );
 
       // Then just copy to previous:
       previous[i] = new Population( *current[i] );
-    }
+    } );
+    addWallSince( start );
   }
 
   template <class Decoder, class RNG>
@@ -162,6 +378,66 @@ namespace r3dp::brkga {
     }
   }
 
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::setParameters( double _pe,
+                                           double _pm,
+                                           double _rhoe ) noexcept( false ) {
+    const unsigned oldPe = pe;
+    const unsigned oldPm = pm;
+    pe                   = unsigned( _pe * p );
+    pm                   = unsigned( _pm * p );
+    try {
+      checkSetSizes();
+    } catch ( ... ) {
+      pe = oldPe;
+      pm = oldPm;
+      throw;
+    }
+    rhoe = _rhoe;
+
+    // evolution() reads the first 'pe' ranks of each population as its elite set:
+    core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+    for ( unsigned j = 0; j < K; ++j ) {
+      if ( current[j]->getRanked() < pe ) {
+        current[j]->sortFitness( pe );
+      }
+    }
+  }
+
+  template <class Decoder, class RNG>
+  double BRKGA<Decoder, RNG>::getDiversity( unsigned k ) const {
+    if ( p < 2 ) {
+      return 0.0;
+    }
+
+    // Members at evenly spaced ranks; ranks past getRanked() are in no particular order
+    const unsigned             sample = std::min( p - 1, DIVERSITY_SAMPLE );
+    const Population          &pop    = *current[k];
+    const std::vector<double> &best   = pop.getChromosome( 0 );
+    double                     sum    = 0.0;
+    for ( unsigned s = 1; s <= sample; ++s ) {
+      const unsigned             rank  = unsigned( s * ( p - 1ull ) / sample );
+      const std::vector<double> &other = pop.getChromosome( rank );
+      for ( unsigned j = 0; j < n; ++j ) {
+        if constexpr ( quantizing_decoder<Decoder> ) {
+          sum += Decoder::label_of( best[j] ) != Decoder::label_of( other[j] );
+        } else {
+          sum += std::abs( best[j] - other[j] );
+        }
+      }
+    }
+    return sum / ( double( sample ) * n );
+  }
+
+  template <class Decoder, class RNG>
+  double BRKGA<Decoder, RNG>::getDiversity() const {
+    double total = 0.0;
+    for ( unsigned k = 0; k < K; ++k ) {
+      total += getDiversity( k );
+    }
+    return total / K;
+  }
+
   template <class Decoder, class RNG>
   const Population &BRKGA<Decoder, RNG>::getPopulation( unsigned k ) const {
 #ifdef RANGECHECK
@@ -196,27 +472,191 @@ namespace r3dp::brkga {
     return current[bestK]->getChromosome( 0 );  // The top one :-)
   }
 
+  template <class Decoder, class RNG>
+  core::phase_report BRKGA<Decoder, RNG>::getPhaseReport() const {
+    return stats.report();
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::resetPhaseStats() {
+    stats.reset();
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::setPerfCounters( bool enabled ) {
+    perf.enable( enabled );
+  }
+
+  template <class Decoder, class RNG>
+  bool BRKGA<Decoder, RNG>::setBatchDecoding( bool enabled ) {
+    batchDecoding = enabled && batch_decoder<Decoder> && !deltaDecoding;
+    return batchDecoding;
+  }
+
+  template <class Decoder, class RNG>
+  bool BRKGA<Decoder, RNG>::setDeltaDecoding( bool enabled ) {
+    deltaDecoding = enabled && delta_decoder<Decoder>;
+    if ( deltaDecoding ) {
+      batchDecoding = false;
+    }
+    for ( unsigned k = 0; k < K; ++k ) {
+      for ( Population *pop : { current[k], previous[k] } ) {
+        pop->solutions.clear();
+        pop->solutions.shrink_to_fit();
+        if ( deltaDecoding ) {
+          pop->solutions.resize( p );
+        }
+      }
+    }
+    return deltaDecoding;
+  }
+
+  template <class Decoder, class RNG>
+  core::perf_report BRKGA<Decoder, RNG>::getPerfReport() const {
+    return perf.report();
+  }
+
   template <class Decoder, class RNG>
   void BRKGA<Decoder, RNG>::reset() {
-    for ( unsigned i = 0; i < K; ++i ) {
-      initialize( i );
+    const auto                 start = core::phase_stats::clock::now();
+    std::vector<std::uint64_t> seeds( K );
+    for ( auto &seed : seeds ) {
+      seed = drawSeed();
     }
+    clearAborts();  // no token: every decode must complete
+    pool.parallel_for_placed( islandDomain,
+                              [&]( std::size_t i ) { initialize( unsigned( i ), seeds[i] ); } );
+    addWallSince( start );
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::restart( const std::vector<unsigned> &islands,
+                                     unsigned                     keep ) noexcept( false ) {
+    if ( keep == 0 || keep > p ) {
+      throw std::range_error( "A restart must keep between 1 and p chromosomes." );
+    }
+    for ( unsigned k : islands ) {
+      if ( k >= K ) {
+        throw std::range_error( "Invalid population identifier." );
+      }
+    }
+
+    const auto                 start = core::phase_stats::clock::now();
+    std::vector<std::uint64_t> seeds( islands.size() );
+    std::vector<unsigned>      domainOf( islands.size() );
+    for ( std::size_t s = 0; s < islands.size(); ++s ) {
+      seeds[s]    = drawSeed();
+      domainOf[s] = islandDomain[islands[s]];
+    }
+
+    clearAborts();  // no token: every decode must complete
+    pool.parallel_for_placed( domainOf, [&]( std::size_t s ) {
+      const unsigned k = islands[s];
+      restartPopulation( k, *current[k], *previous[k], keep, seeds[s] );
+    } );
+    for ( unsigned k : islands ) {
+      std::swap( current[k], previous[k] );
+    }
+    addWallSince( start );
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::seedPopulations(
+    const std::vector<std::vector<double>> &chromosomes ) noexcept( false ) {
+    if ( chromosomes.size() > std::size_t{ K } * ( p - pe ) ) {
+      throw std::range_error( "More seeds than non-elite chromosomes in all populations." );
+    }
+    for ( const auto &chromosome : chromosomes ) {
+      if ( chromosome.size() != n ) {
+        throw std::range_error( "Seed size differs from the chromosome size." );
+      }
+    }
+
+    const auto            start = core::phase_stats::clock::now();
+    std::vector<unsigned> domainOf( chromosomes.size() );
+    for ( std::size_t s = 0; s < chromosomes.size(); ++s ) {
+      domainOf[s] = islandDomain[s % K];
+    }
+    {
+      // Seed s takes rank p - 1 - s / K of its population: those ranks must hold the worst
+      core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+      for ( unsigned j = 0; j < std::min<std::size_t>( K, chromosomes.size() ); ++j ) {
+        current[j]->gatherWorst( unsigned( ( chromosomes.size() - j + K - 1 ) / K ) );
+      }
+    }
+
+    clearAborts();  // no token: every decode must complete
+    pool.parallel_for_placed( domainOf, [&]( std::size_t s ) {
+      Population          &pop    = *current[s % K];
+      const unsigned       rank   = p - 1 - unsigned( s / K );
+      std::vector<double> &target = pop.getChromosome( rank );
+      {
+        core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::initialize ) );
+        std::copy( chromosomes[s].begin(), chromosomes[s].end(), target.begin() );
+      }
+      pop.fitness[rank].first =
+        decodeOne( unsigned( s % K ), target, solutionOf( pop, pop.fitness[rank].second ) );
+    } );
+
+    core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+    for ( unsigned j = 0; j < std::min<std::size_t>( K, chromosomes.size() ); ++j ) {
+      current[j]->sortFitness( pe );
+    }
+    addWallSince( start );
   }
 
   template <class Decoder, class RNG>
   void BRKGA<Decoder, RNG>::evolve( unsigned generations ) {
+    const core::cancellation_token never;
+    evolve( generations, never );
+  }
+
+  template <class Decoder, class RNG>
+  bool BRKGA<Decoder, RNG>::evolve( unsigned generations, const core::cancellation_token &token ) {
 #ifdef RANGECHECK
     if ( generations == 0 ) {
       throw std::range_error( "Cannot evolve for 0 generations." );
     }
 #endif
 
-    for ( unsigned i = 0; i < generations; ++i ) {
-      for ( unsigned j = 0; j < K; ++j ) {
-        evolution( *current[j], *previous[j] );  // First evolve the population (curr, next)
-        std::swap( current[j], previous[j] );    // Update (prev = curr; curr = prev == next)
+    const auto                 start     = core::phase_stats::clock::now();
+    bool                       completed = true;
+    std::vector<std::uint64_t> seeds( K );
+    cancel = &token;
+    if ( asyncInterval > 0 ) {
+      completed = evolveIslands( generations );
+    } else {
+      for ( unsigned i = 0; i < generations; ++i ) {
+        if ( token.stop_requested() ) {
+          completed = false;
+          break;
+        }
+
+        // Seeds are drawn in island order, so the outcome does not depend on the scheduling:
+        for ( auto &seed : seeds ) {
+          seed = drawSeed();
+        }
+
+        // Islands are independent between migrations, so they step in parallel (each on its
+        // domain):
+        clearAborts();
+        pool.parallel_for_placed( islandDomain, [&]( std::size_t j ) {
+          evolution( unsigned( j ), *current[j], *previous[j], seeds[j] );  // First evolve
+        } );
+
+        if ( anyAborted() ) {
+          // 'previous' holds a partial generation: dropping it leaves 'current' untouched
+          completed = false;
+          break;
+        }
+        for ( unsigned j = 0; j < K; ++j ) {
+          std::swap( current[j], previous[j] );  // Update (prev = curr; curr = prev == next)
+        }
       }
     }
+    cancel = nullptr;
+    addWallSince( start );
+    return completed;
   }
 
   template <class Decoder, class RNG>
@@ -227,13 +667,265 @@ namespace r3dp::brkga {
     }
 #endif
 
-    for ( unsigned i = 0; i < K; ++i ) {
-      // Population i will receive some elite members from each Population j below:
-      unsigned dest = p - 1;  // Last chromosome of i (will be updated below)
+    const auto     start = core::phase_stats::clock::now();
+    const unsigned slot  = pool.slot();
+
+    // Ranks that must stay ordered: the elite set, and the M best that are sent away
+    const unsigned keep = std::max( pe, std::min( M, p ) );
+    {
+      core::scoped_timer timer( stats.elapsed( slot, core::phase::sort ) );
       for ( unsigned j = 0; j < K; ++j ) {
-        if ( j == i ) {
+        if ( current[j]->getRanked() < keep ) {
+          current[j]->sortFitness( keep );
+        }
+      }
+    }
+
+    // Populations that send to each one, in increasing order:
+    std::vector<std::vector<unsigned>> sources( K );
+    {
+      core::scoped_timer timer( stats.elapsed( slot, core::phase::exchange_elite ) );
+      const std::uint64_t seed = topology == migration_topology::random ? drawSeed() : 0;
+      for ( unsigned j = 0; j < K; ++j ) {
+        core::counter_rng rng( seed, j );
+        for ( unsigned i : migration_targets( topology, j, K, rng ) ) {
+          sources[i].push_back( j );
+        }
+      }
+      exchangeEliteCopy( M, sources );
+    }
+
+    {
+      // Migrants landed on the worst ranks (gathered there by exchangeEliteCopy); merge them into
+      // the ranked prefix one by one instead of re-sorting whole populations (unless they
+      // overwrote part of that prefix):
+      core::scoped_timer timer( stats.elapsed( slot, core::phase::sort ) );
+      for ( unsigned j = 0; j < K; ++j ) {
+        const unsigned migrants       = unsigned( sources[j].size() ) * M;
+        const unsigned firstMigrantAt = migrants < p ? p - migrants : 0;
+        if ( firstMigrantAt < current[j]->getRanked() ) {
+          current[j]->sortFitness( keep );
           continue;
         }
+        for ( unsigned r = firstMigrantAt; r < p; ++r ) {
+          current[j]->promote( r );
+        }
+      }
+    }
+    addWallSince( start );
+  }
+
+  template <class Decoder, class RNG>
+  bool BRKGA<Decoder, RNG>::injectMigrant( const std::vector<double> &chromosome,
+                                           double                     fitness ) noexcept( false ) {
+    if ( chromosome.size() != n ) {
+      throw std::range_error( "Migrant size differs from the chromosome size." );
+    }
+
+    const auto         start    = core::phase_stats::clock::now();
+    bool               injected = false;
+    core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::exchange_elite ) );
+    for ( unsigned j = 0; j < K; ++j ) {
+      Population &pop = *current[j];
+      if ( !( fitness < pop.getBestFitness() ) ) {
+        continue;  // this island already has something at least as good
+      }
+
+      // The migrant takes the worst rank and is merged into the ranked prefix, as in exchangeElite
+      pop.gatherWorst( 1 );
+      std::copy( chromosome.begin(), chromosome.end(), pop.getChromosome( p - 1 ).begin() );
+      pop.fitness[p - 1].first = fitness;
+      if ( deltaDecoding ) {
+        pop.solutions[pop.fitness[p - 1].second].clear();  // not decoded here (see evolution())
+      }
+      if ( p - 1 < pop.getRanked() ) {
+        pop.sortFitness( pe );
+      } else {
+        pop.promote( p - 1 );
+      }
+      injected = true;
+    }
+    addWallSince( start );
+    return injected;
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::setMigrationTopology( migration_topology _topology ) {
+    topology = _topology;
+    if ( asyncInterval > 0 ) {
+      buildBuffers();
+    }
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::setAsyncMigration( unsigned interval, unsigned M ) noexcept( false ) {
+    if ( interval > 0 && ( M == 0 || M >= p ) ) {
+      throw std::range_error( "M cannot be zero or >= p." );
+    }
+    asyncInterval = interval;
+    asyncSize     = M;
+    asyncSeed     = interval > 0 ? drawSeed() : 0;
+    for ( auto &state : islandState ) {
+      state.generation = 0;
+    }
+    buildBuffers();
+  }
+
+  template <class Decoder, class RNG>
+  migration_stats BRKGA<Decoder, RNG>::getMigrationStats() const {
+    migration_stats total;
+    for ( const auto &state : islandState ) {
+      total.sent += state.migration.sent;
+      total.dropped += state.migration.dropped;
+      total.received += state.migration.received;
+    }
+    return total;
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::buildBuffers() {
+    buffers.clear();
+    if ( asyncInterval == 0 ) {
+      return;
+    }
+
+    // The random topology may pick any pair; the others always use the same ones:
+    const migration_topology pairs =
+      topology == migration_topology::random ? migration_topology::all_to_all : topology;
+    buffers.resize( std::size_t( K ) * K );
+    for ( unsigned from = 0; from < K; ++from ) {
+      core::counter_rng rng( 0, from );
+      for ( unsigned to : migration_targets( pairs, from, K, rng ) ) {
+        buffers[std::size_t( from ) * K + to] = std::make_unique<MigrantBuffer>( asyncSize );
+      }
+    }
+  }
+
+  template <class Decoder, class RNG>
+  bool BRKGA<Decoder, RNG>::evolveIslands( unsigned generations ) {
+    // The same seeds, in the same order, as 'generations' synchronous steps:
+    std::vector<std::uint64_t> seeds( std::size_t( generations ) * K );
+    for ( auto &seed : seeds ) {
+      seed = drawSeed();
+    }
+
+    // Each island runs all its generations in one task; only the end of evolve() joins them. A
+    // generation cut short by the token is dropped, as in the synchronous loop, by that island
+    // only:
+    clearAborts();
+    pool.parallel_for_placed( islandDomain, [&]( std::size_t j ) {
+      const auto k = unsigned( j );
+      for ( unsigned g = 0; g < generations && !stopRequested( k ); ++g ) {
+        receiveMigrants( k );
+        evolution( k, *current[k], *previous[k], seeds[std::size_t( g ) * K + k] );
+        if ( aborted[k].load( std::memory_order_relaxed ) ) {
+          break;
+        }
+        std::swap( current[k], previous[k] );
+        if ( ++islandState[k].generation % asyncInterval == 0 ) {
+          sendMigrants( k );
+        }
+      }
+    } );
+    return !anyAborted();
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::sendMigrants( unsigned k ) {
+    Population    &pop  = *current[k];
+    const unsigned slot = pool.slot();
+    if ( pop.getRanked() < asyncSize ) {
+      core::scoped_timer timer( stats.elapsed( slot, core::phase::sort ) );
+      pop.sortFitness( std::max( pe, asyncSize ) );
+    }
+
+    core::scoped_timer timer( stats.elapsed( slot, core::phase::exchange_elite ) );
+    core::counter_rng  rng( asyncSeed, ( std::uint64_t( k ) << 32 ) | islandState[k].generation );
+    auto              &counts = islandState[k].migration;
+    for ( unsigned to : migration_targets( topology, k, K, rng ) ) {
+      MigrantBuffer &buffer = *buffers[std::size_t( k ) * K + to];
+      for ( unsigned m = 0; m < asyncSize; ++m ) {
+        const bool pushed = buffer.try_push( [&]( Migrant &migrant ) {
+          migrant.chromosome = pop.getChromosome( m );
+          migrant.fitness    = pop.fitness[m].first;
+          if ( deltaDecoding ) {
+            migrant.solution = pop.solutions[pop.fitness[m].second];
+          }
+        } );
+        if ( !pushed ) {
+          counts.dropped += asyncSize - m;
+          break;
+        }
+        ++counts.sent;
+      }
+    }
+  }
+
+  template <class Decoder, class RNG>
+  void BRKGA<Decoder, RNG>::receiveMigrants( unsigned k ) {
+    Population    &pop    = *current[k];
+    auto          &inbox  = islandState[k].inbox;
+    const unsigned slot   = pool.slot();
+    const unsigned room   = p - pe;  // migrants only take non-elite ranks
+    unsigned       landed = 0;
+
+    // Vectors are swapped all the way: the buffer slot gets the inbox's old ones for reuse, and
+    // the inbox gets those of the chromosomes the migrants replace
+    std::optional<core::scoped_timer> exchangeTimer(
+      std::in_place, stats.elapsed( slot, core::phase::exchange_elite ) );
+    for ( unsigned from = 0; from < K && landed < room; ++from ) {
+      MigrantBuffer *buffer = buffers[std::size_t( from ) * K + k].get();
+      if ( buffer == nullptr ) {
+        continue;
+      }
+      while ( landed < room && buffer->try_pop( [&]( Migrant &migrant ) {
+        if ( inbox.size() == landed ) {
+          inbox.emplace_back();
+        }
+        std::swap( inbox[landed], migrant );
+      } ) ) {
+        ++landed;
+      }
+    }
+    if ( landed == 0 ) {
+      return;
+    }
+    islandState[k].migration.received += landed;
+
+    // They replace the 'landed' worst, and are then merged into the ranked prefix as in
+    // exchangeElite():
+    pop.gatherWorst( landed );
+    for ( unsigned t = 0; t < landed; ++t ) {
+      const unsigned rank  = p - 1 - t;
+      const unsigned index = pop.fitness[rank].second;
+      std::swap( pop( index ), inbox[t].chromosome );
+      pop.fitness[rank].first = inbox[t].fitness;
+      if ( deltaDecoding ) {
+        std::swap( pop.solutions[index], inbox[t].solution );
+      }
+    }
+    exchangeTimer.reset();
+
+    core::scoped_timer timer( stats.elapsed( slot, core::phase::sort ) );
+    if ( p - landed < pop.getRanked() ) {
+      pop.sortFitness( pe );
+      return;
+    }
+    for ( unsigned r = p - landed; r < p; ++r ) {
+      pop.promote( r );
+    }
+  }
+
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::exchangeEliteCopy(
+    unsigned                                  M,
+    const std::vector<std::vector<unsigned>> &sources ) {
+    for ( unsigned i = 0; i < K; ++i ) {
+      // Population i will receive some elite members from each Population j below, in place of
+      // its worst ones (only ranks past the ranked prefix move, so the senders' M best stay put):
+      current[i]->gatherWorst( unsigned( sources[i].size() ) * M );
+      unsigned dest = p - 1;  // Last chromosome of i (will be updated below)
+      for ( unsigned j : sources[i] ) {
 
         // Copy the M best of Population j into Population i:
         for ( unsigned m = 0; m < M; ++m ) {
@@ -243,90 +935,334 @@ namespace r3dp::brkga {
           std::copy( bestOfJ.begin(), bestOfJ.end(), current[i]->getChromosome( dest ).begin() );
 
           current[i]->fitness[dest].first = current[j]->fitness[m].first;
+          if ( deltaDecoding ) {
+            current[i]->solutions[current[i]->fitness[dest].second] =
+              current[j]->solutions[current[j]->fitness[m].second];
+          }
 
           --dest;
         }
       }
     }
+  }
 
-    for ( int j = 0; j < int( K ); ++j ) {
-      current[j]->sortFitness();
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::initialize( const unsigned i, std::uint64_t seed ) {
+    Population &pop = *current[i];
+
+    // Generate and decode each chromosome in the same task (one key stream per chromosome):
+    pool.parallel_for( 0, p, [&]( std::size_t j ) {
+      {
+        core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::initialize ) );
+        core::counter_rng  rng( seed, j );
+        for ( double &key : pop( unsigned( j ) ) ) {
+          key = rng.uniform();
+        }
+      }
+      if ( !batchDecoding ) {
+        pop.setFitness( unsigned( j ),
+                        decodeOne( i, pop( unsigned( j ) ), solutionOf( pop, unsigned( j ) ) ) );
+      }
+    } );
+    if ( batchDecoding ) {
+      decodeBatches( i, pop, 0, p );
     }
+
+    // Rank the elite set:
+    core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+    pop.sortFitness( pe );
   }
 
   template <class Decoder, class RNG>
-  inline void BRKGA<Decoder, RNG>::initialize( const unsigned i ) {
-    for ( unsigned j = 0; j < p; ++j ) {
-      for ( unsigned k = 0; k < n; ++k ) {
-        ( *current[i] )( j, k ) = refRNG.rand();
+  inline void BRKGA<Decoder, RNG>::restartPopulation( unsigned      k,
+                                                      Population   &curr,
+                                                      Population   &next,
+                                                      unsigned      keep,
+                                                      std::uint64_t seed ) {
+    if ( curr.getRanked() < keep ) {
+      core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+      curr.sortFitness( keep );
+    }
+
+    // Same layout as evolution(): the survivors take the first ranks of 'next'
+    pool.parallel_for( 0, p, [&]( std::size_t idx ) {
+      const auto i = unsigned( idx );
+      {
+        core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::initialize ) );
+        if ( i < keep ) {
+          const std::vector<double> &survivor = curr( curr.fitness[i].second );
+          std::copy( survivor.begin(), survivor.end(), next( i ).begin() );
+          if ( deltaDecoding ) {
+            next.solutions[i] = curr.solutions[curr.fitness[i].second];
+          }
+          return;
+        }
+        core::counter_rng rng( seed, i );
+        for ( double &key : next( i ) ) {
+          key = rng.uniform();
+        }
+      }
+      if ( !batchDecoding ) {
+        next.setFitness( i, decodeOne( k, next( i ), solutionOf( next, i ) ) );
       }
+    } );
+    if ( batchDecoding ) {
+      decodeBatches( k, next, keep, p );
     }
 
-// Decode:
-#ifdef _OPENMP
-  #pragma omp parallel for num_threads( MAX_THREADS )
-#endif
-    for ( int j = 0; j < int( p ); ++j ) {
-      current[i]->setFitness( j, refDecoder.decode( ( *current[i] )( j ) ) );
+    for ( unsigned i = 0; i < keep; ++i ) {
+      next.fitness[i].first  = curr.fitness[i].first;
+      next.fitness[i].second = i;
     }
 
-    // Sort:
-    current[i]->sortFitness();
+    core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+    next.sortFitness( pe );
   }
 
   template <class Decoder, class RNG>
-  inline void BRKGA<Decoder, RNG>::evolution( Population &curr, Population &next ) {
-    // We now will set every chromosome of 'current', iterating with 'i':
-    unsigned i = 0;  // Iterate chromosome by chromosome
-    unsigned j = 0;  // Iterate allele by allele
+  inline double BRKGA<Decoder, RNG>::decodeOne( unsigned                         k,
+                                                const std::vector<double>       &chromosome,
+                                                std::vector<std::uint8_t>       *solution,
+                                                const std::vector<std::uint8_t> *parent ) {
+    if ( stopRequested( k ) ) {
+      return std::numeric_limits<double>::infinity();  // generation will be discarded
+    }
 
-    // 2. The 'pe' best chromosomes are maintained, so we just copy these into 'current':
-    while ( i < pe ) {
-      for ( j = 0; j < n; ++j ) {
-        next( i, j ) = curr( curr.fitness[i].second, j );
-      }
+    const unsigned           slot     = pool.slot();
+    auto                    &counters = stats.local( slot );
+    core::scoped_timer       timer( counters.elapsed_ns[std::size_t( core::phase::decode )] );
+    core::scoped_perf_region region( &perf, slot, core::perf_region::decode );
 
-      next.fitness[i].first  = curr.fitness[i].first;
-      next.fitness[i].second = i;
-      ++i;
+    if constexpr ( context_decoder<Decoder> ) {
+      decode_context ctx;
+      ctx.perf             = &perf;
+      ctx.thread_slot      = slot;
+      ctx.cancel           = cancel;
+      double fitness       = 0.0;
+      if constexpr ( delta_decoder<Decoder> ) {
+        if ( solution != nullptr && parent != nullptr && !parent->empty() ) {
+          fitness = refDecoder.decode_delta( chromosome, *parent, *solution, ctx );
+        } else if ( solution != nullptr ) {
+          fitness = refDecoder.decode( std::span<const double>( chromosome ), *solution, ctx );
+        } else {
+          fitness = refDecoder.decode( chromosome, ctx );
+        }
+      } else {
+        (void)solution;
+        (void)parent;
+        fitness = refDecoder.decode( chromosome, ctx );
+      }
+      if ( ctx.cancelled ) {
+        aborted[k].store( true, std::memory_order_relaxed );
+        return std::numeric_limits<double>::infinity();
+      }
+      ++counters.evaluations;
+      counters.repair_passes += ctx.repair_passes;
+      counters.delta_evaluations += ctx.incremental;
+      return fitness;
+    } else {
+      ++counters.evaluations;
+      return refDecoder.decode( chromosome );
     }
+  }
 
-    // 3. We'll mate 'p - pe - pm' pairs; initially, i = pe, so we need to iterate until i < p - pm:
-    while ( i < p - pm ) {
-      // Select an elite parent:
-      const unsigned eliteParent = ( refRNG.randInt( pe - 1 ) );
+  template <class Decoder, class RNG>
+  inline std::vector<std::uint8_t> *BRKGA<Decoder, RNG>::solutionOf( Population &pop, unsigned i ) {
+    return deltaDecoding ? &pop.solutions[i] : nullptr;
+  }
 
-      // Select a non-elite parent:
-      const unsigned noneliteParent = pe + ( refRNG.randInt( p - pe - 1 ) );
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::checkSetSizes() const noexcept( false ) {
+    using std::range_error;
+    if ( pe == 0 ) {
+      throw range_error( "Elite-set size equals zero." );
+    }
+    if ( pe > p ) {
+      throw range_error( "Elite-set size greater than population size (pe > p)." );
+    }
+    if ( pm > p ) {
+      throw range_error( "Mutant-set size (pm) greater than population size (p)." );
+    }
+    if ( pe + pm > p ) {
+      throw range_error( "elite + mutant sets greater than population size (p)." );
+    }
+  }
+
+  template <class Decoder, class RNG>
+  inline bool BRKGA<Decoder, RNG>::stopRequested( unsigned k ) {
+    if ( cancel != nullptr && cancel->stop_requested() ) {
+      aborted[k].store( true, std::memory_order_relaxed );
+    }
+    return aborted[k].load( std::memory_order_relaxed );
+  }
 
-      // Mate:
-      for ( j = 0; j < n; ++j ) {
-        const unsigned &sourceParent = ( ( refRNG.rand() < rhoe ) ? eliteParent : noneliteParent );
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::clearAborts() {
+    for ( unsigned k = 0; k < K; ++k ) {
+      aborted[k].store( false, std::memory_order_relaxed );
+    }
+  }
 
-        next( i, j ) = curr( curr.fitness[sourceParent].second, j );
+  template <class Decoder, class RNG>
+  inline bool BRKGA<Decoder, RNG>::anyAborted() const {
+    for ( unsigned k = 0; k < K; ++k ) {
+      if ( aborted[k].load( std::memory_order_relaxed ) ) {
+        return true;
       }
+    }
+    return false;
+  }
+
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::decodeBatches( unsigned    k,
+                                                  Population &pop,
+                                                  unsigned    first,
+                                                  unsigned    last ) {
+    if constexpr ( batch_decoder<Decoder> ) {
+      constexpr std::size_t lanes   = Decoder::BATCH_LANES;
+      const std::size_t     batches = ( last - first + lanes - 1 ) / lanes;
+      pool.parallel_for(
+        0,
+        batches,
+        [&]( std::size_t b ) {
+          if ( stopRequested( k ) ) {
+            return;
+          }
+          const unsigned begin = first + unsigned( b * lanes );
+          const unsigned end   = std::min( last, unsigned( begin + lanes ) );
+
+          std::vector<const std::vector<double> *> chromosomes;
+          chromosomes.reserve( end - begin );
+          for ( unsigned i = begin; i < end; ++i ) {
+            chromosomes.push_back( &pop( i ) );
+          }
+          std::vector<double> fitness( end - begin );
 
-      ++i;
+          const unsigned           slot     = pool.slot();
+          auto                    &counters = stats.local( slot );
+          core::scoped_timer       timer( counters.elapsed_ns[std::size_t( core::phase::decode )] );
+          core::scoped_perf_region region( &perf, slot, core::perf_region::decode );
+
+          decode_context ctx;
+          ctx.perf        = &perf;
+          ctx.thread_slot = slot;
+          ctx.cancel      = cancel;
+          refDecoder.decode_batch( chromosomes, fitness, ctx );
+          if ( ctx.cancelled ) {
+            aborted[k].store( true, std::memory_order_relaxed );
+            return;
+          }
+          counters.evaluations += end - begin;
+          counters.repair_passes += ctx.repair_passes;
+
+          for ( unsigned i = begin; i < end; ++i ) {
+            pop.setFitness( i, fitness[i - begin] );
+          }
+        },
+        1 );
+    } else {
+      (void)k;
+      (void)pop;
+      (void)first;
+      (void)last;
     }
+  }
+
+  template <class Decoder, class RNG>
+  inline std::uint64_t BRKGA<Decoder, RNG>::drawSeed() {
+    const std::uint64_t high = refRNG.randInt();
+    return ( high << 32 ) ^ std::uint64_t( refRNG.randInt() );
+  }
+
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::addWallSince( core::phase_stats::clock::time_point start ) {
+    stats.add_wall( static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>( core::phase_stats::clock::now() - start )
+        .count() ) );
+  }
 
-    // We'll introduce 'pm' mutants:
-    while ( i < p ) {
-      for ( j = 0; j < n; ++j ) {
-        next( i, j ) = refRNG.rand();
+  template <class Decoder, class RNG>
+  inline void BRKGA<Decoder, RNG>::evolution( unsigned      k,
+                                              Population   &curr,
+                                              Population   &next,
+                                              std::uint64_t seed ) {
+    // Every chromosome i of 'next' is built and decoded by one task. Offspring i draws its random
+    // numbers from stream (seed, i), so any thread may build it:
+    pool.parallel_for( 0, p, [&]( std::size_t idx ) {
+      if ( stopRequested( k ) ) {
+        return;  // the whole generation is being dropped
       }
-      ++i;
+
+      const auto                       i      = unsigned( idx );
+      const unsigned                   slot   = pool.slot();
+      const std::vector<std::uint8_t> *parent = nullptr;  // elite parent's solution (delta only)
+      {
+        core::scoped_timer       timer( stats.elapsed( slot, core::phase::crossover ) );
+        core::scoped_perf_region region( &perf, slot, core::perf_region::crossover );
+
+        if ( i < pe ) {
+          // 2. The 'pe' best chromosomes are maintained, so we just copy these into 'next':
+          const std::vector<double> &elite = curr( curr.fitness[i].second );
+          std::copy( elite.begin(), elite.end(), next( i ).begin() );
+          if ( !deltaDecoding ) {
+            return;
+          }
+          next.solutions[i] = curr.solutions[curr.fitness[i].second];
+          if ( !next.solutions[i].empty() ) {
+            return;
+          }
+        } else if ( i < p - pm ) {
+          // 3. Mate: select an elite parent and a non-elite parent
+          core::counter_rng rng( seed, i );
+          const unsigned    eliteParent    = unsigned( rng.below_or_equal( pe - 1 ) );
+          const unsigned    noneliteParent = pe + unsigned( rng.below_or_equal( p - pe - 1 ) );
+
+          const std::vector<double> &elite    = curr( curr.fitness[eliteParent].second );
+          const std::vector<double> &nonelite = curr( curr.fitness[noneliteParent].second );
+          std::vector<double>       &child    = next( i );
+          for ( unsigned j = 0; j < n; ++j ) {
+            child[j] = ( rng.uniform() < rhoe ) ? elite[j] : nonelite[j];
+          }
+          if ( deltaDecoding ) {
+            parent = &curr.solutions[curr.fitness[eliteParent].second];
+          }
+        } else {
+          // The last 'pm' chromosomes are mutants:
+          core::counter_rng rng( seed, i );
+          for ( double &key : next( i ) ) {
+            key = rng.uniform();
+          }
+        }
+      }
+
+      if ( i < pe ) {
+        // An elite whose solution is unknown (decoded before setDeltaDecoding(), or injected) is
+        // decoded once so that its offspring can start from it; its fitness is kept as is:
+        (void)decodeOne( k, next( i ), &next.solutions[i] );
+        return;
+      }
+
+      // Time to compute fitness, in parallel:
+      if ( !batchDecoding ) {
+        next.setFitness( i, decodeOne( k, next( i ), solutionOf( next, i ), parent ) );
+      }
+    } );
+    if ( batchDecoding ) {
+      decodeBatches( k, next, pe, p );
+    }
+    if ( aborted[k].load( std::memory_order_relaxed ) ) {
+      return;
     }
 
-// Time to compute fitness, in parallel:
-#ifdef _OPENMP
-  #pragma omp parallel for num_threads( MAX_THREADS )
-#endif
-    for ( int i = int( pe ); i < int( p ); ++i ) {
-      next.setFitness( i, refDecoder.decode( next.population[i] ) );
+    for ( unsigned i = 0; i < pe; ++i ) {
+      next.fitness[i].first  = curr.fitness[i].first;
+      next.fitness[i].second = i;
     }
 
-    // Now we must sort 'current' by fitness, since things might have changed:
-    next.sortFitness();
+    // Now we must rank 'current' by fitness, since things might have changed. Only the elite
+    // set and the elite/non-elite split matter for the next generation:
+    core::scoped_timer timer( stats.elapsed( pool.slot(), core::phase::sort ) );
+    next.sortFitness( pe );
   }
 
   template <class Decoder, class RNG>
@@ -1,68 +1,390 @@
 #pragma once
+#include "../../core/batch_eval.hpp"
+#include "../../core/compressed_graph.hpp"
+#include "../../core/csr_graph.hpp"
 #include "../../core/graph.hpp"
+#include "../../core/thread_pool.hpp"
+#include "decode_context.hpp"
 
-#include <boost/graph/detail/adjacency_list.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace r3dp::brkga {
-  class R3DPDecoder {
+  /**
+   * Decodificador da dominação {3}-romana: quantiza cada gene em um rótulo 0..3 e repara a
+   * solução até que todo vértice de rótulo 0 tenha soma na vizinhança >= 3 e todo vértice de
+   * rótulo 1 tenha soma >= 2. O fitness é a soma dos rótulos.
+   *
+   * Com decode_threads > 1 uma única decodificação é paralelizada (útil para grafos muito grandes,
+   * em que p pequeno não ocupa a máquina): quantização e soma dos rótulos em blocos, e reparo por
+   * classes de cor. Vértices de uma mesma classe não são vizinhos, então seus rótulos sobem em
+   * paralelo sem corrida nas somas de vizinhança. Cada varredura visita as classes em ordem, o
+   * que equivale à varredura sequencial na ordem `classes.order` em vez de 0..n-1: o resultado é
+   * determinístico e não depende do número de threads, mas pode diferir do modo sequencial.
+   *
+   * `decode_batch` decodifica até BATCH_LANES cromossomos de uma vez em planos de bits (ver
+   * core::label_batch): cada varredura da adjacência repara todas as pistas, e o resultado de cada
+   * pista é idêntico ao de `decode` sequencial.
+   *
+   * `decode_delta` parte da solução reparada de um cromossomo parecido (ex.: o pai de elite de um
+   * filho). Fora dos vértices cujo rótulo quantizado difere do pai (D) e dos seus vizinhos, os
+   * rótulos e as somas são os do pai, que é viável; e o reparo só sobe rótulos, então um vértice
+   * satisfeito nunca volta a ser violado. A varredura sequencial equivale, portanto, a varrer em
+   * ordem só os vértices violados de D ∪ N(D): o resultado é idêntico ao de `decode`, com custo
+   * de uma passada pelos genes mais O(|D| · grau²) em vez de O(n + m) por varredura.
+   *
+   * Graph é qualquer representação com core::vertex_count e core::neighbors (graph_t, csr_graph,
+   * compressed_graph).
+   */
+  template <core::adjacency_graph Graph>
+  class basic_r3dp_decoder {
   private:
-    const core::graph_t &graph;
+    // Abaixo disso a tarefa não compensa o custo de distribuí-la entre as threads
+    static constexpr std::size_t PARALLEL_GRAIN = 4096;
+
+    // Vértices reparados entre duas consultas ao pedido de cancelamento (potência de 2)
+    static constexpr std::size_t CANCEL_CHECK_INTERVAL = 4096;
+
+    const Graph &graph;
+
+    // Modo paralelo: pool próprio e coloração calculada uma única vez
+    std::unique_ptr<core::thread_pool> pool;
+    core::color_classes                classes;
 
   public:
-    explicit R3DPDecoder( const core::graph_t &g ) : graph( g ) {}
+    static constexpr std::size_t BATCH_LANES = core::label_batch<>::lanes;
+
+    explicit basic_r3dp_decoder( const Graph &g, unsigned decode_threads = 1 ) : graph( g ) {
+      if ( decode_threads > 1 ) {
+        pool    = std::make_unique<core::thread_pool>( decode_threads );
+        classes = core::greedy_color_classes( graph );
+      }
+    }
+
+    [[nodiscard]] unsigned decode_threads() const noexcept {
+      return pool ? pool->size() : 1;
+    }
 
     [[nodiscard]] double decode( const std::vector<double> &chromosome ) const {
-      const auto           size = boost::num_vertices( graph );
-      std::vector<uint8_t> solution( size );
+      decode_context ctx;
+      return decode( chromosome, ctx );
+    }
+
+    // Mesma decodificação, registrando em ctx o número de varreduras de reparo executadas. O
+    // reparo para no meio se ctx.cancel disparar (ctx.cancelled indica que o fitness é inválido)
+    [[nodiscard]] double decode( const std::vector<double> &chromosome, decode_context &ctx ) const {
+      std::vector<uint8_t> solution;
+      return decode( std::span<const double>( chromosome ), solution, ctx );
+    }
+
+    // Decodifica qualquer sequência contígua de genes (ex.: uma linha de matriz) usando `solution`
+    // como espaço de trabalho; quem chama com frequência reaproveita o buffer entre chamadas. Ao
+    // final (sem cancelamento) `solution` guarda os rótulos reparados
+    [[nodiscard]] double decode( std::span<const double> chromosome,
+                                 std::vector<uint8_t>   &solution,
+                                 decode_context         &ctx ) const {
+      ctx.repair_passes = 0;
+      ctx.cancelled     = false;
 
-      for ( double gene : chromosome ) {
-        uint8_t mapped = static_cast<uint8_t>( std::min( static_cast<int>( gene * 4.0 ), 3 ) );
-        solution.push_back( mapped );
+      solution.resize( core::vertex_count( graph ) );
+      quantize( chromosome, solution );
+      {
+        core::scoped_perf_region repair_region(
+          ctx.perf, ctx.thread_slot, core::perf_region::repair );
+        if ( pool ) {
+          repair_by_color( solution, ctx );
+        } else {
+          repair_sequential( solution, ctx );
+        }
+      }
+
+      return static_cast<double>( sum_of_labels( solution ) );
+    }
+
+    // Mesmo resultado de decode( chromosome, solution, ctx ), partindo de `parent`, a solução
+    // reparada de outro cromossomo. Volta ao reparo completo (ctx.incremental fica false) no modo
+    // paralelo, sem `parent` ou quando os dois diferem demais
+    [[nodiscard]] double decode_delta( std::span<const double>       chromosome,
+                                       std::span<const std::uint8_t> parent,
+                                       std::vector<uint8_t>         &solution,
+                                       decode_context               &ctx ) const {
+      const std::size_t n = core::vertex_count( graph );
+      ctx.incremental     = false;
+      if ( pool || parent.size() != n ) {
+        return decode( chromosome, solution, ctx );
+      }
+      ctx.repair_passes = 0;
+      ctx.cancelled     = false;
+
+      // Quantização, soma dos rótulos e D numa só passada. Se D ∪ N(D), contado com repetições,
+      // passar de n vértices, conferir os candidatos já custa tanto quanto varrer o grafo
+      const std::size_t           limit = n;
+      std::vector<core::vertex_t> candidates;
+      std::uint64_t               total = 0;
+      solution.resize( n );
+      for ( std::size_t v = 0; v < n; ++v ) {
+        solution[v] = label_of( chromosome[v] );
+        total += solution[v];
+        if ( solution[v] != parent[v] && candidates.size() <= limit ) {
+          candidates.push_back( static_cast<core::vertex_t>( v ) );
+        }
+      }
+
+      core::scoped_perf_region repair_region(
+        ctx.perf, ctx.thread_slot, core::perf_region::repair );
+      const std::size_t changed = candidates.size();
+      for ( std::size_t k = 0; k < changed && candidates.size() <= limit; ++k ) {
+        for ( auto w : core::neighbors( graph, candidates[k] ) ) {
+          candidates.push_back( static_cast<core::vertex_t>( w ) );
+        }
       }
+      if ( candidates.size() > limit ) {
+        repair_sequential( solution, ctx );
+        return static_cast<double>( sum_of_labels( solution ) );
+      }
+
+      // Só os violados agora podem subir, e na ordem da varredura sequencial
+      std::sort( candidates.begin(), candidates.end() );
+      candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+      std::erase_if( candidates, [&]( core::vertex_t u ) { return satisfied( u, solution ); } );
+
       bool has_violations = true;
       while ( has_violations ) {
         has_violations = false;
+        ++ctx.repair_passes;
+        for ( std::size_t k = 0; k < candidates.size(); ++k ) {
+          if ( k % CANCEL_CHECK_INTERVAL == 0 && ctx.should_stop() ) {
+            return static_cast<double>( total );
+          }
+          const uint8_t before = solution[candidates[k]];
+          if ( repair_vertex( candidates[k], solution ) ) {
+            total += solution[candidates[k]] - before;
+            has_violations = true;
+          }
+        }
+      }
+      ctx.incremental = true;
+      return static_cast<double>( total );
+    }
 
-        auto vertices = boost::vertices( graph );
-        for ( auto v_it = vertices.first; v_it != vertices.second; ++v_it ) {
-          core::vertex_t u = *v_it;
+    // Decodifica em lotes de BATCH_LANES; ctx.repair_passes soma as varreduras de cada cromossomo
+    void decode_batch( std::span<const std::vector<double> *const> chromosomes,
+                       std::span<double>                           fitness,
+                       decode_context                             &ctx ) const {
+      ctx.repair_passes = 0;
+      ctx.cancelled     = false;
+      for ( std::size_t first = 0; first < chromosomes.size() && !ctx.cancelled;
+            first += BATCH_LANES ) {
+        const std::size_t count = std::min( BATCH_LANES, chromosomes.size() - first );
+        decode_lanes( chromosomes.subspan( first, count ), fitness.subspan( first, count ), ctx );
+      }
+    }
 
-          if ( solution[u] == 0 ) {
-            int  neighbor_sum = 0;
-            auto neighbors    = boost::adjacent_vertices( u, graph );
-            for ( auto n_it = neighbors.first; n_it != neighbors.second; ++n_it ) {
-              neighbor_sum += solution[*n_it];
-            }
+    // Rótulo (antes do reparo) que o gene representa: faixas de 1/4 em [0, 1]
+    static uint8_t label_of( double gene ) noexcept {
+      return static_cast<uint8_t>( std::min( static_cast<int>( gene * 4.0 ), 3 ) );
+    }
 
-            if ( neighbor_sum < 3 ) {
-              solution[u]    = 1;
-              has_violations = true;
-            }
+  private:
+    void quantize( std::span<const double> chromosome, std::vector<uint8_t> &solution ) const {
+      if ( pool ) {
+        pool->parallel_for(
+          0,
+          solution.size(),
+          [&]( std::size_t v ) { solution[v] = label_of( chromosome[v] ); },
+          PARALLEL_GRAIN );
+        return;
+      }
+      for ( std::size_t v = 0; v < solution.size(); ++v ) {
+        solution[v] = label_of( chromosome[v] );
+      }
+    }
+
+    bool satisfied( core::vertex_t u, const std::vector<uint8_t> &solution ) const {
+      if ( solution[u] >= 2 ) {
+        return true;
+      }
+      int neighbor_sum = 0;
+      for ( auto w : core::neighbors( graph, u ) ) {
+        neighbor_sum += solution[w];
+      }
+      return neighbor_sum >= 3 - solution[u];
+    }
+
+    // Aplica as regras de reparo em u; retorna true se o rótulo de u subiu
+    bool repair_vertex( core::vertex_t u, std::vector<uint8_t> &solution ) const {
+      if ( solution[u] >= 2 ) {
+        return false;
+      }
+
+      // A soma só depende dos vizinhos, então vale para as duas regras
+      int neighbor_sum = 0;
+      for ( auto w : core::neighbors( graph, u ) ) {
+        neighbor_sum += solution[w];
+      }
+
+      bool raised = false;
+      if ( solution[u] == 0 && neighbor_sum < 3 ) {
+        solution[u] = 1;
+        raised      = true;
+      }
+      if ( solution[u] == 1 && neighbor_sum < 2 ) {
+        solution[u] = 2;
+        raised      = true;
+      }
+      return raised;
+    }
+
+    void repair_sequential( std::vector<uint8_t> &solution, decode_context &ctx ) const {
+      bool has_violations = true;
+      while ( has_violations ) {
+        has_violations = false;
+        ++ctx.repair_passes;
+
+        const auto n = core::vertex_count( graph );
+        for ( std::size_t u = 0; u < n; ++u ) {
+          if ( u % CANCEL_CHECK_INTERVAL == 0 && ctx.should_stop() ) {
+            return;
           }
+          has_violations |= repair_vertex( static_cast<core::vertex_t>( u ), solution );
+        }
+      }
+    }
 
-          if ( solution[u] == 1 ) {
-            int  neighbor_sum = 0;
-            auto neighbors    = boost::adjacent_vertices( u, graph );
-            for ( auto n_it = neighbors.first; n_it != neighbors.second; ++n_it ) {
-              neighbor_sum += solution[*n_it];
-            }
+    void repair_by_color( std::vector<uint8_t> &solution, decode_context &ctx ) const {
+      bool has_violations = true;
+      while ( has_violations ) {
+        has_violations = false;
+        ++ctx.repair_passes;
 
-            if ( neighbor_sum < 2 ) {
-              solution[u]    = 2;
-              has_violations = true;
+        for ( std::size_t c = 0; c < classes.count(); ++c ) {
+          if ( ctx.should_stop() ) {
+            return;
+          }
+          std::atomic<bool> raised{ false };
+          pool->parallel_for(
+            classes.offsets[c],
+            classes.offsets[c + 1],
+            [&]( std::size_t k ) {
+              if ( repair_vertex( classes.order[k], solution ) &&
+                   !raised.load( std::memory_order_relaxed ) ) {
+                raised.store( true, std::memory_order_relaxed );
+              }
+            },
+            PARALLEL_GRAIN );
+          has_violations |= raised.load( std::memory_order_relaxed );
+        }
+      }
+    }
+
+    void decode_lanes( std::span<const std::vector<double> *const> chromosomes,
+                       std::span<double>                           fitness,
+                       decode_context                             &ctx ) const {
+      constexpr std::size_t W = core::batch_words;
+      const std::size_t     n = core::vertex_count( graph );
+
+      // Transposição: o gene v de cada cromossomo vira um bit dos planos do vértice v
+      core::label_batch<W> batch( n );
+      for ( std::size_t v = 0; v < n; ++v ) {
+        auto &low  = batch.low_bits( v );
+        auto &high = batch.high_bits( v );
+        for ( std::size_t lane = 0; lane < chromosomes.size(); ++lane ) {
+          const std::uint64_t label = label_of( ( *chromosomes[lane] )[v] );
+          low[lane / 64] |= ( label & 1U ) << ( lane % 64 );
+          high[lane / 64] |= ( label >> 1 ) << ( lane % 64 );
+        }
+      }
+
+      core::scoped_perf_region repair_region(
+        ctx.perf, ctx.thread_slot, core::perf_region::repair );
+
+      // Mesmas regras de repair_vertex, aplicadas a todas as pistas ativas de uma vez. Uma pista
+      // sai de 'active' após uma varredura sem mudanças, como o laço sequencial.
+      core::lane_mask<W> active = core::first_lanes<W>( chromosomes.size() );
+      while ( core::any( active ) ) {
+        ctx.repair_passes += core::popcount( active );
+
+        core::lane_mask<W> changed{};
+        for ( std::size_t u = 0; u < n; ++u ) {
+          if ( u % CANCEL_CHECK_INTERVAL == 0 && ctx.should_stop() ) {
+            return;
+          }
+          auto &low  = batch.low_bits( u );
+          auto &high = batch.high_bits( u );
+
+          core::lane_mask<W> open;  // pistas ativas com rótulo 0 ou 1
+          for ( std::size_t w = 0; w < W; ++w ) {
+            open[w] = ~high[w] & active[w];
+          }
+          if ( !core::any( open ) ) {
+            continue;
+          }
+
+          core::saturating_sum<W> sum;
+          for ( auto w : core::neighbors( graph, static_cast<core::vertex_t>( u ) ) ) {
+            if ( !core::any( core::masked( open, sum.below_three() ) ) ) {
+              break;  // toda pista aberta já tem soma >= 3: nenhuma regra se aplica
             }
+            sum.add( batch.low_bits( w ), batch.high_bits( w ) );
+          }
+
+          const auto below_two   = sum.below_two();
+          const auto below_three = sum.below_three();
+          for ( std::size_t w = 0; w < W; ++w ) {
+            const std::uint64_t to_two = open[w] & below_two[w];  // 0 ou 1 com soma < 2
+            const std::uint64_t to_one = open[w] & ~low[w] & below_three[w] & ~below_two[w];
+            high[w] |= to_two;
+            low[w]   = ( low[w] & ~to_two ) | to_one;
+            changed[w] |= to_two | to_one;
           }
         }
+        active = changed;
       }
 
-      double sum_of_labels = 0.0;
-      for ( uint8_t label : solution ) {
-        sum_of_labels += static_cast<double>( label );
+      const auto weights = core::batch_weights( batch );
+      for ( std::size_t lane = 0; lane < fitness.size(); ++lane ) {
+        fitness[lane] = static_cast<double>( weights[lane] );
       }
+    }
 
-      return sum_of_labels;
+    std::uint64_t sum_of_labels( const std::vector<uint8_t> &solution ) const {
+      if ( !pool ) {
+        std::uint64_t sum = 0;
+        for ( uint8_t label : solution ) {
+          sum += label;
+        }
+        return sum;
+      }
+
+      // Somas parciais por bloco, combinadas em ordem fixa
+      const std::size_t          blocks = ( solution.size() + PARALLEL_GRAIN - 1 ) / PARALLEL_GRAIN;
+      std::vector<std::uint64_t> partial( blocks, 0 );
+      pool->parallel_for(
+        0,
+        blocks,
+        [&]( std::size_t b ) {
+          const std::size_t end = std::min( solution.size(), ( b + 1 ) * PARALLEL_GRAIN );
+          std::uint64_t     sum = 0;
+          for ( std::size_t v = b * PARALLEL_GRAIN; v < end; ++v ) {
+            sum += solution[v];
+          }
+          partial[b] = sum;
+        },
+        1 );
+
+      std::uint64_t sum = 0;
+      for ( std::uint64_t block_sum : partial ) {
+        sum += block_sum;
+      }
+      return sum;
     }
   };
 
+  using R3DPDecoder           = basic_r3dp_decoder<core::graph_t>;
+  using CsrR3DPDecoder        = basic_r3dp_decoder<core::csr_graph>;
+  using CompressedR3DPDecoder = basic_r3dp_decoder<core::compressed_graph>;
+
 }  // namespace r3dp::brkga
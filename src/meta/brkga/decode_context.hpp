@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../../core/cancellation.hpp"
+#include "../../core/perf_counters.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace r3dp::brkga {
+  /**
+   * Per-thread state handed to decoders that accept it (see BRKGA::decodeOne).
+   * Decoders report their own work counters here; BRKGA folds them into its phase statistics.
+   */
+  struct decode_context {
+    std::uint64_t        repair_passes = 0;        // repair sweeps (summed over a batch)
+    core::perf_recorder *perf          = nullptr;  // hardware counters for sub-regions (optional)
+    unsigned             thread_slot   = 0;        // slot of the calling thread in 'perf'
+
+    // Cooperative cancellation: decoders poll 'cancel' periodically and, once it fires, stop early
+    // and set 'cancelled'. The fitness returned by a cancelled decode is meaningless.
+    const core::cancellation_token *cancel    = nullptr;
+    bool                            cancelled = false;
+
+    bool incremental = false;  // set by decode_delta when it did not fall back to a full decode
+
+    [[nodiscard]] bool should_stop() {
+      if ( !cancelled && cancel != nullptr && cancel->stop_requested() ) {
+        cancelled = true;
+      }
+      return cancelled;
+    }
+  };
+
+  /**
+   * True when Decoder offers the `decode( chromosome, decode_context & )` overload.
+   */
+  template <class Decoder>
+  concept context_decoder =
+    requires( const Decoder &d, const std::vector<double> &chr, decode_context &ctx ) {
+      { d.decode( chr, ctx ) } -> std::convertible_to<double>;
+    };
+
+  /**
+   * True when Decoder can also decode up to BATCH_LANES chromosomes in one call, writing their
+   * fitness in order: `decode_batch( chromosomes, fitness, decode_context & )`.
+   */
+  template <class Decoder>
+  concept batch_decoder = requires( const Decoder                            &d,
+                                    std::span<const std::vector<double> *const> chromosomes,
+                                    std::span<double>                           fitness,
+                                    decode_context                             &ctx ) {
+    { Decoder::BATCH_LANES } -> std::convertible_to<std::size_t>;
+    d.decode_batch( chromosomes, fitness, ctx );
+  };
+
+  /**
+   * True when Decoder can keep the solution it decodes (`decode( chromosome, solution, ctx )`)
+   * and decode a chromosome starting from the solution of a similar one, with the same result:
+   * `decode_delta( chromosome, parent_solution, solution, ctx )`.
+   */
+  template <class Decoder>
+  concept delta_decoder = requires( const Decoder                &d,
+                                    std::span<const double>       chromosome,
+                                    std::span<const std::uint8_t> parent,
+                                    std::vector<std::uint8_t>    &solution,
+                                    decode_context               &ctx ) {
+    { d.decode( chromosome, solution, ctx ) } -> std::convertible_to<double>;
+    { d.decode_delta( chromosome, parent, solution, ctx ) } -> std::convertible_to<double>;
+  };
+
+  /**
+   * True when Decoder maps every key to a discrete label through a static `label_of( key )`.
+   * BRKGA then measures population diversity on those labels instead of on the raw keys.
+   */
+  template <class Decoder>
+  concept quantizing_decoder = requires( double key ) {
+    { Decoder::label_of( key ) } -> std::convertible_to<unsigned>;
+  };
+}  // namespace r3dp::brkga
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../../core/counter_rng.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace r3dp::brkga {
+  /**
+   * Which islands an island sends its elite to (see BRKGA::setMigrationTopology):
+   *  - all_to_all: every other island (the original BRKGA exchange);
+   *  - ring: the next island, (k + 1) mod K;
+   *  - torus: the four neighbours on a rows x cols grid with wrap-around, rows being the largest
+   *    divisor of K not above sqrt(K) (a prime K degenerates into a two-way ring);
+   *  - random: one other island drawn anew at every migration;
+   *  - hypercube: the islands whose index differs from k in one bit (those below K).
+   */
+  enum class migration_topology { all_to_all, ring, torus, random, hypercube };
+
+  inline const char *migration_topology_name( migration_topology topology ) noexcept {
+    switch ( topology ) {
+      case migration_topology::all_to_all: return "all-to-all";
+      case migration_topology::ring      : return "ring";
+      case migration_topology::torus     : return "torus";
+      case migration_topology::random    : return "random";
+      case migration_topology::hypercube : return "hypercube";
+    }
+    return "unknown";
+  }
+
+  inline migration_topology parse_migration_topology( std::string_view name ) {
+    for ( auto topology : { migration_topology::all_to_all,
+                            migration_topology::ring,
+                            migration_topology::torus,
+                            migration_topology::random,
+                            migration_topology::hypercube } ) {
+      if ( name == migration_topology_name( topology ) ) {
+        return topology;
+      }
+    }
+    throw std::invalid_argument( "Unknown migration topology: " + std::string( name ) );
+  }
+
+  /**
+   * Islands that island k of K sends migrants to, in increasing order and without k itself.
+   * 'rng' is only drawn from by the random topology.
+   */
+  inline std::vector<unsigned> migration_targets( migration_topology topology,
+                                                  unsigned           k,
+                                                  unsigned           K,
+                                                  core::counter_rng &rng ) {
+    std::vector<unsigned> targets;
+    if ( K < 2 ) {
+      return targets;
+    }
+    switch ( topology ) {
+      case migration_topology::all_to_all:
+        for ( unsigned j = 0; j < K; ++j ) {
+          if ( j != k ) {
+            targets.push_back( j );
+          }
+        }
+        break;
+      case migration_topology::ring: targets.push_back( ( k + 1 ) % K ); break;
+      case migration_topology::torus: {
+        unsigned rows = 1;
+        for ( unsigned r = 1; r * r <= K; ++r ) {
+          if ( K % r == 0 ) {
+            rows = r;
+          }
+        }
+        const unsigned cols = K / rows;
+        const unsigned row  = k / cols;
+        const unsigned col  = k % cols;
+        targets             = { ( ( row + rows - 1 ) % rows ) * cols + col,
+                                ( ( row + 1 ) % rows ) * cols + col,
+                                row * cols + ( col + cols - 1 ) % cols,
+                                row * cols + ( col + 1 ) % cols };
+        break;
+      }
+      case migration_topology::random: {
+        const unsigned j = unsigned( rng.below_or_equal( K - 2 ) );
+        targets.push_back( j < k ? j : j + 1 );
+        break;
+      }
+      case migration_topology::hypercube:
+        for ( unsigned bit = 1; bit < K; bit <<= 1 ) {
+          if ( ( k ^ bit ) < K ) {
+            targets.push_back( k ^ bit );
+          }
+        }
+        break;
+    }
+    std::sort( targets.begin(), targets.end() );
+    targets.erase( std::unique( targets.begin(), targets.end() ), targets.end() );
+    std::erase( targets, k );
+    return targets;
+  }
+
+  /**
+   * Migrants exchanged through the asynchronous buffers (see BRKGA::setAsyncMigration), summed
+   * over the islands.
+   */
+  struct migration_stats {
+    std::uint64_t sent     = 0;  // chromosomes placed in a buffer
+    std::uint64_t dropped  = 0;  // chromosomes not sent because the buffer was still full
+    std::uint64_t received = 0;  // chromosomes taken into a population
+  };
+}  // namespace r3dp::brkga
@@ -7,7 +7,10 @@
 
 namespace r3dp::brkga {
   Population::Population( const Population &pop )
-    : population( pop.population ), fitness( pop.fitness ) {}
+    : population( pop.population )
+    , fitness( pop.fitness )
+    , solutions( pop.solutions )
+    , ranked( pop.ranked ) {}
 
   Population::Population( const unsigned n, const unsigned p )
     : population( p, std::vector<double>( n, 0.0 ) ), fitness( p ) {
@@ -42,6 +45,10 @@ namespace r3dp::brkga {
     return fitness[i].first;
   }
 
+  unsigned Population::getRanked() const {
+    return ranked;
+  }
+
   const std::vector<double> &Population::getChromosome( unsigned i ) const {
 #ifdef RANGECHECK
     if ( i >= getP() ) {
@@ -69,6 +76,44 @@ namespace r3dp::brkga {
 
   void Population::sortFitness() {
     sort( fitness.begin(), fitness.end() );
+    ranked = getP();
+  }
+
+  void Population::sortFitness( unsigned top ) {
+    if ( top >= getP() ) {
+      sortFitness();
+      return;
+    }
+
+    // O(p) selection of the split, then O(top log top) to order the leading ranks:
+    const auto middle = fitness.begin() + top;
+    std::nth_element( fitness.begin(), middle, fitness.end() );
+    std::sort( fitness.begin(), middle );
+    ranked = top;
+  }
+
+  void Population::gatherWorst( unsigned count ) {
+    // Everything past the ranked prefix is worse than it, so when the last 'count' ranks reach
+    // into the prefix they already hold the worst; otherwise select among the unranked ones:
+    if ( count == 0 || count >= getP() || getP() - count <= ranked ) {
+      return;
+    }
+    std::nth_element( fitness.begin() + ranked, fitness.end() - count, fitness.end() );
+  }
+
+  void Population::promote( unsigned i ) {
+    if ( i < ranked || ranked == 0 ) {
+      return;
+    }
+
+    const auto entry = fitness[i];
+    if ( !( entry < fitness[ranked - 1] ) ) {
+      return;  // Not better than the last ranked entry: stays among the unranked ones
+    }
+
+    // Insert it at its sorted position; the old last ranked entry slides to rank 'ranked':
+    const auto pos = std::upper_bound( fitness.begin(), fitness.begin() + ranked, entry );
+    std::rotate( pos, fitness.begin() + i, fitness.begin() + i + 1 );
   }
 
   double &Population::operator()( unsigned chromosome, unsigned allele ) {
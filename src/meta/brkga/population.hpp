@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 namespace r3dp::brkga {
@@ -11,17 +12,23 @@ namespace r3dp::brkga {
     unsigned getN() const;  // Size of each chromosome
     unsigned getP() const;  // Size of population
 
-    // These methods REQUIRE fitness to be sorted, and thus a call to sortFitness() beforehand
+    // These methods REQUIRE fitness to be ranked, and thus a call to sortFitness() beforehand
     // (this is done by BRKGA, so rest assured: everything will work just fine with BRKGA).
+    // Only the first getRanked() ranks are guaranteed to be in order; BRKGA keeps at least the
+    // elite set ranked, and every rank below getRanked() is worse than all the ranked ones, in no
+    // particular order (BRKGA calls gatherWorst() before overwriting the last ranks).
     // Returns the best fitness in this population:
     double getBestFitness() const;
 
     // Returns the fitness of chromosome i \in {0, ..., getP() - 1}
     double getFitness( unsigned i ) const;
 
-    // Returns (i+1)-th best chromosome, where i = 0 is the best and i = getP() - 1 is the worst:
+    // Returns the chromosome at rank i, where i = 0 is the best (the (i+1)-th best for ranked i):
     const std::vector<double> &getChromosome( unsigned i ) const;
 
+    // Returns how many leading ranks are in sorted order:
+    unsigned getRanked() const;
+
   private:
     Population( const Population &other );
     Population( unsigned n, unsigned p );
@@ -29,8 +36,14 @@ namespace r3dp::brkga {
 
     std::vector<std::vector<double>>         population;  // Population as vectors of prob.
     std::vector<std::pair<double, unsigned>> fitness;     // Fitness (double) of a each chromosome
-
-    void                 sortFitness();  // Sorts 'fitness' by its first parameter
+    std::vector<std::vector<std::uint8_t>>   solutions;   // Decoded solution of each chromosome
+                                                          // (delta decoding only; empty: unknown)
+    unsigned ranked = 0;  // Leading entries of 'fitness' known to be sorted
+
+    void sortFitness();                  // Sorts 'fitness' by its first parameter
+    void sortFitness( unsigned top );    // Sorts only the 'top' best, leaving the rest behind them
+    void promote( unsigned i );          // Moves rank i (>= getRanked()) into the ranked prefix
+    void gatherWorst( unsigned count );  // Puts the 'count' worst in the last ranks (any order)
     void                 setFitness( unsigned i, double f );  // Sets the fitness of chromosome i
     std::vector<double> &getChromosome( unsigned i );         // Returns a chromosome
 
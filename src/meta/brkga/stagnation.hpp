@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace r3dp::brkga {
+  /**
+   * When an island counts as stagnated and how much of it survives the restart
+   * (see BRKGA::restart). A criterion set to 0 is disabled.
+   */
+  struct restart_policy {
+    unsigned stall_generations = 0;    // generations without improving the island's best
+    double   diversity_floor   = 0.0;  // BRKGA::getDiversity(k) below this (and no improvement)
+    double   keep_fraction     = 0.0;  // fraction kept by a restart (0 = the elite set)
+
+    [[nodiscard]] bool enabled() const noexcept {
+      return stall_generations > 0 || diversity_floor > 0.0;
+    }
+
+    [[nodiscard]] bool uses_diversity() const noexcept {
+      return diversity_floor > 0.0;
+    }
+
+    // Chromosomes kept from a population of p with an elite set of pe
+    [[nodiscard]] unsigned keep( unsigned p, unsigned pe ) const noexcept {
+      if ( keep_fraction <= 0.0 ) {
+        return pe;
+      }
+      return std::clamp( unsigned( keep_fraction * p ), 1u, p );
+    }
+  };
+
+  enum class stagnation_reason { stall, diversity };
+
+  inline const char *stagnation_reason_name( stagnation_reason reason ) noexcept {
+    return reason == stagnation_reason::stall ? "stall" : "diversity";
+  }
+
+  struct stagnated_island {
+    unsigned          island;
+    stagnation_reason reason;
+  };
+
+  /**
+   * Tracks, per island, the best fitness and the generation in which it last improved (or was
+   * restarted). An island stagnates after policy.stall_generations generations without
+   * improvement, or when its diversity falls below policy.diversity_floor in a generation that
+   * did not improve it. Restarting an island starts its stall window over.
+   */
+  class stagnation_monitor {
+  public:
+    stagnation_monitor( unsigned islands, const restart_policy &_policy )
+      : policy( _policy ), best( islands, 0.0 ), since( islands, 0 ), started( islands, false ) {}
+
+    /**
+     * Called after 'generation' with each island's best fitness and, if the policy uses it, its
+     * diversity (otherwise 'diversity' may be empty). Returns the islands to restart.
+     */
+    std::vector<stagnated_island> check( unsigned                generation,
+                                         std::span<const double> island_best,
+                                         std::span<const double> diversity ) {
+      std::vector<stagnated_island> stagnated;
+      for ( unsigned k = 0; k < best.size(); ++k ) {
+        if ( !started[k] || island_best[k] < best[k] ) {
+          best[k]    = island_best[k];
+          since[k]   = generation;
+          started[k] = true;
+          continue;
+        }
+
+        const unsigned idle = generation - since[k];
+        if ( policy.stall_generations > 0 && idle >= policy.stall_generations ) {
+          stagnated.push_back( { k, stagnation_reason::stall } );
+        } else if ( policy.uses_diversity() && !diversity.empty() &&
+                    diversity[k] < policy.diversity_floor ) {
+          stagnated.push_back( { k, stagnation_reason::diversity } );
+        }
+      }
+      return stagnated;
+    }
+
+    // The island was restarted after 'generation': its stall window starts over
+    void restarted( unsigned island, unsigned generation ) {
+      since[island] = generation;
+    }
+
+  private:
+    restart_policy        policy;
+    std::vector<double>   best;
+    std::vector<unsigned> since;    // generation of the last improvement or restart
+    std::vector<bool>     started;  // 'best' holds a value
+  };
+}  // namespace r3dp::brkga
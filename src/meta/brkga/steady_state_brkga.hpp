@@ -0,0 +1,339 @@
+#pragma once
+
+#include "../../core/cancellation.hpp"
+#include "../../core/phase_timer.hpp"
+#include "../../core/thread_pool.hpp"
+#include "decode_context.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace r3dp::brkga {
+  /**
+   * Asynchronous steady-state variant of BRKGA.
+   *
+   * There are no generations: every worker thread repeatedly picks an elite and a non-elite
+   * parent from the shared ranked population, builds one offspring (or a mutant), decodes it and
+   * inserts it in place of the current worst if it is better. Workers only synchronize on a short
+   * critical section to read parents and to insert, so a slow decode never holds the others back.
+   *
+   * The parameters mean the same as in BRKGA; a new individual is a mutant with probability
+   * pm / (p - pe), matching the mutant share of the offspring produced by one BRKGA generation.
+   * The workers belong to a core::thread_pool created once, so evolve() can be called in short
+   * slices without paying for new threads each time.
+   */
+  template <class Decoder, class RNG>
+  class SteadyStateBRKGA {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    SteadyStateBRKGA( unsigned       n,
+                      unsigned       p,
+                      double         pe,
+                      double         pm,
+                      double         rhoe,
+                      const Decoder &refDecoder,
+                      RNG           &refRNG,
+                      unsigned       MAX_THREADS = 1 ) noexcept( false );
+
+    /**
+     * Decodes up to 'decodes' new individuals. No new offspring is started after 'issueUntil'
+     * (e.g. the end of a reporting slice), but the ones already being decoded are finished, so
+     * decodes longer than a slice still complete. Only 'deadline' interrupts a decode: it is
+     * checked inside decoders that take a decode_context, and an offspring cut short is discarded.
+     * @return number of individuals actually decoded
+     */
+    std::uint64_t evolve( std::uint64_t     decodes,
+                          clock::time_point deadline   = clock::time_point::max(),
+                          clock::time_point issueUntil = clock::time_point::max() );
+
+    /**
+     * Returns the best chromosome / fitness found so far (call between evolve() calls)
+     */
+    const std::vector<double> &getBestChromosome() const;
+    double                     getBestFitness() const;
+
+    /**
+     * Returns the decode counters and throughput accumulated so far
+     */
+    core::phase_report getPhaseReport() const;
+
+    unsigned getN() const;
+    unsigned getP() const;
+    unsigned getPe() const;
+    unsigned getPm() const;
+    double   getRhoe() const;
+    unsigned getMAX_THREADS() const;
+
+  private:
+    using Chromosome = std::shared_ptr<const std::vector<double>>;
+
+    struct Entry {
+      double     fitness;
+      Chromosome chromosome;
+    };
+
+    // Hyperparameters:
+    const unsigned n;
+    const unsigned p;
+    const unsigned pe;
+    const unsigned pm;
+    const double   rhoe;
+
+    const Decoder &refDecoder;
+    const unsigned MAX_THREADS;
+
+    core::thread_pool pool;  // persistent workers, one slot per worker
+
+    // One independent stream per worker, seeded from the caller's RNG:
+    std::vector<RNG> workerRNG;
+
+    // Ranked population (ascending fitness), guarded by 'mutex':
+    mutable std::mutex mutex;
+    std::vector<Entry> ranked;
+
+    core::phase_stats stats;
+
+    void worker( unsigned                        slot,
+                 std::atomic<std::uint64_t>     &issued,
+                 std::atomic<std::uint64_t>     &decoded,
+                 std::uint64_t                   decodes,
+                 clock::time_point               issueUntil,
+                 const core::cancellation_token &token );
+    std::optional<double> decodeOne( const std::vector<double>      &chromosome,
+                                     unsigned                        slot,
+                                     const core::cancellation_token *token = nullptr );
+    void   insert( Entry &&entry );
+  };
+
+  template <class Decoder, class RNG>
+  SteadyStateBRKGA<Decoder, RNG>::SteadyStateBRKGA( unsigned       _n,
+                                                    unsigned       _p,
+                                                    double         _pe,
+                                                    double         _pm,
+                                                    double         _rhoe,
+                                                    const Decoder &decoder,
+                                                    RNG           &rng,
+                                                    unsigned       MAX ) noexcept( false )
+    : n( _n )
+    , p( _p )
+    , pe( unsigned( _pe * p ) )
+    , pm( unsigned( _pm * p ) )
+    , rhoe( _rhoe )
+    , refDecoder( decoder )
+    , MAX_THREADS( MAX == 0 ? 1 : MAX )
+    , pool( MAX_THREADS )
+    , stats( MAX_THREADS ) {
+    using std::range_error;
+    if ( n == 0 ) {
+      throw range_error( "Chromosome size equals zero." );
+    }
+    if ( p == 0 ) {
+      throw range_error( "Population size equals zero." );
+    }
+    if ( pe == 0 ) {
+      throw range_error( "Elite-set size equals zero." );
+    }
+    if ( pe >= p ) {
+      throw range_error( "Elite-set size must be smaller than population size (pe < p)." );
+    }
+    if ( pe + pm > p ) {
+      throw range_error( "elite + mutant sets greater than population size (p)." );
+    }
+
+    workerRNG.reserve( MAX_THREADS );
+    for ( unsigned t = 0; t < MAX_THREADS; ++t ) {
+      workerRNG.emplace_back( rng.randInt() );
+    }
+
+    // Random initial population, decoded in parallel by the same workers:
+    std::vector<std::vector<double>> initial( p, std::vector<double>( n ) );
+    for ( auto &chromosome : initial ) {
+      for ( double &key : chromosome ) {
+        key = rng.rand();
+      }
+    }
+
+    ranked.resize( p );
+    const auto start = clock::now();
+    pool.parallel_for(
+      0,
+      p,
+      [&]( std::size_t i ) {
+        const double fitness = *decodeOne( initial[i], pool.slot() );
+        ranked[i]            = Entry{ fitness,
+                                      std::make_shared<const std::vector<double>>(
+                                        std::move( initial[i] ) ) };
+      },
+      1 );
+    stats.add_wall( static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - start ).count() ) );
+
+    std::sort( ranked.begin(), ranked.end(), []( const Entry &a, const Entry &b ) {
+      return a.fitness < b.fitness;
+    } );
+  }
+
+  template <class Decoder, class RNG>
+  std::uint64_t SteadyStateBRKGA<Decoder, RNG>::evolve( std::uint64_t     decodes,
+                                                        clock::time_point deadline,
+                                                        clock::time_point issueUntil ) {
+    std::atomic<std::uint64_t>     issued{ 0 };
+    std::atomic<std::uint64_t>     decoded{ 0 };
+    const core::cancellation_token token( deadline );
+    const auto                     start = clock::now();
+
+    // One long-running task per worker; a participant that finds a second one (its owner not yet
+    // awake) runs it too, and it returns at once because the budget or the slice is used up
+    pool.parallel_for(
+      0,
+      MAX_THREADS,
+      [&]( std::size_t ) { worker( pool.slot(), issued, decoded, decodes, issueUntil, token ); },
+      1 );
+    stats.add_wall( static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - start ).count() ) );
+
+    return decoded.load();
+  }
+
+  template <class Decoder, class RNG>
+  void SteadyStateBRKGA<Decoder, RNG>::worker( unsigned                        slot,
+                                               std::atomic<std::uint64_t>     &issued,
+                                               std::atomic<std::uint64_t>     &decoded,
+                                               std::uint64_t                   decodes,
+                                               clock::time_point               issueUntil,
+                                               const core::cancellation_token &token ) {
+    RNG                &rng        = workerRNG[slot];
+    const double        mutantRate = double( pm ) / double( p - pe );
+    std::vector<double> offspring( n );
+
+    while ( issued.fetch_add( 1, std::memory_order_relaxed ) < decodes ) {
+      if ( token.stop_requested() ||
+           ( issueUntil != clock::time_point::max() && clock::now() >= issueUntil ) ) {
+        break;
+      }
+
+      std::optional<core::scoped_timer> crossoverTimer(
+        std::in_place, stats.elapsed( slot, core::phase::crossover ) );
+      if ( rng.rand() < mutantRate ) {
+        for ( double &key : offspring ) {
+          key = rng.rand();
+        }
+      } else {
+        // Hold references to both parents so they survive even if replaced meanwhile:
+        Chromosome eliteParent;
+        Chromosome noneliteParent;
+        {
+          std::lock_guard lock( mutex );
+          eliteParent    = ranked[rng.randInt( pe - 1 )].chromosome;
+          noneliteParent = ranked[pe + rng.randInt( p - pe - 1 )].chromosome;
+        }
+        for ( unsigned j = 0; j < n; ++j ) {
+          offspring[j] = ( rng.rand() < rhoe ) ? ( *eliteParent )[j] : ( *noneliteParent )[j];
+        }
+      }
+      crossoverTimer.reset();
+
+      const auto fitness = decodeOne( offspring, slot, &token );
+      if ( !fitness ) {
+        break;  // cut short by the deadline
+      }
+      insert( Entry{ *fitness, std::make_shared<const std::vector<double>>( offspring ) } );
+      decoded.fetch_add( 1, std::memory_order_relaxed );
+    }
+  }
+
+  template <class Decoder, class RNG>
+  std::optional<double>
+  SteadyStateBRKGA<Decoder, RNG>::decodeOne( const std::vector<double>      &chromosome,
+                                             unsigned                        slot,
+                                             const core::cancellation_token *token ) {
+    auto              &counters = stats.local( slot );
+    core::scoped_timer timer( counters.elapsed_ns[std::size_t( core::phase::decode )] );
+
+    if constexpr ( context_decoder<Decoder> ) {
+      decode_context ctx;
+      ctx.thread_slot      = slot;
+      ctx.cancel           = token;
+      const double fitness = refDecoder.decode( chromosome, ctx );
+      if ( ctx.cancelled ) {
+        return std::nullopt;
+      }
+      ++counters.evaluations;
+      counters.repair_passes += ctx.repair_passes;
+      return fitness;
+    } else {
+      ++counters.evaluations;
+      return refDecoder.decode( chromosome );
+    }
+  }
+
+  template <class Decoder, class RNG>
+  void SteadyStateBRKGA<Decoder, RNG>::insert( Entry &&entry ) {
+    std::lock_guard lock( mutex );
+    if ( !( entry.fitness < ranked.back().fitness ) ) {
+      return;  // Not better than the worst: discarded
+    }
+
+    // Replace the worst and slide the newcomer up to its rank (ties keep the older one first):
+    ranked.back() = std::move( entry );
+    for ( std::size_t i = ranked.size() - 1; i > 0 && ranked[i].fitness < ranked[i - 1].fitness;
+          --i ) {
+      std::swap( ranked[i], ranked[i - 1] );
+    }
+  }
+
+  template <class Decoder, class RNG>
+  const std::vector<double> &SteadyStateBRKGA<Decoder, RNG>::getBestChromosome() const {
+    std::lock_guard lock( mutex );
+    return *ranked.front().chromosome;
+  }
+
+  template <class Decoder, class RNG>
+  double SteadyStateBRKGA<Decoder, RNG>::getBestFitness() const {
+    std::lock_guard lock( mutex );
+    return ranked.front().fitness;
+  }
+
+  template <class Decoder, class RNG>
+  core::phase_report SteadyStateBRKGA<Decoder, RNG>::getPhaseReport() const {
+    return stats.report();
+  }
+
+  template <class Decoder, class RNG>
+  unsigned SteadyStateBRKGA<Decoder, RNG>::getN() const {
+    return n;
+  }
+
+  template <class Decoder, class RNG>
+  unsigned SteadyStateBRKGA<Decoder, RNG>::getP() const {
+    return p;
+  }
+
+  template <class Decoder, class RNG>
+  unsigned SteadyStateBRKGA<Decoder, RNG>::getPe() const {
+    return pe;
+  }
+
+  template <class Decoder, class RNG>
+  unsigned SteadyStateBRKGA<Decoder, RNG>::getPm() const {
+    return pm;
+  }
+
+  template <class Decoder, class RNG>
+  double SteadyStateBRKGA<Decoder, RNG>::getRhoe() const {
+    return rhoe;
+  }
+
+  template <class Decoder, class RNG>
+  unsigned SteadyStateBRKGA<Decoder, RNG>::getMAX_THREADS() const {
+    return MAX_THREADS;
+  }
+}  // namespace r3dp::brkga
@@ -1,22 +1,46 @@
 #include "hho.hpp"
 
-#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <random>
 #include <stdexcept>
 
 namespace r3dp::hho {
 
-  // Construtor com seed opcional
+  namespace {
+    // Expoente e escala do passo de Lévy usados no artigo original
+    constexpr double LEVY_BETA  = 1.5;
+    constexpr double LEVY_SCALE = 0.01;
+
+    // σ_u do algoritmo de Mantegna para β = LEVY_BETA
+    const double LEVY_SIGMA = std::pow(
+      std::tgamma( 1.0 + LEVY_BETA ) * std::sin( std::numbers::pi * LEVY_BETA / 2.0 ) /
+        ( std::tgamma( ( 1.0 + LEVY_BETA ) / 2.0 ) * LEVY_BETA *
+          std::pow( 2.0, ( LEVY_BETA - 1.0 ) / 2.0 ) ),
+      1.0 / LEVY_BETA );
+
+    // Normal padrão por Box-Muller (1 - u evita log(0))
+    double standard_normal( core::counter_rng &rng ) {
+      const double radius = std::sqrt( -2.0 * std::log( 1.0 - rng.uniform() ) );
+      return radius * std::cos( 2.0 * std::numbers::pi * rng.uniform() );
+    }
+  }  // namespace
+
   template <hho_problem problem_type>
-  HHO<problem_type>::HHO( size_t              population_size,
-                          size_t              max_iterations,
-                          uint32_t            max_threads,
-                          const problem_type &ref_problem,
-                          uint32_t            seed )
+  HHO<problem_type>::HHO( size_t                       population_size,
+                          size_t                       max_iterations,
+                          uint32_t                     max_threads,
+                          const problem_type          &ref_problem,
+                          uint64_t                     seed,
+                          const std::vector<unsigned> &cpus )
     : population_size( population_size )
     , max_iterations( max_iterations )
     , max_threads( max_threads )
+    , dimension( ref_problem.get_dimension() )
     , ref_problem( ref_problem )
-    , rng( seed == 0 ? std::random_device{}() : seed ) {
+    , seed( seed == 0 ? std::random_device{}() : seed ) {
     // Verificações de limites
     if ( population_size == 0 ) {
       throw std::invalid_argument( "population_size deve ser maior que 0" );
@@ -30,11 +54,14 @@ namespace r3dp::hho {
       throw std::invalid_argument( "max_threads deve ser maior que 0" );
     }
 
-    hawks.resize( population_size, std::vector<double>( ref_problem.get_dimensions(), 0.0 ) );
-    rabbit_position.resize( ref_problem.get_dimensions(), 0.0 );
+    if ( max_threads > 1 ) {
+      pool = std::make_unique<core::thread_pool>( max_threads, cpus );
+    }
+    scratch.assign( pool ? pool->size() : 1, std::vector<double>( 3 * dimension ) );
 
-    rabbit_fitness = std::numeric_limits<double>::infinity();  // Fitness como infinito, pois o
-                                                               // problema é de minimização
+    hawks.resize( population_size * dimension );
+    next_hawks.resize( population_size * dimension );
+    mean_position.resize( dimension );
 
     initialize_hawks();
   }
@@ -51,79 +78,214 @@ namespace r3dp::hho {
     const auto &lb = ref_problem.get_lower_bounds();
     const auto &ub = ref_problem.get_upper_bounds();
 
+    // Fluxos 0..population_size-1; os passos usam (iteração + 1)·population_size + i
     for ( size_t i = 0; i < population_size; ++i ) {
-      for ( size_t j = 0; j < ref_problem.get_dimension(); ++j ) {
-        std::uniform_real_distribution<double> dist( lb[j], ub[j] );
-        hawks[i][j] = dist( rng );  // Preenche cada variavel com valors lb =< x >= ub
+      core::counter_rng rng( seed, i );
+      auto              hawk = row( hawks, i );
+      for ( size_t j = 0; j < dimension; ++j ) {
+        hawk[j] = lb[j] + rng.uniform() * ( ub[j] - lb[j] );  // lb <= x < ub
       }
     }
+
+    fitness.assign( population_size, std::numeric_limits<double>::quiet_NaN() );
+    next_fitness.assign( population_size, std::numeric_limits<double>::quiet_NaN() );
+    rabbit_position.assign( dimension, 0.0 );
+    rabbit_fitness = std::numeric_limits<double>::infinity();  // Fitness como infinito, pois o
+                                                               // problema é de minimização
   }
 
   template <hho_problem problem_type>
-  void HHO<problem_type>::step() {
-    /**
-     * Vou implementar duas funções, uma em que vou calcular tudo exceto o evaluate de forma
-     * sequencial, e vou implementar uma precomputando tudo que usa rng para manter o determinismo e
-     * paralelizar o loop principal com omp, e verificar qual é mais rapido, se pré computar todos
-     * os números paralelamente e paralelizar o loop principal for melhor, vou manter essa
-     * estratégia
-     * */
+  bool HHO<problem_type>::step( const core::cancellation_token *cancel ) {
+    return advance( nullptr, cancel );
+  }
+
+  template <hho_problem problem_type>
+  bool HHO<problem_type>::step_parallel( const core::cancellation_token *cancel ) {
+    return advance( pool.get(), cancel );
+  }
+
+  template <hho_problem problem_type>
+  bool HHO<problem_type>::advance( core::thread_pool              *workers,
+                                   const core::cancellation_token *cancel ) {
     if ( iteration >= max_iterations ) {
-      return;
+      return false;
     }
 
-    const auto dimension        = ref_problem.get_dimension();
-    const auto lower_bounds_vec = ref_problem.get_lower_bounds();
-    const auto upper_bounds_vec = ref_problem.get_upper_bounds();
+    auto stop_requested = [&] { return cancel != nullptr && cancel->stop_requested(); };
+    auto for_each_hawk  = [&]( auto &&body ) {
+      if ( workers != nullptr ) {
+        workers->parallel_for( 0, population_size, body, 1 );
+      } else {
+        for ( size_t i = 0; i < population_size; ++i ) {
+          body( i );
+        }
+      }
+    };
 
-    // clang-format off
-    #pragma omp parallel for num_threads( max_threads ) default( none )  // clang-format on
-    for ( size_t i = 0; i < population_size; ++i ) {
-      for ( unsigned j = 0; j < dimension; ++j ) {
-        hawks[i][j] = std::clamp( hawks[i][j], lower_bounds_vec[j], upper_bounds_vec[j] );
+    // 1. Avaliação das posições novas (as que vieram de mergulhos já têm fitness)
+    for_each_hawk( [&]( size_t i ) {
+      if ( std::isnan( fitness[i] ) && !stop_requested() ) {
+        fitness[i] = evaluate( row( hawks, i ) );
       }
-    }
+    } );
 
-    std::vector<double> fitness_values( population_size, std::numeric_limits<double>::infinity() );
-    // clang-format off
-    #pragma omp parallel for num_threads( max_threads ) default( none )  // clang-format on
+    // 2. Coelho: melhor posição avaliada até aqui (empate fica com o menor índice)
     for ( size_t i = 0; i < population_size; ++i ) {
-      fitness_values[i] = ref_problem.evaluate( hawks[i] );
+      if ( fitness[i] < rabbit_fitness ) {
+        rabbit_fitness = fitness[i];
+        auto best      = row( hawks, i );
+        rabbit_position.assign( best.begin(), best.end() );
+      }
+    }
+    if ( stop_requested() ) {
+      return false;
     }
 
-    double current_best_fitness = std::numeric_limits<double>::infinity();
-    size_t current_best_index   = 0;
+    std::fill( mean_position.begin(), mean_position.end(), 0.0 );
     for ( size_t i = 0; i < population_size; ++i ) {
-      if ( fitness_values[i] < current_best_fitness ) {
-        current_best_fitness = fitness_values[i];
-        current_best_index   = i;
+      const auto hawk = row( hawks, i );
+      for ( size_t j = 0; j < dimension; ++j ) {
+        mean_position[j] += hawk[j];
       }
     }
-    if ( current_best_fitness < rabbit_fitness ) {
-      rabbit_fitness  = current_best_fitness;
-      rabbit_position = hawks[current_best_index];
+    const double inverse_population = 1.0 / static_cast<double>( population_size );
+    for ( auto &value : mean_position ) {
+      value *= inverse_population;
     }
 
-    auto E1 =
+    // 3. Movimento: energia de fuga decai linearmente de 2 a 0 ao longo das iterações
+    const double e1 =
       2.0 * ( 1.0 - ( static_cast<double>( iteration ) / static_cast<double>( max_iterations ) ) );
-    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
-    std::mt19937_64                        rng_local( rng() );
+    for_each_hawk( [&]( size_t i ) {
+      if ( !stop_requested() ) {
+        move_hawk( i, e1, scratch[workers != nullptr ? workers->slot() : 0] );
+      }
+    } );
+    if ( stop_requested() ) {
+      return false;  // passo incompleto: next_hawks é descartado
+    }
 
-    for ( size_t i = 0; i < population_size; ++i ) {
-      auto   E0              = dist( rng_local );
-      double escaping_energy = E1 * E0;
+    hawks.swap( next_hawks );
+    fitness.swap( next_fitness );
+    ++iteration;
+    return true;
+  }
+
+  template <hho_problem problem_type>
+  void HHO<problem_type>::move_hawk( size_t i, double e1, std::vector<double> &buffer ) {
+    core::counter_rng rng( seed, ( iteration + 1 ) * population_size + i );
+
+    const auto  x      = row( hawks, i );
+    const auto  out    = row( next_hawks, i );
+    const auto &rabbit = rabbit_position;
+    const auto &lb     = ref_problem.get_lower_bounds();
+    const auto &ub     = ref_problem.get_upper_bounds();
+
+    const double e0     = 2.0 * rng.uniform() - 1.0;
+    const double energy = e1 * e0;  // energia de fuga do coelho
+    next_fitness[i]     = std::numeric_limits<double>::quiet_NaN();
+
+    if ( std::abs( energy ) >= 1.0 ) {
+      // Exploração: pousa perto de um falcão aleatório ou entre o coelho e o centro do bando
+      const double q = rng.uniform();
+      if ( q >= 0.5 ) {
+        const auto   other = row( hawks, rng.below_or_equal( population_size - 1 ) );
+        const double r1    = rng.uniform();
+        const double r2    = rng.uniform();
+        for ( size_t j = 0; j < dimension; ++j ) {
+          out[j] = other[j] - r1 * std::abs( other[j] - 2.0 * r2 * x[j] );
+        }
+      } else {
+        const double r3 = rng.uniform();
+        const double r4 = rng.uniform();
+        for ( size_t j = 0; j < dimension; ++j ) {
+          out[j] = ( rabbit[j] - mean_position[j] ) - r3 * ( lb[j] + r4 * ( ub[j] - lb[j] ) );
+        }
+      }
+      clamp( out );
+      return;
+    }
+
+    // Explotação: r decide se o coelho escapa (mergulhos) e |E| a força do cerco
+    const double r    = rng.uniform();
+    const double jump = 2.0 * ( 1.0 - rng.uniform() );  // força do salto do coelho
+    const bool   soft = std::abs( energy ) >= 0.5;
 
-      if ( std::abs( escaping_energy ) >= 1 ) {
-        // TODO: Fase de exploração
+    if ( r >= 0.5 ) {
+      if ( soft ) {
+        for ( size_t j = 0; j < dimension; ++j ) {
+          out[j] = ( rabbit[j] - x[j] ) - energy * std::abs( jump * rabbit[j] - x[j] );
+        }
       } else {
-        // TODO: Fase de explotação
+        for ( size_t j = 0; j < dimension; ++j ) {
+          out[j] = rabbit[j] - energy * std::abs( rabbit[j] - x[j] );
+        }
       }
+      clamp( out );
+      return;
+    }
+
+    // Cercos com mergulhos rápidos: Y em direção ao coelho; se não melhorar, Z = Y + S·Lévy
+    const std::span<double> y( buffer.data(), dimension );
+    const std::span<double> z( buffer.data() + dimension, dimension );
+    const std::span<double> s( buffer.data() + 2 * dimension, dimension );
+
+    const std::span<const double> anchor =
+      soft ? std::span<const double>( x ) : std::span<const double>( mean_position );
+    for ( size_t j = 0; j < dimension; ++j ) {
+      y[j] = rabbit[j] - energy * std::abs( jump * rabbit[j] - anchor[j] );
+    }
+    clamp( y );
+
+    const double y_fitness = evaluate( y );
+    if ( y_fitness < fitness[i] ) {
+      std::copy( y.begin(), y.end(), out.begin() );
+      next_fitness[i] = y_fitness;
+      return;
+    }
+
+    for ( auto &value : s ) {
+      value = rng.uniform();
+    }
+    levy_flight( rng, z );
+    for ( size_t j = 0; j < dimension; ++j ) {
+      z[j] = y[j] + s[j] * z[j];
+    }
+    clamp( z );
+
+    const double z_fitness = evaluate( z );
+    if ( z_fitness < fitness[i] ) {
+      std::copy( z.begin(), z.end(), out.begin() );
+      next_fitness[i] = z_fitness;
+    } else {
+      std::copy( x.begin(), x.end(), out.begin() );
+      next_fitness[i] = fitness[i];
     }
   }
 
+  // Passo de Lévy pelo algoritmo de Mantegna: 0,01 · u·σ / |v|^(1/β), u e v normais padrão
   template <hho_problem problem_type>
-  void HHO<problem_type>::step_parallel() {
-    // Lógica do passo paralelizado da otimização (a ser implementada)
+  void HHO<problem_type>::levy_flight( core::counter_rng &rng, std::span<double> out ) const {
+    for ( auto &value : out ) {
+      const double u = standard_normal( rng );
+      const double v = standard_normal( rng );
+      value          = LEVY_SCALE * u * LEVY_SIGMA / std::pow( std::abs( v ), 1.0 / LEVY_BETA );
+    }
+  }
+
+  template <hho_problem problem_type>
+  double HHO<problem_type>::evaluate( std::span<const double> position ) {
+    evaluations.fetch_add( 1, std::memory_order_relaxed );
+    return ref_problem.evaluate( position );
+  }
+
+  template <hho_problem problem_type>
+  void HHO<problem_type>::clamp( std::span<double> position ) const {
+    const auto &lb = ref_problem.get_lower_bounds();
+    const auto &ub = ref_problem.get_upper_bounds();
+    for ( size_t j = 0; j < dimension; ++j ) {
+      position[j] = std::clamp( position[j], lb[j], ub[j] );
+    }
   }
 
   template <hho_problem problem_type>
@@ -141,12 +303,26 @@ namespace r3dp::hho {
     return iteration;
   }
 
+  template <hho_problem problem_type>
+  std::uint64_t HHO<problem_type>::get_evaluations() const {
+    return evaluations.load( std::memory_order_relaxed );
+  }
+
+  template <hho_problem problem_type>
+  uint64_t HHO<problem_type>::get_seed() const {
+    return seed;
+  }
+
   template <hho_problem problem_type>
   void HHO<problem_type>::reset() {
-    iteration = 0;
-    hawks.clear();
-    rabbit_position.clear();
-    rabbit_fitness = std::numeric_limits<double>::infinity();
+    iteration   = 0;
+    evaluations.store( 0, std::memory_order_relaxed );
     initialize_hawks();
   }
+
+  // Instanciação explícita para as representações de grafo usadas pelos executáveis
+  template class HHO<r3dp_hho_problem>;
+  template class HHO<csr_r3dp_hho_problem>;
+  template class HHO<compressed_r3dp_hho_problem>;
+
 }  // namespace r3dp::hho
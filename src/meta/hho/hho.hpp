@@ -1,13 +1,32 @@
 #pragma once
 
+#include "../../core/cancellation.hpp"
+#include "../../core/counter_rng.hpp"
+#include "../../core/thread_pool.hpp"
 #include "hho_problem.hpp"
 
+#include <atomic>
 #include <cstdint>
-#include <random>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace r3dp::hho {
 
+  /**
+   * Harris Hawks Optimization (Heidari et al., 2019) para problemas de minimização em caixa.
+   *
+   * Os falcões ficam numa matriz contígua (linha i = falcão i) e cada passo lê apenas o estado da
+   * iteração anterior e escreve em uma segunda matriz, então a atualização dos falcões é
+   * independente entre si (variante síncrona do algoritmo). Cada falcão usa o fluxo
+   * (seed, iteração, falcão) de um core::counter_rng, o que faz `step` e `step_parallel`
+   * produzirem exatamente o mesmo resultado com qualquer número de threads.
+   *
+   * Um passo: avalia os falcões ainda sem fitness, atualiza o coelho (melhor posição já vista),
+   * calcula a posição média e move cada falcão pela fase de exploração (|E| >= 1) ou por um dos
+   * quatro cercos da explotação; os cercos com mergulhos de Lévy avaliam Y e Z na hora e guardam
+   * o fitness do vencedor, que não é reavaliado no passo seguinte.
+   */
   template <hho_problem problem_type>
   class HHO {
   private:
@@ -15,35 +34,66 @@ namespace r3dp::hho {
     const size_t   max_iterations;
     const uint32_t max_threads;
 
-    size_t                           iteration{};
-    std::vector<std::vector<double>> hawks;
-    std::vector<double>              rabbit_position;
-    double                           rabbit_fitness{};
+    size_t                     iteration{};
+    size_t                     dimension;
+    std::vector<double>        hawks;       // population_size × dimension
+    std::vector<double>        next_hawks;  // destino do passo corrente
+    std::vector<double>        fitness;     // NaN: posição ainda não avaliada
+    std::vector<double>        next_fitness;
+    std::vector<double>        mean_position;
+    std::vector<double>        rabbit_position;
+    double                     rabbit_fitness{};
+    std::atomic<std::uint64_t> evaluations{ 0 };
 
     const problem_type &ref_problem;
 
-    std::mt19937_64 rng;
-    uint32_t        seed;
-    void            initialize_hawks();
+    uint64_t                           seed;
+    std::unique_ptr<core::thread_pool> pool;
+    std::vector<std::vector<double>>   scratch;  // por slot do pool: Y, Z e o passo de Lévy
+
+    void   initialize_hawks();
+    bool   advance( core::thread_pool *workers, const core::cancellation_token *cancel );
+    void   move_hawk( size_t i, double e1, std::vector<double> &buffer );
+    void   levy_flight( core::counter_rng &rng, std::span<double> out ) const;
+    double evaluate( std::span<const double> position );
+    void   clamp( std::span<double> position ) const;
+
+    [[nodiscard]] std::span<double> row( std::vector<double> &matrix, size_t i ) {
+      return { matrix.data() + i * dimension, dimension };
+    }
 
   public:
-    HHO( size_t              population_size,
-         size_t              max_iterations,
-         uint32_t            max_threads,
-         const problem_type &ref_problem,
-         uint32_t            seed = 0 );
+    /**
+     * @param seed semente dos fluxos de números aleatórios (0 = aleatória)
+     * @param cpus CPUs onde fixar as threads do pool quando max_threads > 1 (vazio não fixa)
+     */
+    HHO( size_t                       population_size,
+         size_t                       max_iterations,
+         uint32_t                     max_threads,
+         const problem_type          &ref_problem,
+         uint64_t                     seed,
+         const std::vector<unsigned> &cpus = {} );
 
     HHO( size_t              population_size,
          size_t              max_iterations,
          uint32_t            max_threads,
          const problem_type &ref_problem );
 
-    void step();
-    void step_parallel();
+    /**
+     * Executa uma iteração na thread chamadora. Retorna false (sem avançar) quando já se chegou a
+     * max_iterations ou quando `cancel` disparou no meio do passo; nesse caso as posições novas são
+     * descartadas, mas o coelho pode ter melhorado com as avaliações já feitas.
+     */
+    bool step( const core::cancellation_token *cancel = nullptr );
+
+    // Mesma iteração, com avaliação e movimento dos falcões distribuídos em max_threads threads
+    bool step_parallel( const core::cancellation_token *cancel = nullptr );
 
     [[nodiscard]] const std::vector<double> &get_best_solution() const;
     [[nodiscard]] double                     get_best_fitness() const;
     [[nodiscard]] size_t                     get_iteration() const;
+    [[nodiscard]] std::uint64_t              get_evaluations() const;
+    [[nodiscard]] uint64_t                   get_seed() const;
 
     void reset();
   };
@@ -1,12 +1,14 @@
 #pragma once
 #include "../../core/graph.hpp"
+#include "../brkga/brkga_decoder.hpp"
 
-#include <boost/graph/detail/adjacency_list.hpp>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace r3dp::hho {
   template <typename T>
-  concept hho_problem = requires( T problem, const std::vector<double> &x ) {
+  concept hho_problem = requires( T problem, std::span<const double> x ) {
                           { problem.get_dimension() } -> std::same_as<size_t>;
                           {
                             problem.get_lower_bounds()
@@ -17,18 +19,32 @@ namespace r3dp::hho {
                           { problem.evaluate( x ) } -> std::same_as<double>;
                         };
 
-  class r3dp_hho_problem {
+  /**
+   * Adaptador do R3DP para o HHO: cada coordenada em [0, 1] é o gene de um vértice e o fitness é o
+   * do mesmo decodificador (quantização + reparo) usado pelo BRKGA, então uma posição de falcão
+   * também é um cromossomo válido do BRKGA.
+   *
+   * Guarda apenas referências ao grafo, que deve sobreviver ao problema e não ser alterado durante
+   * a execução; várias threads (e vários HHO) podem avaliar ao mesmo tempo sobre o mesmo grafo.
+   * Os rótulos de trabalho ficam num buffer por thread, reaproveitado entre avaliações.
+   */
+  template <core::adjacency_graph Graph>
+  class basic_r3dp_hho_problem {
   private:
-    core::graph_t       g;
-    std::vector<double> lo;
-    std::vector<double> hi;
+    const Graph                     &g;
+    brkga::basic_r3dp_decoder<Graph> decoder;
+    std::vector<double>              lo;
+    std::vector<double>              hi;
 
   public:
-    explicit r3dp_hho_problem( const core::graph_t &g )
-      : g( g ), lo( boost::num_vertices( g ), 0.0 ), hi( boost::num_vertices( g ), 1.0 ) {}
+    explicit basic_r3dp_hho_problem( const Graph &g )
+      : g( g ),
+        decoder( g ),
+        lo( core::vertex_count( g ), 0.0 ),
+        hi( core::vertex_count( g ), 1.0 ) {}
 
     [[nodiscard]] size_t get_dimension() const {
-      return boost::num_vertices( g );
+      return lo.size();
     }
 
     [[nodiscard]] const std::vector<double> &get_lower_bounds() const {
@@ -39,13 +55,24 @@ namespace r3dp::hho {
       return hi;
     }
 
-    [[nodiscard]] static double evaluate( const std::vector<double> &x ) {
-      return static_cast<double>( x.size() ) * 3;
+    [[nodiscard]] const brkga::basic_r3dp_decoder<Graph> &get_decoder() const {
+      return decoder;
+    }
+
+    [[nodiscard]] double evaluate( std::span<const double> x ) const {
+      thread_local std::vector<uint8_t> labels;
+      brkga::decode_context             ctx;
+      return decoder.decode( x, labels, ctx );
     }
   };
 
+  using r3dp_hho_problem            = basic_r3dp_hho_problem<core::graph_t>;
+  using csr_r3dp_hho_problem        = basic_r3dp_hho_problem<core::csr_graph>;
+  using compressed_r3dp_hho_problem = basic_r3dp_hho_problem<core::compressed_graph>;
+
   // Aqui o static_assert verifica em tempode compilação se o concept é implementado corretamente
-  static_assert( hho_problem<r3dp_hho_problem>,
+  static_assert( hho_problem<r3dp_hho_problem> && hho_problem<csr_r3dp_hho_problem> &&
+                   hho_problem<compressed_r3dp_hho_problem>,
                  "r3dp_hho_problem não implementa corretamente o conceito 'hho_problem'." );
 
 }  // namespace r3dp::hho
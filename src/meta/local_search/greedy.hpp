@@ -0,0 +1,162 @@
+#pragma once
+
+#include "../../core/counter_rng.hpp"
+#include "../../core/graph.hpp"
+#include "label_search.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace r3dp::local_search {
+
+  /**
+   * Construção gulosa de uma dominação {3}-romana em O(n + m).
+   *
+   * Cada vértice tem uma demanda descoberta: o quanto falta na soma da vizinhança para a regra do
+   * seu rótulo valer (3 - soma para rótulo 0, zero para rótulo 3). O ganho de um vértice de rótulo
+   * 0 é a demanda que some se ele passar a 3: a dele mais a de cada vizinho (nenhuma passa de 3). A
+   * cada passo, o vértice de maior ganho recebe 3; os ganhos só diminuem, então uma fila de
+   * prioridade por baldes (um balde por ganho, de 0 a 3 * (grau máximo + 1)) com o ponteiro do
+   * maior balde descendo monotonicamente basta. A demanda de cada vértice cai no máximo 3 vezes e
+   * cada queda custa O(grau), daí o tempo linear. Ao final, basic_label_search::descend baixa os
+   * rótulos que sobraram (3 -> 2 -> 1 -> 0) até um mínimo local.
+   *
+   * Sem gerador, os empates saem na ordem do balde (resultado determinístico); com um gerador, o
+   * vértice é sorteado entre os empatados, o que dá variantes aleatórias da mesma construção.
+   */
+  template <core::adjacency_graph Graph>
+  class basic_greedy_construction {
+  public:
+    explicit basic_greedy_construction( const Graph &g ) : graph( g ), search( g ) {}
+
+    // Constrói uma rotulação viável e retorna seus rótulos (válidos até a próxima chamada)
+    const std::vector<std::uint8_t> &construct( core::counter_rng *rng = nullptr ) {
+      const std::size_t n = core::vertex_count( graph );
+      labels.assign( n, 0 );
+      sums.assign( n, 0 );
+      deficit.assign( n, 3 );
+      gain.resize( n );
+      position.resize( n );
+
+      std::uint32_t max_gain = 0;
+      for ( std::size_t u = 0; u < n; ++u ) {
+        gain[u] = 3;
+        for ( [[maybe_unused]] auto w : core::neighbors( graph, core::vertex_t( u ) ) ) {
+          gain[u] += 3;  // o vizinho ainda tem demanda 3
+        }
+        max_gain = std::max( max_gain, gain[u] );
+      }
+      for ( auto &bucket : buckets ) {
+        bucket.clear();
+      }
+      buckets.resize( std::size_t{ max_gain } + 1 );
+      for ( std::size_t u = 0; u < n; ++u ) {
+        insert( static_cast<core::vertex_t>( u ) );
+      }
+
+      open = 3 * std::uint64_t{ n };
+
+      std::size_t top = max_gain;
+      while ( open > 0 ) {
+        while ( buckets[top].empty() ) {
+          --top;  // não chega a 0: um vértice com demanda tem rótulo 0 e ganho positivo
+        }
+        const auto &bucket = buckets[top];
+        const auto  u = bucket[rng != nullptr ? rng->below_or_equal( bucket.size() - 1 ) : 0];
+        raise( u );
+      }
+
+      // Limpeza: o guloso só usa o rótulo 3 e não desfaz escolhas que ficaram redundantes
+      core::counter_rng fixed( 0, 0 );
+      search.assign( labels );
+      search.descend( rng != nullptr ? *rng : fixed );
+      labels = search.get_labels();
+      return labels;
+    }
+
+    [[nodiscard]] std::uint64_t weight() const noexcept {
+      return search.weight();
+    }
+
+    [[nodiscard]] const std::vector<std::uint8_t> &get_labels() const noexcept {
+      return labels;
+    }
+
+    /**
+     * Chaves que o decodificador quantiza de volta nestes rótulos. Sem gerador, o centro de cada
+     * faixa de 1/4 (como basic_label_search::to_keys); com um, um ponto sorteado dentro da faixa,
+     * para que cópias da mesma solução se recombinem de formas diferentes.
+     */
+    void to_keys( std::span<double> keys, core::counter_rng *rng = nullptr ) const {
+      for ( std::size_t v = 0; v < labels.size(); ++v ) {
+        keys[v] = ( labels[v] + ( rng != nullptr ? rng->uniform() : 0.5 ) ) / 4.0;
+      }
+    }
+
+  private:
+    const Graph              &graph;
+    basic_label_search<Graph> search;
+
+    std::vector<std::uint8_t>                labels;
+    std::vector<std::uint32_t>               sums;      // soma dos rótulos dos vizinhos
+    std::vector<std::uint8_t>                deficit;   // demanda descoberta (0 a 3)
+    std::vector<std::uint32_t>               gain;      // demanda que some se o vértice for a 3
+    std::vector<std::uint32_t>               position;  // índice do vértice no seu balde
+    std::vector<std::vector<core::vertex_t>> buckets;   // vértices de rótulo 0 por ganho
+    std::uint64_t                            open = 0;  // soma das demandas descobertas
+
+    void insert( core::vertex_t v ) {
+      auto &bucket = buckets[gain[v]];
+      position[v]  = static_cast<std::uint32_t>( bucket.size() );
+      bucket.push_back( v );
+    }
+
+    void erase( core::vertex_t v ) {
+      auto      &bucket = buckets[gain[v]];
+      const auto last   = bucket.back();
+
+      bucket[position[v]] = last;
+      position[last]      = position[v];
+      bucket.pop_back();
+    }
+
+    void raise( core::vertex_t u ) {
+      erase( u );
+      labels[u] = 3;
+      lower_deficit( u, 0 );
+      for ( auto w : core::neighbors( graph, u ) ) {
+        sums[w] += 3;
+        if ( labels[w] == 0 ) {
+          lower_deficit( w, static_cast<std::uint8_t>( sums[w] >= 3 ? 0 : 3 - sums[w] ) );
+        }
+      }
+    }
+
+    // A demanda de v cai para `remaining`: v e seus vizinhos ainda em rótulo 0 perdem o mesmo ganho
+    void lower_deficit( core::vertex_t v, std::uint8_t remaining ) {
+      const std::uint32_t delta = deficit[v] - remaining;
+      if ( delta == 0 ) {
+        return;
+      }
+      deficit[v] = remaining;
+      open -= delta;
+      if ( labels[v] == 0 ) {
+        lower_gain( v, delta );
+      }
+      for ( auto x : core::neighbors( graph, v ) ) {
+        if ( labels[x] == 0 ) {
+          lower_gain( x, delta );
+        }
+      }
+    }
+
+    void lower_gain( core::vertex_t v, std::uint32_t delta ) {
+      erase( v );
+      gain[v] -= delta;
+      insert( v );
+    }
+  };
+
+}  // namespace r3dp::local_search
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../../core/compressed_graph.hpp"
+#include "../../core/counter_rng.hpp"
+#include "../../core/csr_graph.hpp"
+#include "../../core/graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace r3dp::local_search {
+
+  // Regra da dominação {3}-romana para um vértice com rótulo `label` e soma `sum` na vizinhança
+  inline bool label_satisfied( std::uint8_t label, std::uint32_t sum ) noexcept {
+    return label >= 2 || ( label == 1 && sum >= 2 ) || ( label == 0 && sum >= 3 );
+  }
+
+  /**
+   * Busca local no espaço de rótulos da dominação {3}-romana.
+   *
+   * Mantém uma rotulação viável e a soma dos rótulos na vizinhança de cada vértice, de modo que
+   * testar e aplicar "baixar o rótulo de u em 1" custa O(grau(u)): a regra do próprio u vale com a
+   * soma atual e cada vizinho perde 1 na soma. `descend` baixa rótulos em ordem aleatória até que
+   * nenhum possa baixar (mínimo local); `kick` sobe rótulos ao acaso, o que mantém a viabilidade e
+   * abre espaço para uma nova descida (busca local iterada).
+   *
+   * Regras (as mesmas do decodificador): rótulo 0 exige soma >= 3 e rótulo 1 exige soma >= 2.
+   */
+  template <core::adjacency_graph Graph>
+  class basic_label_search {
+  public:
+    explicit basic_label_search( const Graph &g ) : graph( g ) {}
+
+    // Carrega uma rotulação viável (ex.: os rótulos reparados do decodificador)
+    void assign( std::span<const std::uint8_t> solution ) {
+      labels.assign( solution.begin(), solution.end() );
+      sums.assign( labels.size(), 0 );
+      total = 0;
+      for ( std::size_t u = 0; u < labels.size(); ++u ) {
+        total += labels[u];
+        for ( auto w : core::neighbors( graph, static_cast<core::vertex_t>( u ) ) ) {
+          sums[w] += labels[u];
+        }
+      }
+    }
+
+    // Baixa rótulos até um mínimo local; retorna quantos foram baixados
+    std::uint64_t descend( core::counter_rng &rng ) {
+      shuffle_order( rng );
+      std::uint64_t lowered = 0;
+      bool          changed = true;
+      while ( changed ) {
+        changed = false;
+        for ( core::vertex_t u : order ) {
+          while ( can_lower( u ) ) {
+            change( u, -1 );
+            ++lowered;
+            changed = true;
+          }
+        }
+      }
+      return lowered;
+    }
+
+    // Sobe em 1 o rótulo de `count` vértices sorteados (rótulos 3 ficam como estão)
+    void kick( core::counter_rng &rng, std::size_t count ) {
+      if ( labels.empty() ) {
+        return;
+      }
+      for ( std::size_t k = 0; k < count; ++k ) {
+        const auto u = static_cast<core::vertex_t>( rng.below_or_equal( labels.size() - 1 ) );
+        if ( labels[u] < 3 ) {
+          change( u, +1 );
+        }
+      }
+    }
+
+    [[nodiscard]] std::uint64_t weight() const noexcept {
+      return total;
+    }
+
+    [[nodiscard]] const std::vector<std::uint8_t> &get_labels() const noexcept {
+      return labels;
+    }
+
+    // Chaves que o decodificador quantiza de volta nestes rótulos (centro de cada faixa de 1/4)
+    void to_keys( std::span<double> keys ) const {
+      for ( std::size_t v = 0; v < labels.size(); ++v ) {
+        keys[v] = ( labels[v] + 0.5 ) / 4.0;
+      }
+    }
+
+  private:
+    const Graph &graph;
+
+    std::vector<std::uint8_t>   labels;
+    std::vector<std::uint32_t>  sums;   // soma dos rótulos dos vizinhos
+    std::vector<core::vertex_t> order;  // ordem de varredura da descida
+    std::uint64_t               total = 0;
+
+    [[nodiscard]] bool can_lower( core::vertex_t u ) const {
+      if ( labels[u] == 0 ||
+           !label_satisfied( static_cast<std::uint8_t>( labels[u] - 1 ), sums[u] ) ) {
+        return false;
+      }
+      for ( auto w : core::neighbors( graph, u ) ) {
+        if ( !label_satisfied( labels[w], sums[w] - 1 ) ) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void change( core::vertex_t u, int delta ) {
+      labels[u] = static_cast<std::uint8_t>( labels[u] + delta );
+      total += delta;
+      for ( auto w : core::neighbors( graph, u ) ) {
+        sums[w] += delta;
+      }
+    }
+
+    void shuffle_order( core::counter_rng &rng ) {
+      order.resize( labels.size() );
+      std::iota( order.begin(), order.end(), core::vertex_t{ 0 } );
+      for ( std::size_t i = order.size(); i > 1; --i ) {
+        std::swap( order[i - 1], order[rng.below_or_equal( i - 1 )] );
+      }
+    }
+  };
+
+}  // namespace r3dp::local_search
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "../../core/cancellation.hpp"
+#include "../../core/counter_rng.hpp"
+#include "../../core/graph.hpp"
+#include "label_search.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace r3dp::local_search {
+
+  struct relink_result {
+    std::vector<std::uint8_t> labels;  // melhor solução viável do caminho, após a descida
+    std::uint64_t             weight = NO_WEIGHT;
+    std::uint64_t             steps  = 0;  // passos dados no caminho
+
+    static constexpr std::uint64_t NO_WEIGHT = std::numeric_limits<std::uint64_t>::max();
+
+    [[nodiscard]] bool found() const noexcept {
+      return weight != NO_WEIGHT;
+    }
+  };
+
+  /**
+   * Religamento de caminhos no espaço de rótulos entre duas soluções viáveis.
+   *
+   * Parte de `from` e, a cada passo, copia para um vértice o rótulo que ele tem em `guide`, até
+   * chegar a `guide`. Os pontos intermediários podem violar as regras; o estado guarda a soma dos
+   * rótulos na vizinhança de cada vértice e quantos vértices estão violados, de modo que avaliar e
+   * aplicar um passo custa O(grau). O passo é o melhor (peso + PENALTY por violação) entre até
+   * MOVE_SAMPLE vértices ainda diferentes sorteados, o que mantém o custo por passo constante em
+   * vez de O(|diferença|). O melhor ponto viável estritamente entre os extremos é reconstruído e
+   * levado a um mínimo local por basic_label_search::descend.
+   */
+  template <core::adjacency_graph Graph>
+  class basic_path_relinking {
+  public:
+    static constexpr unsigned MOVE_SAMPLE = 8;
+    static constexpr int      PENALTY     = 4;  // maior que qualquer variação de um rótulo
+
+    // Passos entre duas consultas ao pedido de cancelamento (potência de 2)
+    static constexpr std::uint64_t CANCEL_CHECK_INTERVAL = 1024;
+
+    explicit basic_path_relinking( const Graph &g ) : graph( g ), search( g ) {}
+
+    relink_result relink( std::span<const std::uint8_t>   from,
+                          std::span<const std::uint8_t>   guide,
+                          core::counter_rng              &rng,
+                          const core::cancellation_token *cancel = nullptr ) {
+      load( from );
+      pending.clear();
+      for ( std::size_t v = 0; v < from.size(); ++v ) {
+        if ( from[v] != guide[v] ) {
+          pending.push_back( static_cast<core::vertex_t>( v ) );
+        }
+      }
+
+      relink_result result;
+      path.clear();
+      std::size_t best_prefix = 0;
+      while ( pending.size() > 1 ) {  // o último passo chega a `guide`, que não conta
+        if ( cancel != nullptr && ( path.size() & ( CANCEL_CHECK_INTERVAL - 1 ) ) == 0 &&
+             cancel->stop_requested() ) {
+          break;
+        }
+
+        // Melhor de uma amostra dos vértices pendentes
+        const std::size_t sample     = std::min<std::size_t>( MOVE_SAMPLE, pending.size() );
+        std::size_t       pick       = 0;
+        long              pick_score = std::numeric_limits<long>::max();
+        for ( std::size_t s = 0; s < sample; ++s ) {
+          const std::size_t i     = rng.below_or_equal( pending.size() - 1 );
+          const auto        v     = pending[i];
+          const long        score = move_score( v, guide[v] );
+          if ( score < pick_score ) {
+            pick       = i;
+            pick_score = score;
+          }
+        }
+
+        const auto v  = pending[pick];
+        pending[pick] = pending.back();
+        pending.pop_back();
+        set_label( v, guide[v] );
+        path.push_back( v );
+
+        if ( violated == 0 && total < result.weight ) {
+          result.weight = total;
+          best_prefix   = path.size();
+        }
+      }
+      result.steps = path.size();
+      if ( best_prefix == 0 ) {
+        return result;  // nenhum ponto intermediário viável
+      }
+
+      // Reconstrói o melhor ponto e desce até um mínimo local
+      result.labels.assign( from.begin(), from.end() );
+      for ( std::size_t i = 0; i < best_prefix; ++i ) {
+        result.labels[path[i]] = guide[path[i]];
+      }
+      search.assign( result.labels );
+      search.descend( rng );
+      result.labels = search.get_labels();
+      result.weight = search.weight();
+      return result;
+    }
+
+  private:
+    const Graph                &graph;
+    basic_label_search<Graph>   search;
+    std::vector<std::uint8_t>   labels;
+    std::vector<std::uint32_t>  sums;
+    std::vector<core::vertex_t> pending;  // vértices cujo rótulo ainda difere do guia
+    std::vector<core::vertex_t> path;     // vértices na ordem em que foram trocados
+    std::uint64_t               total    = 0;
+    std::uint64_t               violated = 0;
+
+    static long violation( std::uint8_t label, std::uint32_t sum ) noexcept {
+      return label_satisfied( label, sum ) ? 0 : 1;
+    }
+
+    void load( std::span<const std::uint8_t> solution ) {
+      labels.assign( solution.begin(), solution.end() );
+      sums.assign( labels.size(), 0 );
+      total = 0;
+      for ( std::size_t u = 0; u < labels.size(); ++u ) {
+        total += labels[u];
+        for ( auto w : core::neighbors( graph, static_cast<core::vertex_t>( u ) ) ) {
+          sums[w] += labels[u];
+        }
+      }
+      violated = 0;
+      for ( std::size_t u = 0; u < labels.size(); ++u ) {
+        violated += violation( labels[u], sums[u] );
+      }
+    }
+
+    // Variação de (peso + PENALTY * violados) se v passar a ter `label`
+    [[nodiscard]] long move_score( core::vertex_t v, std::uint8_t label ) const {
+      const int delta      = int( label ) - int( labels[v] );
+      long      violations = violation( label, sums[v] ) - violation( labels[v], sums[v] );
+      for ( auto w : core::neighbors( graph, v ) ) {
+        violations += violation( labels[w], sums[w] + delta ) - violation( labels[w], sums[w] );
+      }
+      return delta + PENALTY * violations;
+    }
+
+    void set_label( core::vertex_t v, std::uint8_t label ) {
+      const int delta = int( label ) - int( labels[v] );
+      violated -= violation( labels[v], sums[v] );
+      labels[v] = label;
+      violated += violation( labels[v], sums[v] );
+      total += delta;
+      for ( auto w : core::neighbors( graph, v ) ) {
+        violated -= violation( labels[w], sums[w] );
+        sums[w] += delta;
+        violated += violation( labels[w], sums[w] );
+      }
+    }
+  };
+
+}  // namespace r3dp::local_search
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "../../core/cancellation.hpp"
+#include "../../core/counter_rng.hpp"
+#include "../../core/incumbent.hpp"
+#include "../../core/thread_pool.hpp"
+#include "../brkga/brkga.hpp"
+#include "../brkga/brkga_decoder.hpp"
+#include "../brkga/mt_rand.hpp"
+#include "../hho/hho.hpp"
+#include "../hho/hho_problem.hpp"
+#include "../local_search/label_search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace r3dp::portfolio {
+
+  enum class engine_kind { brkga, hho, local_search };
+
+  inline const char *engine_name( engine_kind kind ) noexcept {
+    switch ( kind ) {
+      case engine_kind::brkga:
+        return "brkga";
+      case engine_kind::hho:
+        return "hho";
+      case engine_kind::local_search:
+        return "local-search";
+    }
+    return "?";
+  }
+
+  // Um motor do portfólio e seus parâmetros (só os do seu tipo são usados)
+  struct member_config {
+    engine_kind kind    = engine_kind::brkga;
+    unsigned    threads = 1;
+
+    // BRKGA
+    unsigned population_size        = 100;
+    double   elite_fraction         = 0.20;
+    double   mutant_fraction        = 0.10;
+    double   elite_inheritance_prob = 0.70;
+    unsigned num_populations        = 3;
+    unsigned migration_interval     = 100;
+    unsigned migration_size         = 2;
+    unsigned inject_interval        = 10;  // gerações entre consultas ao incumbente (0 = nunca)
+    bool     batch_decode           = false;
+
+    // HHO (ao chegar a max_iterations recomeça com outra semente)
+    unsigned hho_population_size = 30;
+    unsigned hho_max_iterations  = 500;
+
+    // Busca local iterada: vértices sorteados por perturbação, como fração de n
+    double kick_fraction = 0.01;
+  };
+
+  struct improvement_point {
+    double   time_seconds;
+    double   fitness_value;
+    unsigned member;
+  };
+
+  struct member_result {
+    engine_kind           kind;
+    unsigned              threads = 1;
+    std::vector<unsigned> cpus;
+    double                best_fitness_value = std::numeric_limits<double>::infinity();
+    std::uint64_t         iterations         = 0;  // gerações, iterações ou descidas
+    std::uint64_t         evaluations        = 0;
+    std::uint64_t         published          = 0;  // vezes em que melhorou o incumbente
+    std::uint64_t         injected           = 0;  // vezes em que recebeu o incumbente
+  };
+
+  struct portfolio_result {
+    double                         best_fitness_value = std::numeric_limits<double>::infinity();
+    unsigned                       best_member        = 0;
+    std::vector<improvement_point> convergence_points;  // melhorias do incumbente, em ordem
+    std::vector<member_result>     members;
+  };
+
+  /**
+   * Divide `cpus` em blocos contíguos e disjuntos, um por motor, com `threads` CPUs cada. Se não
+   * houver CPUs para todos, os blocos recomeçam do início (há sobreposição); `overlapping` diz
+   * se isso aconteceu.
+   */
+  inline std::vector<std::vector<unsigned>> assign_cpus( const std::vector<member_config> &members,
+                                                         const std::vector<unsigned>      &cpus,
+                                                         bool &overlapping ) {
+    std::vector<std::vector<unsigned>> sets;
+    std::size_t                        next = 0;
+    overlapping                             = false;
+    for ( const auto &member : members ) {
+      auto &set = sets.emplace_back();
+      for ( unsigned t = 0; t < member.threads && !cpus.empty(); ++t ) {
+        overlapping |= next >= cpus.size();
+        set.push_back( cpus[next % cpus.size()] );
+        ++next;
+      }
+    }
+    return sets;
+  }
+
+  /**
+   * @brief Executa vários motores ao mesmo tempo sobre o mesmo grafo até `deadline`.
+   *
+   * Cada motor roda na sua própria thread, fixada no primeiro CPU do seu bloco, com o seu pool
+   * nos demais CPUs do bloco. Todos publicam no mesmo core::shared_incumbent (sem mutex). As ilhas
+   * do BRKGA consultam o incumbente a cada `inject_interval` gerações e, se ele for melhor que a
+   * melhor ilha, o recebem como migrante; a busca local sempre recomeça do incumbente mais novo. O
+   * HHO apenas publica.
+   *
+   * O grafo, o decodificador e o problema do HHO são compartilhados (somente leitura). A semente de
+   * cada motor deriva de (seed, índice), então cada motor é reprodutível, mas a interação entre
+   * eles depende do escalonamento. Uma exceção em qualquer motor para os demais e é relançada.
+   */
+  template <core::adjacency_graph Graph>
+  portfolio_result run_portfolio( const Graph                                &graph,
+                                  const std::vector<member_config>           &members,
+                                  const std::vector<std::vector<unsigned>>   &cpu_sets,
+                                  std::uint64_t                               seed,
+                                  core::cancellation_token::clock::time_point deadline ) {
+    using clock       = core::cancellation_token::clock;
+    using decoder_t   = brkga::basic_r3dp_decoder<Graph>;
+    using hho_problem = hho::basic_r3dp_hho_problem<Graph>;
+
+    constexpr std::uint64_t NO_WEIGHT = std::numeric_limits<std::uint64_t>::max();
+
+    const auto        start = clock::now();
+    const auto        n     = static_cast<unsigned>( core::vertex_count( graph ) );
+    const hho_problem problem( graph );
+    const decoder_t  &decoder = problem.get_decoder();
+
+    core::shared_incumbent   incumbent;
+    core::cancellation_token stop( deadline );
+
+    portfolio_result result;
+    result.members.resize( members.size() );
+    std::vector<std::vector<improvement_point>> improvements( members.size() );
+
+    std::mutex         error_mutex;
+    std::exception_ptr error;
+
+    auto run_member = [&]( unsigned index ) {
+      const member_config         &config      = members[index];
+      const std::vector<unsigned> &cpus        = cpu_sets[index];
+      member_result               &out         = result.members[index];
+      const std::uint64_t          member_seed = core::counter_rng( seed, index ).next_u64();
+
+      out.kind    = config.kind;
+      out.threads = config.threads;
+      out.cpus    = cpus;
+      if ( !cpus.empty() ) {
+        core::thread_pool::pin_current_thread( cpus.front() );
+      }
+
+      auto publish = [&]( std::span<const double> keys, double fitness ) {
+        out.best_fitness_value = std::min( out.best_fitness_value, fitness );
+        if ( fitness < incumbent.best_fitness() && incumbent.offer( keys, fitness, index ) ) {
+          ++out.published;
+          improvements[index].push_back(
+            { std::chrono::duration<double>( clock::now() - start ).count(), fitness, index } );
+        }
+      };
+
+      switch ( config.kind ) {
+        case engine_kind::brkga: {
+          brkga::MTRand rng( static_cast<brkga::MTRand::uint32>( member_seed ) );
+          brkga::BRKGA<decoder_t, brkga::MTRand> algorithm( n,
+                                                            config.population_size,
+                                                            config.elite_fraction,
+                                                            config.mutant_fraction,
+                                                            config.elite_inheritance_prob,
+                                                            decoder,
+                                                            rng,
+                                                            config.num_populations,
+                                                            config.threads,
+                                                            cpus );
+          algorithm.setBatchDecoding( config.batch_decode );
+          publish( algorithm.getBestChromosome(), algorithm.getBestFitness() );
+
+          while ( algorithm.evolve( 1, stop ) ) {
+            ++out.iterations;
+            publish( algorithm.getBestChromosome(), algorithm.getBestFitness() );
+
+            if ( config.migration_size > 0 && config.num_populations > 1 &&
+                 config.migration_interval > 0 &&
+                 out.iterations % config.migration_interval == 0 ) {
+              algorithm.exchangeElite( config.migration_size );
+            }
+            if ( config.inject_interval > 0 && out.iterations % config.inject_interval == 0 &&
+                 incumbent.best_fitness() < algorithm.getBestFitness() ) {
+              const auto best = incumbent.snapshot();
+              if ( best && best->fitness < algorithm.getBestFitness() &&
+                   algorithm.injectMigrant( best->keys, best->fitness ) ) {
+                ++out.injected;
+              }
+            }
+          }
+          out.evaluations = algorithm.getPhaseReport().evaluations;
+          break;
+        }
+
+        case engine_kind::hho: {
+          for ( std::uint64_t restart = 0; !stop.stop_requested(); ++restart ) {
+            hho::HHO<hho_problem> algorithm( config.hho_population_size,
+                                             config.hho_max_iterations,
+                                             config.threads,
+                                             problem,
+                                             core::counter_rng( member_seed, restart ).next_u64(),
+                                             cpus );
+            const bool parallel = config.threads > 1;
+            auto       step     = [&] {
+              return parallel ? algorithm.step_parallel( &stop ) : algorithm.step( &stop );
+            };
+            while ( step() ) {
+              ++out.iterations;
+              publish( algorithm.get_best_solution(), algorithm.get_best_fitness() );
+            }
+            publish( algorithm.get_best_solution(), algorithm.get_best_fitness() );
+            out.evaluations += algorithm.get_evaluations();
+          }
+          break;
+        }
+
+        case engine_kind::local_search: {
+          core::counter_rng                       rng( member_seed, 0 );
+          local_search::basic_label_search<Graph> search( graph );
+          std::vector<std::uint8_t>               labels;
+          std::vector<std::uint8_t>               best_labels;  // melhor ótimo local desta busca
+          std::vector<double>                     keys( n );
+          std::uint64_t                           best_weight  = NO_WEIGHT;
+          std::uint64_t                           seen_version = 0;
+
+          const auto kick = std::max<std::size_t>( 1, std::size_t( config.kick_fraction * n ) );
+
+          // Decodifica chaves em rótulos viáveis e recomeça a busca deles
+          auto restart_from = [&]( std::span<const double> start_keys ) {
+            brkga::decode_context ctx;
+            ctx.cancel = &stop;
+            (void)decoder.decode( start_keys, labels, ctx );
+            ++out.evaluations;
+            if ( ctx.cancelled ) {
+              return false;
+            }
+            search.assign( labels );
+            best_labels.clear();
+            best_weight = NO_WEIGHT;
+            return true;
+          };
+
+          while ( !stop.stop_requested() ) {
+            const auto version = incumbent.version();
+            if ( version != seen_version && incumbent.best_fitness() < double( best_weight ) ) {
+              // Alguém publicou algo melhor que o nosso ótimo local: recomeça dele
+              seen_version = version;
+              const auto best = incumbent.snapshot();
+              if ( best && !restart_from( best->keys ) ) {
+                break;
+              }
+            }
+            if ( search.get_labels().empty() ) {
+              // Ninguém publicou ainda: parte de chaves aleatórias reparadas
+              for ( auto &key : keys ) {
+                key = rng.uniform();
+              }
+              if ( !restart_from( keys ) ) {
+                break;
+              }
+            } else if ( !best_labels.empty() ) {
+              search.kick( rng, kick );
+            }
+
+            search.descend( rng );
+            ++out.iterations;
+            if ( search.weight() <= best_weight ) {
+              best_weight = search.weight();
+              best_labels = search.get_labels();
+              search.to_keys( keys );
+              publish( keys, double( best_weight ) );
+            } else {
+              search.assign( best_labels );  // rejeita a perturbação
+            }
+          }
+          break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( members.size() );
+    for ( unsigned index = 0; index < members.size(); ++index ) {
+      threads.emplace_back( [&, index] {
+        try {
+          run_member( index );
+        } catch ( ... ) {
+          {
+            std::lock_guard lock( error_mutex );
+            if ( !error ) {
+              error = std::current_exception();
+            }
+          }
+          stop.cancel();
+        }
+      } );
+    }
+    for ( auto &thread : threads ) {
+      thread.join();
+    }
+    if ( error ) {
+      std::rethrow_exception( error );
+    }
+
+    // Cada publicação bem-sucedida melhorou o incumbente naquele instante: em ordem de tempo,
+    // ficam só as melhorias estritas (o registro do tempo é posterior à publicação)
+    for ( const auto &points : improvements ) {
+      result.convergence_points.insert(
+        result.convergence_points.end(), points.begin(), points.end() );
+    }
+    std::sort( result.convergence_points.begin(),
+               result.convergence_points.end(),
+               []( const improvement_point &a, const improvement_point &b ) {
+                 return a.time_seconds < b.time_seconds;
+               } );
+    std::vector<improvement_point> monotone;
+    for ( const auto &point : result.convergence_points ) {
+      if ( monotone.empty() || point.fitness_value < monotone.back().fitness_value ) {
+        monotone.push_back( point );
+      }
+    }
+    result.convergence_points = std::move( monotone );
+
+    if ( const auto best = incumbent.snapshot() ) {
+      result.best_fitness_value = best->fitness;
+      result.best_member        = best->source;
+    }
+    return result;
+  }
+
+}  // namespace r3dp::portfolio
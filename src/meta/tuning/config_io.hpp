@@ -0,0 +1,90 @@
+#pragma once
+
+#include "race.hpp"
+
+#include <charconv>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace r3dp::tuning {
+
+  inline nlohmann::json config_json( const brkga_config &c ) {
+    return nlohmann::json{ { "population_size", c.population_size },
+                           { "elite_fraction", c.elite_fraction },
+                           { "mutant_fraction", c.mutant_fraction },
+                           { "elite_inheritance_prob", c.elite_inheritance_prob },
+                           { "num_populations", c.num_populations },
+                           { "migration_interval", c.migration_interval },
+                           { "migration_size", c.migration_size } };
+  }
+
+  // Mesma configuração como opções de brkga_main
+  inline std::string brkga_main_args( const brkga_config &c ) {
+    std::ostringstream args;
+    args << "--pop-size " << c.population_size << " --elite-fraction " << c.elite_fraction
+         << " --mutants-fraction " << c.mutant_fraction << " --elite-inheritance-prob "
+         << c.elite_inheritance_prob << " --num-populations " << c.num_populations
+         << " --migration-interval " << c.migration_interval << " --migration-size "
+         << c.migration_size;
+    return args.str();
+  }
+
+  /**
+   * Lê "chave=valor" separados por vírgula, com as chaves dos nomes longos das opções de
+   * brkga_main (pop-size, elite-fraction, mutants-fraction, elite-inheritance-prob,
+   * num-populations, migration-interval, migration-size); as ausentes ficam com o valor padrão.
+   * `name=...` é devolvido em `name`. Lança std::invalid_argument em chaves ou valores inválidos.
+   */
+  inline brkga_config parse_config( const std::string &text, std::string &name ) {
+    brkga_config      c;
+    std::stringstream items( text );
+    std::string       item;
+    while ( std::getline( items, item, ',' ) ) {
+      if ( item.empty() ) {
+        continue;
+      }
+      const auto equals = item.find( '=' );
+      if ( equals == std::string::npos ) {
+        throw std::invalid_argument( "configuração sem '=': " + item );
+      }
+      const std::string key   = item.substr( 0, equals );
+      const std::string value = item.substr( equals + 1 );
+
+      const auto parse = [&]( auto &field ) {
+        const char *last        = value.data() + value.size();
+        const auto [end, error] = std::from_chars( value.data(), last, field );
+        if ( value.empty() || error != std::errc{} || end != last ) {
+          throw std::invalid_argument( "valor inválido para " + key + ": " + value );
+        }
+      };
+
+      if ( key == "name" ) {
+        name = value;
+      } else if ( key == "pop-size" ) {
+        parse( c.population_size );
+      } else if ( key == "elite-fraction" ) {
+        parse( c.elite_fraction );
+      } else if ( key == "mutants-fraction" ) {
+        parse( c.mutant_fraction );
+      } else if ( key == "elite-inheritance-prob" ) {
+        parse( c.elite_inheritance_prob );
+      } else if ( key == "num-populations" ) {
+        parse( c.num_populations );
+      } else if ( key == "migration-interval" ) {
+        parse( c.migration_interval );
+      } else if ( key == "migration-size" ) {
+        parse( c.migration_size );
+      } else {
+        throw std::invalid_argument( "chave desconhecida: " + key );
+      }
+    }
+    if ( c.population_size < 2 || c.num_populations < 1 || c.migration_interval < 1 ) {
+      throw std::invalid_argument( "configuração inválida: " + text );
+    }
+    return c;
+  }
+
+}  // namespace r3dp::tuning
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "../../core/cancellation.hpp"
+#include "../../core/counter_rng.hpp"
+#include "../../core/graph.hpp"
+#include "../brkga/brkga.hpp"
+#include "../brkga/brkga_decoder.hpp"
+#include "../brkga/mt_rand.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace r3dp::tuning {
+
+  // Uma configuração do BRKGA em disputa (mesmos parâmetros da linha de comando de brkga_main)
+  struct brkga_config {
+    unsigned population_size        = 5;
+    double   elite_fraction         = 0.20;
+    double   mutant_fraction        = 0.057;
+    double   elite_inheritance_prob = 0.70;
+    unsigned num_populations        = 3;
+    unsigned migration_interval     = 100;
+    unsigned migration_size         = 2;
+  };
+
+  // Intervalos de onde as configurações candidatas são sorteadas
+  struct parameter_space {
+    unsigned min_population_size        = 5;
+    unsigned max_population_size        = 200;
+    double   min_elite_fraction         = 0.10;
+    double   max_elite_fraction         = 0.30;
+    double   min_mutant_fraction        = 0.05;
+    double   max_mutant_fraction        = 0.30;
+    double   min_elite_inheritance_prob = 0.55;
+    double   max_elite_inheritance_prob = 0.85;
+    unsigned max_num_populations        = 4;
+    unsigned min_migration_interval     = 10;
+    unsigned max_migration_interval     = 200;
+    unsigned max_migration_size         = 3;
+  };
+
+  /**
+   * Sorteia uma configuração de `space`. O tamanho da população é log-uniforme (a escala importa
+   * mais que a diferença absoluta) e as frações são ajustadas para que a elite tenha ao menos um
+   * indivíduo e elite + mutantes caibam na população.
+   */
+  inline brkga_config sample_config( core::counter_rng &rng, const parameter_space &space ) {
+    auto between = [&]( double lo, double hi ) { return lo + ( hi - lo ) * rng.uniform(); };
+
+    brkga_config c;
+    c.population_size = static_cast<unsigned>(
+      std::lround( std::exp( between( std::log( double( space.min_population_size ) ),
+                                      std::log( double( space.max_population_size ) ) ) ) ) );
+    c.population_size        = std::max( c.population_size, 2u );
+    c.elite_fraction         = between( space.min_elite_fraction, space.max_elite_fraction );
+    c.mutant_fraction        = between( space.min_mutant_fraction, space.max_mutant_fraction );
+    c.elite_inheritance_prob = between( space.min_elite_inheritance_prob,
+                                        space.max_elite_inheritance_prob );
+    c.num_populations        = 1 + unsigned( rng.below_or_equal( space.max_num_populations - 1 ) );
+    c.migration_interval =
+      space.min_migration_interval +
+      unsigned( rng.below_or_equal( space.max_migration_interval - space.min_migration_interval ) );
+    c.migration_size = c.num_populations > 1
+                         ? 1 + unsigned( rng.below_or_equal( space.max_migration_size - 1 ) )
+                         : 0;
+
+    const unsigned p  = c.population_size;
+    c.elite_fraction  = std::max( c.elite_fraction, 1.0 / p );
+    c.mutant_fraction = std::min( c.mutant_fraction, 1.0 - c.elite_fraction );
+
+    // Os (K - 1) * M migrantes recebidos por ilha não podem invadir a elite
+    if ( c.num_populations > 1 ) {
+      const unsigned non_elite = p - unsigned( c.elite_fraction * p );
+      c.migration_size = std::min( c.migration_size, non_elite / ( c.num_populations - 1 ) );
+    }
+    return c;
+  }
+
+  // ---------- estatística ----------
+
+  // Quantil da normal padrão (algoritmo de Acklam; erro relativo < 1.2e-9)
+  inline double normal_quantile( double p ) {
+    static constexpr double a[] = { -3.969683028665376e+01, 2.209460984245205e+02,
+                                    -2.759285104469687e+02, 1.383577518672690e+02,
+                                    -3.066479806614716e+01, 2.506628277459239e+00 };
+    static constexpr double b[] = { -5.447609879822406e+01, 1.615858368580409e+02,
+                                    -1.556989798598866e+02, 6.680131188771972e+01,
+                                    -1.328068155288572e+01 };
+    static constexpr double c[] = { -7.784894002430293e-03, -3.223964580411365e-01,
+                                    -2.400758277161838e+00, -2.549732539343734e+00,
+                                    4.374664141464968e+00,  2.938163982698783e+00 };
+    static constexpr double d[] = { 7.784695709041462e-03, 3.224671290700398e-01,
+                                    2.445134137142996e+00, 3.754408661907416e+00 };
+    static constexpr double LOW = 0.02425;
+
+    if ( p <= 0.0 || p >= 1.0 ) {
+      throw std::domain_error( "normal_quantile: p deve estar em (0, 1)" );
+    }
+    if ( p < LOW || p > 1.0 - LOW ) {
+      const double q = std::sqrt( -2.0 * std::log( p < LOW ? p : 1.0 - p ) );
+      const double x =
+        ( ( ( ( ( c[0] * q + c[1] ) * q + c[2] ) * q + c[3] ) * q + c[4] ) * q + c[5] ) /
+        ( ( ( ( d[0] * q + d[1] ) * q + d[2] ) * q + d[3] ) * q + 1.0 );
+      return p < LOW ? x : -x;
+    }
+    const double q = p - 0.5;
+    const double r = q * q;
+    return ( ( ( ( ( a[0] * r + a[1] ) * r + a[2] ) * r + a[3] ) * r + a[4] ) * r + a[5] ) * q /
+           ( ( ( ( ( b[0] * r + b[1] ) * r + b[2] ) * r + b[3] ) * r + b[4] ) * r + 1.0 );
+  }
+
+  // Quantil da qui-quadrado com `df` graus de liberdade (aproximação de Wilson-Hilferty)
+  inline double chi_square_quantile( double p, double df ) {
+    const double z = normal_quantile( p );
+    const double h = 2.0 / ( 9.0 * df );
+    return df * std::pow( 1.0 - h + z * std::sqrt( h ), 3 );
+  }
+
+  // Quantil da t de Student com `df` graus de liberdade (expansão de Cornish-Fisher)
+  inline double student_t_quantile( double p, double df ) {
+    const double z  = normal_quantile( p );
+    const double z2 = z * z;
+    const double g1 = ( z2 + 1.0 ) * z / 4.0;
+    const double g2 = ( ( 5.0 * z2 + 16.0 ) * z2 + 3.0 ) * z / 96.0;
+    const double g3 = ( ( ( 3.0 * z2 + 19.0 ) * z2 + 17.0 ) * z2 - 15.0 ) * z / 384.0;
+    const double g4 = ( ( ( ( 79.0 * z2 + 776.0 ) * z2 + 1482.0 ) * z2 - 1920.0 ) * z2 - 945.0 ) *
+                      z / 92160.0;
+    return z + g1 / df + g2 / ( df * df ) + g3 / ( df * df * df ) + g4 / ( df * df * df * df );
+  }
+
+  // Postos 1..k dos valores (menor é melhor); empates recebem a média dos postos que ocupam
+  inline std::vector<double> average_ranks( const std::vector<double> &values ) {
+    std::vector<std::size_t> order( values.size() );
+    std::iota( order.begin(), order.end(), std::size_t{ 0 } );
+    std::sort( order.begin(), order.end(), [&]( std::size_t a, std::size_t b ) {
+      return values[a] < values[b];
+    } );
+
+    std::vector<double> ranks( values.size() );
+    for ( std::size_t first = 0; first < order.size(); ) {
+      std::size_t last = first + 1;
+      while ( last < order.size() && values[order[last]] == values[order[first]] ) {
+        ++last;
+      }
+      const double rank = ( first + 1 + last ) / 2.0;  // média de first+1 .. last
+      for ( std::size_t i = first; i < last; ++i ) {
+        ranks[order[i]] = rank;
+      }
+      first = last;
+    }
+    return ranks;
+  }
+
+  /**
+   * @brief Corrida F-race (Birattari et al., 2002) entre configurações candidatas.
+   *
+   * Cada bloco é uma instância (grafo, semente) em que todas as candidatas vivas são avaliadas;
+   * `add_block` recebe o fitness de cada uma (menor é melhor). `eliminate` (que quem chama só
+   * aciona depois de alguns blocos) aplica o teste de Friedman aos postos das vivas em todos os
+   * blocos e, se ele rejeita a igualdade com a confiança pedida, descarta as que ficam
+   * significativamente atrás da melhor pelo teste post-hoc de Conover. Como as vivas foram
+   * avaliadas em todos os blocos, a matriz de postos está sempre completa.
+   */
+  class race {
+  public:
+    static constexpr double NOT_EVALUATED = std::numeric_limits<double>::quiet_NaN();
+
+    explicit race( std::size_t candidates )
+      : alive( candidates, true )
+      , eliminated_after( candidates, 0 )
+      , final_rank( candidates, 0.0 ) {}
+
+    [[nodiscard]] std::vector<std::size_t> alive_candidates() const {
+      std::vector<std::size_t> ids;
+      for ( std::size_t c = 0; c < alive.size(); ++c ) {
+        if ( alive[c] ) {
+          ids.push_back( c );
+        }
+      }
+      return ids;
+    }
+
+    // fitness[c] da candidata c neste bloco (ignorado para as já eliminadas)
+    void add_block( const std::vector<double> &fitness ) {
+      std::vector<double> row( alive.size(), NOT_EVALUATED );
+      for ( std::size_t c = 0; c < alive.size(); ++c ) {
+        if ( alive[c] ) {
+          row[c] = fitness[c];
+        }
+      }
+      results.push_back( std::move( row ) );
+    }
+
+    // Aplica o teste; retorna as candidatas eliminadas agora
+    std::vector<std::size_t> eliminate( double confidence ) {
+      const auto ids = alive_candidates();
+      const auto k   = ids.size();
+      const auto b   = results.size();
+      if ( k < 2 || b < 2 ) {
+        return {};
+      }
+
+      const auto   sums       = rank_sums( ids );
+      double       squares    = 0.0;  // soma dos postos ao quadrado (corrige empates)
+      const double k1         = double( k ) + 1.0;
+      const double correction = double( b ) * double( k ) * k1 * k1 / 4.0;
+      for ( const auto &row : results ) {
+        std::vector<double> values;
+        for ( auto c : ids ) {
+          values.push_back( row[c] );
+        }
+        for ( double r : average_ranks( values ) ) {
+          squares += r * r;
+        }
+      }
+      const double spread = squares - correction;
+      if ( spread <= 0.0 ) {
+        return {};  // todas empatadas em todos os blocos
+      }
+
+      double deviation = 0.0;
+      for ( double s : sums ) {
+        deviation += ( s - double( b ) * k1 / 2.0 ) * ( s - double( b ) * k1 / 2.0 );
+      }
+      const double statistic = ( double( k ) - 1.0 ) * deviation / spread;
+      if ( statistic <= chi_square_quantile( confidence, double( k ) - 1.0 ) ) {
+        return {};
+      }
+
+      // Post-hoc: diferença mínima significativa entre somas de postos
+      const double dof       = ( double( b ) - 1.0 ) * ( double( k ) - 1.0 );
+      const double agreement = 1.0 - statistic / ( double( b ) * ( double( k ) - 1.0 ) );
+      const double threshold = student_t_quantile( 1.0 - ( 1.0 - confidence ) / 2.0, dof ) *
+                               std::sqrt( 2.0 * double( b ) * agreement * spread / dof );
+      const double best = *std::min_element( sums.begin(), sums.end() );
+
+      std::vector<std::size_t> dropped;
+      for ( std::size_t i = 0; i < k; ++i ) {
+        if ( sums[i] - best > threshold ) {
+          alive[ids[i]]            = false;
+          eliminated_after[ids[i]] = b;
+          final_rank[ids[i]]       = sums[i] / double( b );
+          dropped.push_back( ids[i] );
+        }
+      }
+      return dropped;
+    }
+
+    // Posto médio das vivas nos blocos vistos até aqui (eliminadas: o do momento da eliminação)
+    [[nodiscard]] std::vector<double> mean_ranks() const {
+      std::vector<double> mean = final_rank;
+      const auto          ids  = alive_candidates();
+      if ( !results.empty() ) {
+        const auto sums = rank_sums( ids );
+        for ( std::size_t i = 0; i < ids.size(); ++i ) {
+          mean[ids[i]] = sums[i] / double( results.size() );
+        }
+      }
+      return mean;
+    }
+
+    // Viva de menor posto médio
+    [[nodiscard]] std::size_t best() const {
+      const auto ids  = alive_candidates();
+      const auto mean = mean_ranks();
+      return *std::min_element(
+        ids.begin(), ids.end(), [&]( std::size_t a, std::size_t b ) { return mean[a] < mean[b]; } );
+    }
+
+    [[nodiscard]] bool is_alive( std::size_t c ) const {
+      return alive[c];
+    }
+
+    // Bloco após o qual c foi eliminada (0 = viva)
+    [[nodiscard]] std::size_t get_eliminated_after( std::size_t c ) const {
+      return eliminated_after[c];
+    }
+
+    [[nodiscard]] const std::vector<std::vector<double>> &get_results() const noexcept {
+      return results;
+    }
+
+  private:
+    std::vector<bool>                alive;
+    std::vector<std::size_t>         eliminated_after;
+    std::vector<double>              final_rank;
+    std::vector<std::vector<double>> results;  // results[bloco][candidata]
+
+    [[nodiscard]] std::vector<double> rank_sums( const std::vector<std::size_t> &ids ) const {
+      std::vector<double> sums( ids.size(), 0.0 );
+      for ( const auto &row : results ) {
+        std::vector<double> values;
+        for ( auto c : ids ) {
+          values.push_back( row[c] );
+        }
+        const auto ranks = average_ranks( values );
+        for ( std::size_t i = 0; i < ids.size(); ++i ) {
+          sums[i] += ranks[i];
+        }
+      }
+      return sums;
+    }
+  };
+
+  /**
+   * Uma execução do BRKGA com `config` até o prazo (ou `max_generations`, se > 0), com as ilhas
+   * trocando elites como em brkga_main. `cpus` fixa as threads da execução (a primeira é a de
+   * quem chama). Retorna o melhor fitness encontrado.
+   */
+  template <core::adjacency_graph Graph>
+  double evaluate_config( const brkga::basic_r3dp_decoder<Graph> &decoder,
+                          unsigned                                n,
+                          const brkga_config                     &config,
+                          std::uint64_t                           seed,
+                          unsigned                                threads,
+                          const std::vector<unsigned>            &cpus,
+                          std::chrono::steady_clock::time_point   deadline,
+                          unsigned                                max_generations ) {
+    brkga::MTRand rng( static_cast<brkga::MTRand::uint32>( seed ) );
+    brkga::BRKGA<brkga::basic_r3dp_decoder<Graph>, brkga::MTRand> algorithm(
+      n,
+      config.population_size,
+      config.elite_fraction,
+      config.mutant_fraction,
+      config.elite_inheritance_prob,
+      decoder,
+      rng,
+      config.num_populations,
+      threads,
+      cpus );
+
+    const core::cancellation_token token( deadline );
+    for ( unsigned generation = 1; max_generations == 0 || generation <= max_generations;
+          ++generation ) {
+      if ( !algorithm.evolve( 1, token ) ) {
+        break;
+      }
+      if ( config.migration_size > 0 && config.num_populations > 1 &&
+           generation % config.migration_interval == 0 ) {
+        algorithm.exchangeElite( config.migration_size );
+      }
+    }
+    return algorithm.getBestFitness();
+  }
+
+}  // namespace r3dp::tuning
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "race.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace r3dp::tuning {
+
+  // Uma execução até o alvo: `seconds` é o tempo até alcançá-lo ou, se não alcançou, até o limite
+  struct ttt_trial {
+    std::uint64_t seed         = 0;
+    double        seconds      = 0.0;
+    unsigned      generations  = 0;
+    double        best_fitness = std::numeric_limits<double>::infinity();
+    bool          reached      = false;
+
+    // Tempo usado nas estatísticas: infinito para as que não alcançaram o alvo (censuradas)
+    [[nodiscard]] double time_to_target() const noexcept {
+      return reached ? seconds : std::numeric_limits<double>::infinity();
+    }
+  };
+
+  /**
+   * Executa o BRKGA com `config`, como evaluate_config, até que o melhor fitness fique <= target ou
+   * o tempo acabe. O relógio começa antes da população inicial (a decodificação dela faz parte do
+   * tempo até o alvo) e o alvo é conferido a cada geração.
+   */
+  template <core::adjacency_graph Graph>
+  ttt_trial time_to_target( const brkga::basic_r3dp_decoder<Graph> &decoder,
+                            unsigned                                n,
+                            const brkga_config                     &config,
+                            std::uint64_t                           seed,
+                            unsigned                                threads,
+                            const std::vector<unsigned>            &cpus,
+                            double                                  target,
+                            std::chrono::milliseconds               time_limit ) {
+    const auto                     start = std::chrono::steady_clock::now();
+    const core::cancellation_token token( start + time_limit );
+
+    brkga::MTRand rng( static_cast<brkga::MTRand::uint32>( seed ) );
+    brkga::BRKGA<brkga::basic_r3dp_decoder<Graph>, brkga::MTRand> algorithm(
+      n,
+      config.population_size,
+      config.elite_fraction,
+      config.mutant_fraction,
+      config.elite_inheritance_prob,
+      decoder,
+      rng,
+      config.num_populations,
+      threads,
+      cpus );
+
+    ttt_trial trial;
+    trial.seed = seed;
+    while ( algorithm.getBestFitness() > target && algorithm.evolve( 1, token ) ) {
+      ++trial.generations;
+      if ( config.migration_size > 0 && config.num_populations > 1 &&
+           trial.generations % config.migration_interval == 0 ) {
+        algorithm.exchangeElite( config.migration_size );
+      }
+    }
+    trial.seconds =
+      std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    trial.best_fitness = algorithm.getBestFitness();
+    trial.reached      = trial.best_fitness <= target;
+    return trial;
+  }
+
+  // ---------- distribuições de tempo até o alvo ----------
+
+  struct ecdf_point {
+    double seconds     = 0.0;
+    double probability = 0.0;
+  };
+
+  /**
+   * Distribuição empírica dos tempos, como nos gráficos TTT de Aiex, Resende e Ribeiro: o i-ésimo
+   * menor tempo (i = 1..N) recebe p = (i - 1/2) / N. As execuções censuradas contam em N mas não
+   * geram pontos, então a curva para abaixo de 1 quando alguma não alcançou o alvo.
+   */
+  inline std::vector<ecdf_point> empirical_cdf( const std::vector<ttt_trial> &trials ) {
+    std::vector<double> times;
+    for ( const auto &t : trials ) {
+      if ( t.reached ) {
+        times.push_back( t.seconds );
+      }
+    }
+    std::sort( times.begin(), times.end() );
+
+    std::vector<ecdf_point> points;
+    for ( std::size_t i = 0; i < times.size(); ++i ) {
+      points.push_back( { times[i], ( double( i ) + 0.5 ) / double( trials.size() ) } );
+    }
+    return points;
+  }
+
+  // Exponencial deslocada F(t) = 1 - exp(-(t - shift) / mean), t >= shift
+  struct exponential_fit {
+    double shift = 0.0;
+    double mean  = 0.0;
+
+    [[nodiscard]] double cdf( double seconds ) const noexcept {
+      return seconds <= shift ? 0.0 : 1.0 - std::exp( -( seconds - shift ) / mean );
+    }
+  };
+
+  // Quantil da exponencial padrão, a abscissa do gráfico Q-Q
+  inline double exponential_quantile( double probability ) {
+    return -std::log( 1.0 - probability );
+  }
+
+  /**
+   * Ajuste pelo gráfico Q-Q (Aiex et al.): a reta que passa pelos pontos do primeiro e do terceiro
+   * quartis dá a inclinação (mean) e o intercepto (shift). Sem ajuste se o terceiro quartil caiu
+   * entre as execuções censuradas ou se os dois quartis coincidem.
+   */
+  inline std::optional<exponential_fit> fit_exponential( const std::vector<ecdf_point> &points,
+                                                         std::size_t                    trials ) {
+    const auto quartile = [&]( double q ) -> std::optional<std::size_t> {
+      const auto i = static_cast<std::size_t>( std::ceil( q * double( trials ) - 0.5 ) );
+      if ( i >= points.size() ) {
+        return std::nullopt;
+      }
+      return i;
+    };
+    const auto q1 = quartile( 0.25 );
+    const auto q3 = quartile( 0.75 );
+    if ( !q1 || !q3 || *q1 >= *q3 ) {
+      return std::nullopt;
+    }
+
+    const double z1   = exponential_quantile( points[*q1].probability );
+    const double z3   = exponential_quantile( points[*q3].probability );
+    const double mean = ( points[*q3].seconds - points[*q1].seconds ) / ( z3 - z1 );
+    if ( !( mean > 0.0 ) ) {
+      return std::nullopt;
+    }
+    return exponential_fit{ points[*q1].seconds - mean * z1, mean };
+  }
+
+  // Mediana dos tempos até o alvo (infinita se metade ou mais não o alcançou)
+  inline double median_time( const std::vector<ttt_trial> &trials ) {
+    std::vector<double> times;
+    for ( const auto &t : trials ) {
+      times.push_back( t.time_to_target() );
+    }
+    if ( times.empty() ) {
+      return std::numeric_limits<double>::infinity();
+    }
+    const auto middle = times.begin() + ( times.size() - 1 ) / 2;
+    std::nth_element( times.begin(), middle, times.end() );
+    if ( times.size() % 2 == 1 ) {
+      return *middle;
+    }
+    return ( *middle + *std::min_element( middle + 1, times.end() ) ) / 2.0;
+  }
+
+  struct ttt_comparison {
+    double probability = 0.5;  // P(T_a < T_b) + P(T_a = T_b) / 2
+    double p_value     = 1.0;  // bilateral, H0: as distribuições são iguais
+  };
+
+  /**
+   * Probabilidade de que uma execução de `a` alcance o alvo antes de uma de `b` (Ribeiro, Rosseti
+   * e Vallejos), estimada sobre todos os pares (i, j) de execuções, com as censuradas valendo
+   * infinito (duas censuradas empatam). A estimativa é a estatística U de Mann-Whitney
+   * normalizada; o p-valor vem da aproximação normal de U com correção para empates.
+   */
+  inline ttt_comparison compare_times( const std::vector<ttt_trial> &a,
+                                       const std::vector<ttt_trial> &b ) {
+    const double na = double( a.size() );
+    const double nb = double( b.size() );
+    if ( a.empty() || b.empty() ) {
+      return {};
+    }
+
+    std::vector<double> values;
+    for ( const auto &t : a ) {
+      values.push_back( t.time_to_target() );
+    }
+    for ( const auto &t : b ) {
+      values.push_back( t.time_to_target() );
+    }
+    const auto ranks = average_ranks( values );
+
+    double rank_sum_a = 0.0;
+    for ( std::size_t i = 0; i < a.size(); ++i ) {
+      rank_sum_a += ranks[i];
+    }
+    const double u_a = rank_sum_a - na * ( na + 1.0 ) / 2.0;  // pares em que a é mais lenta
+
+    ttt_comparison result;
+    result.probability = 1.0 - u_a / ( na * nb );
+
+    // Correção de empates: soma de t³ - t sobre os grupos empatados
+    std::sort( values.begin(), values.end() );
+    double ties = 0.0;
+    for ( std::size_t first = 0; first < values.size(); ) {
+      std::size_t last = first + 1;
+      while ( last < values.size() && values[last] == values[first] ) {
+        ++last;
+      }
+      const double t = double( last - first );
+      ties += t * t * t - t;
+      first = last;
+    }
+    const double n        = na + nb;
+    const double variance = na * nb / 12.0 * ( ( n + 1.0 ) - ties / ( n * ( n - 1.0 ) ) );
+    if ( variance > 0.0 ) {
+      const double z = ( u_a - na * nb / 2.0 ) / std::sqrt( variance );
+      result.p_value = std::erfc( std::abs( z ) / std::sqrt( 2.0 ) );
+    }
+    return result;
+  }
+
+}  // namespace r3dp::tuning
@@ -0,0 +1,387 @@
+#define DEBUG
+#include "CLI/CLI.hpp"
+#include "core/compressed_graph.hpp"
+#include "core/csr_graph.hpp"
+#include "core/graph.hpp"
+#include "core/log.hpp"
+#include "core/run_summary.hpp"
+#include "core/thread_pool.hpp"
+#include "meta/portfolio/portfolio.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static uint64_t generate_random_seed() {
+  std::random_device                      rd;
+  std::mt19937_64                         gen( rd() );
+  std::uniform_int_distribution<uint64_t> dist;
+  return dist( gen );
+}
+
+constexpr double   DEFAULT_TIME_LIMIT_SECONDS = 0.0;  // obrigatório (>0, resolução de 1 ms)
+constexpr uint64_t DEFAULT_RNG_SEED           = 0;    // 0 = aleatória
+constexpr unsigned DEFAULT_NUM_TRIALS         = 1;    // >= 1
+constexpr unsigned DEFAULT_MEMORY_BUDGET_MB   = 1024;
+constexpr unsigned DEFAULT_PARSE_THREADS      = 2;
+
+using r3dp::core::create_graph_summary;
+using r3dp::core::graph_summary;
+using r3dp::portfolio::engine_kind;
+using r3dp::portfolio::member_config;
+
+/**
+ * Lê um motor no formato "tipo[:chave=valor,...]", ex.: "brkga:threads=4,pop=200,rhoe=0.6".
+ *
+ * brkga: threads, pop, elite, mutants, rhoe, islands, migration-interval, migration-size, inject
+ * (gerações entre consultas ao incumbente; 0 = nunca) e batch (0/1). hho: threads, pop e
+ * iterations. local-search: kick (fração de n sorteada por perturbação); usa uma thread, então
+ * mais buscas locais são mais membros.
+ */
+static member_config parse_member( const std::string &spec ) {
+  member_config     member;
+  const auto        colon = spec.find( ':' );
+  const std::string kind  = spec.substr( 0, colon );
+  if ( kind == "brkga" ) {
+    member.kind = engine_kind::brkga;
+  } else if ( kind == "hho" ) {
+    member.kind = engine_kind::hho;
+  } else if ( kind == "local-search" ) {
+    member.kind = engine_kind::local_search;
+  } else {
+    throw std::invalid_argument( "motor desconhecido: '" + kind + "'" );
+  }
+
+  std::istringstream settings( colon == std::string::npos ? "" : spec.substr( colon + 1 ) );
+  std::string        setting;
+  while ( std::getline( settings, setting, ',' ) ) {
+    const auto equals = setting.find( '=' );
+    if ( equals == std::string::npos ) {
+      throw std::invalid_argument( spec + ": esperado chave=valor em '" + setting + "'" );
+    }
+    const std::string key   = setting.substr( 0, equals );
+    const std::string value = setting.substr( equals + 1 );
+
+    auto as_unsigned = [&]( unsigned minimum ) {
+      const unsigned long parsed = std::stoul( value );
+      if ( parsed < minimum || parsed > std::numeric_limits<unsigned>::max() ) {
+        throw std::invalid_argument( spec + ": valor fora do intervalo para " + key );
+      }
+      return static_cast<unsigned>( parsed );
+    };
+    auto as_fraction = [&] {
+      const double parsed = std::stod( value );
+      if ( parsed < 0.0 || parsed > 1.0 ) {
+        throw std::invalid_argument( spec + ": " + key + " deve estar em [0,1]" );
+      }
+      return parsed;
+    };
+
+    const bool brkga = member.kind == engine_kind::brkga;
+    const bool hho   = member.kind == engine_kind::hho;
+    if ( key == "threads" && member.kind != engine_kind::local_search ) {
+      member.threads = as_unsigned( 1 );
+    } else if ( key == "pop" && brkga ) {
+      member.population_size = as_unsigned( 2 );
+    } else if ( key == "pop" && hho ) {
+      member.hho_population_size = as_unsigned( 1 );
+    } else if ( key == "elite" && brkga ) {
+      member.elite_fraction = as_fraction();
+    } else if ( key == "mutants" && brkga ) {
+      member.mutant_fraction = as_fraction();
+    } else if ( key == "rhoe" && brkga ) {
+      member.elite_inheritance_prob = as_fraction();
+    } else if ( key == "islands" && brkga ) {
+      member.num_populations = as_unsigned( 1 );
+    } else if ( key == "migration-interval" && brkga ) {
+      member.migration_interval = as_unsigned( 1 );
+    } else if ( key == "migration-size" && brkga ) {
+      member.migration_size = as_unsigned( 0 );
+    } else if ( key == "inject" && brkga ) {
+      member.inject_interval = as_unsigned( 0 );
+    } else if ( key == "batch" && brkga ) {
+      member.batch_decode = as_unsigned( 0 ) != 0;
+    } else if ( key == "iterations" && hho ) {
+      member.hho_max_iterations = as_unsigned( 1 );
+    } else if ( key == "kick" && member.kind == engine_kind::local_search ) {
+      member.kick_fraction = as_fraction();
+    } else {
+      throw std::invalid_argument( spec + ": chave '" + key + "' não se aplica a " + kind );
+    }
+  }
+
+  if ( member.kind == engine_kind::brkga &&
+       member.elite_fraction + member.mutant_fraction > 1.0 + 1e-12 ) {
+    throw std::invalid_argument( spec + ": elite + mutants não pode exceder 1.0" );
+  }
+  return member;
+}
+
+// Portfólio padrão para `threads` CPUs: BRKGA com o que sobra, um HHO e uma busca local
+static std::vector<std::string> default_members( unsigned threads ) {
+  if ( threads >= 3 ) {
+    return { "brkga:threads=" + std::to_string( threads - 2 ), "hho", "local-search" };
+  }
+  if ( threads == 2 ) {
+    return { "brkga", "local-search" };
+  }
+  return { "brkga" };
+}
+
+struct member_summary {
+  std::string                    spec;
+  r3dp::portfolio::member_result result;
+
+  friend void to_json( nlohmann::json &j, const member_summary &m ) {
+    j = nlohmann::json{ { "spec", m.spec },
+                        { "engine", r3dp::portfolio::engine_name( m.result.kind ) },
+                        { "threads", m.result.threads },
+                        { "cpus", m.result.cpus },
+                        { "best_fitness_value", m.result.best_fitness_value },
+                        { "iterations", m.result.iterations },
+                        { "evaluations", m.result.evaluations },
+                        { "incumbent_updates", m.result.published },
+                        { "incumbent_injections", m.result.injected } };
+  }
+};
+
+struct trial_result {
+  std::uint64_t                     seed = 0;
+  r3dp::portfolio::portfolio_result outcome;
+  std::vector<member_summary>       members;
+  std::string                       stop_reason;
+  double                            overshoot_seconds = 0.0;
+
+  // Mesmos campos de brkga_main; cada ponto diz também qual motor melhorou o incumbente
+  friend void to_json( nlohmann::json &j, const trial_result &t ) {
+    nlohmann::json points = nlohmann::json::array();
+    for ( const auto &point : t.outcome.convergence_points ) {
+      points.push_back( { { "elapsed_seconds", point.time_seconds },
+                          { "fitness_value", point.fitness_value },
+                          { "member", point.member } } );
+    }
+    j = nlohmann::json{ { "best_fitness_value", t.outcome.best_fitness_value },
+                        { "best_member", t.outcome.best_member },
+                        { "stop_reason", t.stop_reason },
+                        { "overshoot_seconds", t.overshoot_seconds },
+                        { "seed", t.seed },
+                        { "convergence_points", points },
+                        { "members", t.members } };
+  }
+};
+
+struct run_results {
+  graph_summary             graph;
+  double                    time_limit_seconds = 0.0;
+  std::uint64_t             seed               = 0;
+  bool                      overlapping_cpus   = false;
+  std::vector<trial_result> trials;
+
+  friend void to_json( nlohmann::json &j, const run_results &r ) {
+    j = nlohmann::json{ { "graph", r.graph },
+                        { "engine", "portfolio" },
+                        { "time_limit_seconds", r.time_limit_seconds },
+                        { "seed", r.seed },
+                        { "overlapping_cpus", r.overlapping_cpus },
+                        { "trial_count", r.trials.size() },
+                        { "trials", r.trials } };
+  }
+
+  void save_json( const std::string &filename, int indent = 2 ) const {
+    nlohmann::json j = *this;
+    std::ofstream  ofs( filename );
+    if ( ofs ) {
+      ofs << j.dump( indent );
+      LOG_MESSAGE( "Resultado salvo em: " << filename );
+    } else {
+      LOG_ERR( "Erro ao salvar arquivo JSON em: " << filename );
+    }
+  }
+};
+
+// Executa as tentativas do portfólio sobre uma representação do grafo
+template <class Graph>
+void run_trials( const Graph                              &graph,
+                 const std::vector<std::string>           &specs,
+                 const std::vector<member_config>         &members,
+                 const std::vector<std::vector<unsigned>> &cpu_sets,
+                 unsigned                                  num_trials,
+                 std::chrono::milliseconds                 time_limit,
+                 run_results                              &run_result ) {
+  for ( unsigned trial = 0; trial < num_trials; ++trial ) {
+    LOG_MESSAGE( "Iniciando tentativa " << trial + 1 << " de " << num_trials );
+
+    trial_result &result = run_result.trials.emplace_back();
+    result.seed          = run_result.seed + trial;
+
+    const auto deadline = std::chrono::steady_clock::now() + time_limit;
+    result.outcome =
+      r3dp::portfolio::run_portfolio( graph, members, cpu_sets, result.seed, deadline );
+
+    const auto now           = std::chrono::steady_clock::now();
+    result.stop_reason       = "time_limit";
+    result.overshoot_seconds =
+      now > deadline ? std::chrono::duration<double>( now - deadline ).count() : 0.0;
+    for ( std::size_t m = 0; m < members.size(); ++m ) {
+      result.members.push_back( { specs[m], result.outcome.members[m] } );
+    }
+
+    LOG_VAR( result.outcome.best_fitness_value );
+    LOG_MESSAGE( "Melhor solução encontrada por: " << specs[result.outcome.best_member] );
+    LOG_VAR( result.overshoot_seconds );
+  }
+}
+
+int main( int argc, char *argv[] ) {
+  CLI::App app{ "Portfólio paralelo (BRKGA, HHO e busca local) para a dominação {3}-romana" };
+  argv = app.ensure_utf8( argv );
+
+  std::string input_file_path = "default.txt";
+  app.add_option( "-f,--file", input_file_path, "Arquivo de arestas (edges.txt, .gz ou .zst)" )
+    ->required()
+    ->check( CLI::ExistingFile );
+
+  const auto allowed_cpus = r3dp::core::thread_pool::allowed_cpus();
+  unsigned   num_threads  = static_cast<unsigned>( allowed_cpus.size() );
+  app
+    .add_option( "-j,--threads",
+                 num_threads,
+                 "Threads do portfólio padrão (>= 1; padrão: CPUs disponíveis)" )
+    ->check( CLI::PositiveNumber );
+
+  std::vector<std::string> member_specs;
+  app.add_option( "--member",
+                  member_specs,
+                  "Motor do portfólio, repetível: brkga[:threads=4,pop=200,elite=0.2,mutants=0.1,"
+                  "rhoe=0.7,islands=3,migration-interval=100,migration-size=2,inject=10,batch=1], "
+                  "hho[:threads=2,pop=30,iterations=500] ou local-search[:kick=0.01]" );
+
+  double time_limit_seconds = DEFAULT_TIME_LIMIT_SECONDS;
+  app
+    .add_option( "--time-limit",
+                 time_limit_seconds,
+                 "Tempo máximo em segundos (> 0; aceita frações, resolução de 1 ms)" )
+    ->check( CLI::PositiveNumber )
+    ->required();
+
+  std::string output_file_path = "default.json";
+  app.add_option( "-o,--output", output_file_path, "Arquivo de resultados (results.json)" )
+    ->required();
+
+  unsigned num_trials = DEFAULT_NUM_TRIALS;
+  app.add_option( "-r,--runs", num_trials, "Número de tentativas (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  uint64_t rng_seed_cli = DEFAULT_RNG_SEED;
+  app.add_option( "-s,--seed", rng_seed_cli, "Semente (0 = aleatória)" );
+
+  std::string graph_backend = "adjacency-list";
+  app
+    .add_option( "--graph-backend",
+                 graph_backend,
+                 "Representação do grafo: adjacency-list, csr ou compressed (ver brkga_main)" )
+    ->check( CLI::IsMember( { "adjacency-list", "csr", "compressed" } ) );
+
+  std::size_t memory_budget_mb = DEFAULT_MEMORY_BUDGET_MB;
+  app
+    .add_option( "--memory-budget-mb",
+                 memory_budget_mb,
+                 "Memória para blocos de arestas na construção csr, em MiB (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned parse_threads = DEFAULT_PARSE_THREADS;
+  app
+    .add_option( "--parse-threads",
+                 parse_threads,
+                 "Threads que convertem o texto do arquivo de arestas (a descompressão usa mais uma)" )
+    ->check( CLI::PositiveNumber );
+
+  CLI11_PARSE( app, argc, argv );
+
+  if ( member_specs.empty() ) {
+    member_specs = default_members( num_threads );
+  }
+  std::vector<member_config> members;
+  try {
+    for ( const auto &spec : member_specs ) {
+      members.push_back( parse_member( spec ) );
+    }
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "--member inválido: " << e.what() );
+    return 2;
+  }
+
+  const uint64_t rng_seed_to_use = ( rng_seed_cli == 0 ) ? generate_random_seed() : rng_seed_cli;
+  const std::chrono::milliseconds time_limit{ std::max<long long>(
+    1, std::llround( time_limit_seconds * 1000.0 ) ) };
+
+  bool       overlapping = false;
+  const auto cpu_sets    = r3dp::portfolio::assign_cpus( members, allowed_cpus, overlapping );
+  if ( overlapping ) {
+    LOG_MESSAGE( "Aviso: os motores pedem mais threads que CPUs disponíveis; blocos se sobrepõem" );
+  }
+
+  LOG_VAR( input_file_path );
+  LOG_VAR( member_specs.size() );
+  for ( const auto &spec : member_specs ) {
+    LOG_VAR( spec );
+  }
+  LOG_VAR( time_limit_seconds );
+  LOG_VAR( num_trials );
+  LOG_VAR( output_file_path );
+  LOG_VAR( rng_seed_to_use );
+  LOG_VAR( graph_backend );
+
+  const std::string graph_name = std::filesystem::path( input_file_path ).stem().string();
+
+  run_results run_result;
+  run_result.seed               = rng_seed_to_use;
+  run_result.time_limit_seconds = std::chrono::duration<double>( time_limit ).count();
+  run_result.overlapping_cpus   = overlapping;
+
+  r3dp::core::edge_stream_options stream_options;
+  stream_options.parser_threads = parse_threads;
+
+  try {
+    if ( graph_backend == "csr" || graph_backend == "compressed" ) {
+      r3dp::core::streaming_build_options build_options;
+      build_options.memory_budget_bytes = std::size_t{ memory_budget_mb } << 20;
+      build_options.input               = stream_options;
+
+      auto csr         = r3dp::core::build_csr_from_file( input_file_path, build_options );
+      run_result.graph = create_graph_summary(
+        graph_name, static_cast<std::uint32_t>( csr.vertex_count() ), csr.edge_count() );
+
+      if ( graph_backend == "compressed" ) {
+        const auto graph = r3dp::core::compress( csr );
+        csr              = {};
+        run_trials( graph, member_specs, members, cpu_sets, num_trials, time_limit, run_result );
+      } else {
+        run_trials( csr, member_specs, members, cpu_sets, num_trials, time_limit, run_result );
+      }
+    } else {
+      auto [vertex_count_total, edge_list] =
+        r3dp::core::read_graph_from_file( input_file_path, stream_options );
+      const auto graph = r3dp::core::build_graph_from( vertex_count_total, edge_list );
+      run_result.graph = create_graph_summary( graph_name, vertex_count_total, edge_list.size() );
+      edge_list        = {};
+      run_trials( graph, member_specs, members, cpu_sets, num_trials, time_limit, run_result );
+    }
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "Falha na execução: " << e.what() );
+    return 1;
+  }
+
+  run_result.save_json( output_file_path );
+  return 0;
+}
@@ -0,0 +1,469 @@
+#define DEBUG
+#include "CLI/CLI.hpp"
+#include "core/compressed_graph.hpp"
+#include "core/counter_rng.hpp"
+#include "core/csr_graph.hpp"
+#include "core/graph.hpp"
+#include "core/log.hpp"
+#include "core/run_summary.hpp"
+#include "core/thread_pool.hpp"
+#include "meta/brkga/brkga_decoder.hpp"
+#include "meta/tuning/config_io.hpp"
+#include "meta/tuning/ttt.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Distribuições de tempo até o alvo (gráficos TTT) de variantes do BRKGA: cada variante roda
+ * --trials vezes, com sementes diferentes, até alcançar --target ou esgotar --time-limit. O grafo
+ * é lido uma vez e as execuções rodam em paralelo, cada uma com --eval-threads threads fixadas no
+ * seu bloco de CPUs. O JSON traz as execuções, a distribuição empírica e o ajuste exponencial de
+ * cada variante e, para cada par, a probabilidade de uma alcançar o alvo antes da outra.
+ * --compare-with acrescenta variantes de um JSON anterior (ex.: gerado por outro build) às
+ * comparações sem rodá-las de novo.
+ */
+
+static uint64_t generate_random_seed() {
+  std::random_device                      rd;
+  std::mt19937_64                         gen( rd() );
+  std::uniform_int_distribution<uint64_t> dist;
+  return dist( gen );
+}
+
+constexpr unsigned DEFAULT_NUM_TRIALS       = 100;  // execuções por variante (>= 1)
+constexpr uint64_t DEFAULT_RNG_SEED         = 0;    // 0 = aleatória
+constexpr unsigned DEFAULT_MEMORY_BUDGET_MB = 1024;
+constexpr unsigned DEFAULT_PARSE_THREADS    = 2;
+
+using r3dp::core::create_graph_summary;
+using r3dp::core::graph_summary;
+using r3dp::tuning::brkga_config;
+using r3dp::tuning::brkga_main_args;
+using r3dp::tuning::config_json;
+using r3dp::tuning::ttt_trial;
+
+struct ttt_options {
+  unsigned                  threads      = 1;
+  unsigned                  eval_threads = 1;
+  unsigned                  trials       = DEFAULT_NUM_TRIALS;
+  double                    target       = 0.0;
+  std::chrono::milliseconds time_limit{ 0 };
+  std::uint64_t             seed = 0;
+};
+
+struct variant {
+  std::string                                  name;
+  std::optional<brkga_config>                  config;  // vazio nas importadas
+  std::string                                  source;  // JSON de onde veio (importadas)
+  std::vector<ttt_trial>                       trials;
+  std::vector<r3dp::tuning::ecdf_point>        ecdf;
+  std::optional<r3dp::tuning::exponential_fit> fit;
+};
+
+struct variant_pair {
+  std::size_t                  a = 0;
+  std::size_t                  b = 0;
+  r3dp::tuning::ttt_comparison comparison;
+};
+
+struct ttt_results {
+  graph_summary             graph;
+  ttt_options               options;
+  unsigned                  parallel_trials = 0;
+  std::vector<variant>      variants;
+  std::vector<variant_pair> pairs;
+
+  friend void to_json( nlohmann::json &j, const ttt_results &r ) {
+    nlohmann::json variants = nlohmann::json::array();
+    for ( const auto &v : r.variants ) {
+      nlohmann::json trials = nlohmann::json::array();
+      std::size_t    reached = 0;
+      for ( const auto &t : v.trials ) {
+        trials.push_back( { { "seed", t.seed },
+                            { "seconds", t.seconds },
+                            { "generations", t.generations },
+                            { "best_fitness", t.best_fitness },
+                            { "reached", t.reached } } );
+        reached += t.reached ? 1 : 0;
+      }
+      nlohmann::json ecdf = nlohmann::json::array();
+      for ( const auto &p : v.ecdf ) {
+        ecdf.push_back( { p.seconds, p.probability } );
+      }
+      // Mediana e ajuste ficam null quando não há alcances suficientes
+      nlohmann::json median;
+      nlohmann::json fit;
+      if ( const double m = r3dp::tuning::median_time( v.trials ); std::isfinite( m ) ) {
+        median = m;
+      }
+      if ( v.fit ) {
+        fit = { { "shift_seconds", v.fit->shift }, { "mean_seconds", v.fit->mean } };
+      }
+      nlohmann::json entry{ { "name", v.name },
+                            { "trials", trials },
+                            { "reached", reached },
+                            { "median_seconds", median },
+                            { "exponential_fit", fit },
+                            { "ecdf", ecdf } };
+      if ( v.config ) {
+        entry["config"]          = config_json( *v.config );
+        entry["brkga_main_args"] = brkga_main_args( *v.config );
+      } else {
+        entry["imported_from"] = v.source;
+      }
+      variants.push_back( entry );
+    }
+
+    nlohmann::json comparisons = nlohmann::json::array();
+    for ( const auto &p : r.pairs ) {
+      comparisons.push_back( { { "a", r.variants[p.a].name },
+                               { "b", r.variants[p.b].name },
+                               { "probability_a_first", p.comparison.probability },
+                               { "p_value", p.comparison.p_value } } );
+    }
+
+    j = nlohmann::json{
+      { "engine", "ttt" },
+      { "graph", r.graph },
+      { "target", r.options.target },
+      { "time_limit_seconds", std::chrono::duration<double>( r.options.time_limit ).count() },
+      { "trials", r.options.trials },
+      { "seed", r.options.seed },
+      { "eval_threads", r.options.eval_threads },
+      { "parallel_trials", r.parallel_trials },
+      { "variants", variants },
+      { "comparisons", comparisons } };
+  }
+
+  void save_json( const std::string &filename, int indent = 2 ) const {
+    nlohmann::json j = *this;
+    std::ofstream  ofs( filename );
+    if ( ofs ) {
+      ofs << j.dump( indent );
+      LOG_MESSAGE( "Resultado salvo em: " << filename );
+    } else {
+      LOG_ERR( "Erro ao salvar arquivo JSON em: " << filename );
+    }
+  }
+};
+
+// Variantes de um JSON anterior de ttt_main, que precisa ter o mesmo grafo e o mesmo alvo
+static std::vector<variant> import_variants( const std::string &file_path,
+                                             const ttt_results &current ) {
+  std::ifstream in( file_path );
+  if ( !in ) {
+    throw std::runtime_error( "Erro ao abrir o arquivo: " + file_path );
+  }
+  const nlohmann::json j = nlohmann::json::parse( in );
+  if ( j.value( "engine", "" ) != "ttt" ) {
+    throw std::runtime_error( file_path + ": não é um resultado de ttt_main" );
+  }
+  if ( j.at( "graph" ).at( "graph_name" ).get<std::string>() != current.graph.graph_name ||
+       j.at( "target" ).get<double>() != current.options.target ) {
+    throw std::runtime_error( file_path + ": grafo ou alvo diferentes dos desta execução" );
+  }
+
+  const std::string    stem = std::filesystem::path( file_path ).stem().string();
+  std::vector<variant> imported;
+  for ( const auto &entry : j.at( "variants" ) ) {
+    variant &v = imported.emplace_back();
+    v.name     = stem + "/" + entry.at( "name" ).get<std::string>();
+    v.source   = file_path;
+    for ( const auto &t : entry.at( "trials" ) ) {
+      ttt_trial &trial  = v.trials.emplace_back();
+      trial.seed        = t.at( "seed" ).get<std::uint64_t>();
+      trial.seconds     = t.at( "seconds" ).get<double>();
+      trial.generations = t.at( "generations" ).get<unsigned>();
+      trial.reached     = t.at( "reached" ).get<bool>();
+      if ( t.at( "best_fitness" ).is_number() ) {
+        trial.best_fitness = t.at( "best_fitness" ).get<double>();
+      }
+    }
+  }
+  return imported;
+}
+
+// Uma linha por ponto: segundos, probabilidade empírica e quantil exponencial (gráfico Q-Q)
+static void save_plot_data( const std::string &prefix, const variant &v, double target ) {
+  std::string file_name = v.name;
+  std::replace_if(
+    file_name.begin(),
+    file_name.end(),
+    []( unsigned char c ) { return std::isalnum( c ) == 0; },
+    '_' );
+  const std::string path = prefix + file_name + ".dat";
+
+  std::ofstream out( path );
+  if ( !out ) {
+    LOG_ERR( "Erro ao salvar os pontos do gráfico em: " << path );
+    return;
+  }
+  out << "# variant=" << v.name << " target=" << target << " trials=" << v.trials.size()
+      << " reached=" << v.ecdf.size() << "\n";
+  if ( v.fit ) {
+    out << "# fit: F(t) = 1 - exp(-(t - " << v.fit->shift << ") / " << v.fit->mean << ")\n";
+  }
+  out << "# seconds probability exponential_quantile\n";
+  for ( const auto &p : v.ecdf ) {
+    out << p.seconds << " " << p.probability << " "
+        << r3dp::tuning::exponential_quantile( p.probability ) << "\n";
+  }
+}
+
+/**
+ * Roda as execuções das variantes com config (as importadas já têm as suas). A tarefa t é a
+ * execução t / V da variante t mod V, para que as variantes dividam por igual as condições da
+ * máquina ao longo do tempo; a execução i de todas as variantes usa a mesma semente.
+ */
+template <class Graph>
+void run_trials( const Graph &graph, const ttt_options &opt, ttt_results &out ) {
+  const r3dp::brkga::basic_r3dp_decoder<Graph> decoder( graph );
+  const auto n = static_cast<unsigned>( r3dp::core::vertex_count( graph ) );
+
+  // Bloco de CPUs de cada execução simultânea; a primeira CPU é a da thread do pool externo
+  const auto                         cpus  = r3dp::core::thread_pool::allowed_cpus();
+  const unsigned                     slots = std::max( 1u, opt.threads / opt.eval_threads );
+  std::vector<std::vector<unsigned>> cpu_blocks( slots );
+  std::vector<unsigned>              leaders;
+  for ( unsigned s = 0; s < slots; ++s ) {
+    for ( unsigned t = 0; t < opt.eval_threads; ++t ) {
+      cpu_blocks[s].push_back( cpus[( s * opt.eval_threads + t ) % cpus.size()] );
+    }
+    leaders.push_back( cpu_blocks[s].front() );
+  }
+  r3dp::core::thread_pool::pin_current_thread( leaders.front() );
+  r3dp::core::thread_pool pool( slots, leaders );
+  out.parallel_trials = slots;
+
+  std::vector<std::size_t> runnable;
+  for ( std::size_t v = 0; v < out.variants.size(); ++v ) {
+    if ( out.variants[v].config ) {
+      runnable.push_back( v );
+      out.variants[v].trials.resize( opt.trials );
+    }
+  }
+
+  std::vector<std::uint64_t> seeds;
+  for ( unsigned i = 0; i < opt.trials; ++i ) {
+    seeds.push_back( r3dp::core::counter_rng( opt.seed, 1 + i ).next_u64() );
+  }
+
+  pool.parallel_for(
+    0,
+    runnable.size() * opt.trials,
+    [&]( std::size_t task ) {
+      variant   &v     = out.variants[runnable[task % runnable.size()]];
+      const auto trial = task / runnable.size();
+      v.trials[trial]  = r3dp::tuning::time_to_target( decoder,
+                                                      n,
+                                                      *v.config,
+                                                      seeds[trial],
+                                                      opt.eval_threads,
+                                                      cpu_blocks[pool.slot()],
+                                                      opt.target,
+                                                      opt.time_limit );
+    },
+    1 );
+}
+
+int main( int argc, char *argv[] ) {
+  CLI::App app{ "Distribuições de tempo até o alvo (TTT) de variantes do BRKGA" };
+  argv = app.ensure_utf8( argv );
+
+  std::string input_file_path;
+  app.add_option( "-f,--file", input_file_path, "Arquivo de entrada (edges.txt, .gz ou .zst)" )
+    ->required()
+    ->check( CLI::ExistingFile );
+
+  double target = 0.0;
+  app.add_option( "--target", target, "Fitness alvo: a execução para ao alcançar <= target" )
+    ->required();
+
+  std::vector<std::string> variant_specs;
+  app.add_option( "--variant",
+                  variant_specs,
+                  "Variante, repetível: name=...,pop-size=...,elite-fraction=... (opções de "
+                  "brkga_main; as omitidas ficam no padrão). Sem --variant: só a padrão" );
+
+  std::vector<std::string> compare_paths;
+  app
+    .add_option( "--compare-with",
+                 compare_paths,
+                 "JSON de um ttt_main anterior (mesmo grafo e alvo), repetível" )
+    ->check( CLI::ExistingFile );
+
+  unsigned trials = DEFAULT_NUM_TRIALS;
+  app.add_option( "--trials", trials, "Execuções por variante (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  double time_limit_seconds = 0.0;
+  app
+    .add_option( "--time-limit",
+                 time_limit_seconds,
+                 "Limite de cada execução em segundos; as que não alcançam o alvo são censuradas" )
+    ->check( CLI::PositiveNumber )
+    ->required();
+
+  const auto allowed_cpus = r3dp::core::thread_pool::allowed_cpus();
+  unsigned   num_threads  = static_cast<unsigned>( allowed_cpus.size() );
+  app
+    .add_option( "-j,--threads", num_threads, "Threads no total (>= 1; padrão: CPUs disponíveis)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned eval_threads = 1;
+  app
+    .add_option( "--eval-threads",
+                 eval_threads,
+                 "Threads de cada execução (rodam threads / eval-threads execuções por vez)" )
+    ->check( CLI::PositiveNumber );
+
+  std::string output_file_path = "default.json";
+  app.add_option( "-o,--output", output_file_path, "Arquivo de resultados (results.json)" )
+    ->required();
+
+  std::string plot_prefix;
+  app.add_option( "--plot-prefix",
+                  plot_prefix,
+                  "Grava <prefixo><variante>.dat com os pontos dos gráficos TTT e Q-Q" );
+
+  uint64_t rng_seed_cli = DEFAULT_RNG_SEED;
+  app.add_option( "-s,--seed", rng_seed_cli, "Semente (0 = aleatória)" );
+
+  std::string graph_backend = "adjacency-list";
+  app
+    .add_option( "--graph-backend",
+                 graph_backend,
+                 "Representação do grafo: adjacency-list, csr ou compressed (ver brkga_main)" )
+    ->check( CLI::IsMember( { "adjacency-list", "csr", "compressed" } ) );
+
+  std::size_t memory_budget_mb = DEFAULT_MEMORY_BUDGET_MB;
+  app
+    .add_option( "--memory-budget-mb",
+                 memory_budget_mb,
+                 "Memória para blocos de arestas na construção csr, em MiB (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned parse_threads = DEFAULT_PARSE_THREADS;
+  app
+    .add_option( "--parse-threads",
+                 parse_threads,
+                 "Threads que convertem o texto do arquivo de arestas (a descompressão usa mais uma)" )
+    ->check( CLI::PositiveNumber );
+
+  CLI11_PARSE( app, argc, argv );
+
+  ttt_results result;
+  result.options.threads      = num_threads;
+  result.options.eval_threads = std::min( eval_threads, num_threads );
+  result.options.trials       = trials;
+  result.options.target       = target;
+  result.options.time_limit   = std::chrono::milliseconds{ std::max<long long>(
+    1, std::llround( time_limit_seconds * 1000.0 ) ) };
+  result.options.seed = ( rng_seed_cli == 0 ) ? generate_random_seed() : rng_seed_cli;
+
+  try {
+    if ( variant_specs.empty() ) {
+      variant_specs.push_back( "name=default" );
+    }
+    for ( std::size_t i = 0; i < variant_specs.size(); ++i ) {
+      variant &v = result.variants.emplace_back();
+      v.name     = "v" + std::to_string( i );
+      v.config   = r3dp::tuning::parse_config( variant_specs[i], v.name );
+    }
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "--variant: " << e.what() );
+    return 2;
+  }
+
+  LOG_VAR( input_file_path );
+  LOG_VAR( target );
+  LOG_VAR( result.variants.size() );
+  LOG_VAR( trials );
+  LOG_VAR( time_limit_seconds );
+  LOG_VAR( num_threads );
+  LOG_VAR( result.options.eval_threads );
+  LOG_VAR( result.options.seed );
+  LOG_VAR( graph_backend );
+
+  r3dp::core::edge_stream_options stream_options;
+  stream_options.parser_threads = parse_threads;
+
+  try {
+    const std::string name = std::filesystem::path( input_file_path ).stem().string();
+
+    // O grafo é lido uma vez e compartilhado (somente leitura) por todas as execuções
+    if ( graph_backend == "csr" || graph_backend == "compressed" ) {
+      r3dp::core::streaming_build_options build_options;
+      build_options.memory_budget_bytes = std::size_t{ memory_budget_mb } << 20;
+      build_options.input               = stream_options;
+
+      auto csr     = r3dp::core::build_csr_from_file( input_file_path, build_options );
+      result.graph = create_graph_summary(
+        name, static_cast<std::uint32_t>( csr.vertex_count() ), csr.edge_count() );
+      for ( const auto &path : compare_paths ) {
+        for ( auto &v : import_variants( path, result ) ) {
+          result.variants.push_back( std::move( v ) );
+        }
+      }
+      if ( graph_backend == "compressed" ) {
+        run_trials( r3dp::core::compress( csr ), result.options, result );
+      } else {
+        run_trials( csr, result.options, result );
+      }
+    } else {
+      auto [vertex_count_total, edge_list] =
+        r3dp::core::read_graph_from_file( input_file_path, stream_options );
+      const auto graph = r3dp::core::build_graph_from( vertex_count_total, edge_list );
+      result.graph     = create_graph_summary( name, vertex_count_total, edge_list.size() );
+      for ( const auto &path : compare_paths ) {
+        for ( auto &v : import_variants( path, result ) ) {
+          result.variants.push_back( std::move( v ) );
+        }
+      }
+      run_trials( graph, result.options, result );
+    }
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "Falha na execução: " << e.what() );
+    return 1;
+  }
+
+  for ( auto &v : result.variants ) {
+    v.ecdf = r3dp::tuning::empirical_cdf( v.trials );
+    v.fit  = r3dp::tuning::fit_exponential( v.ecdf, v.trials.size() );
+    LOG_MESSAGE( v.name << ": " << v.ecdf.size() << "/" << v.trials.size()
+                        << " alcançaram o alvo, mediana "
+                        << r3dp::tuning::median_time( v.trials ) << " s" );
+  }
+  for ( std::size_t a = 0; a < result.variants.size(); ++a ) {
+    for ( std::size_t b = a + 1; b < result.variants.size(); ++b ) {
+      const auto &va = result.variants[a];
+      const auto &vb = result.variants[b];
+      const auto  c  = r3dp::tuning::compare_times( va.trials, vb.trials );
+      result.pairs.push_back( { a, b, c } );
+      LOG_MESSAGE( "P(" << va.name << " antes de " << vb.name << ") = " << c.probability
+                        << " (p = " << c.p_value << ")" );
+    }
+  }
+
+  if ( !plot_prefix.empty() ) {
+    for ( const auto &v : result.variants ) {
+      save_plot_data( plot_prefix, v, target );
+    }
+  }
+  result.save_json( output_file_path );
+  return 0;
+}
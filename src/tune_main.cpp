@@ -0,0 +1,397 @@
+#define DEBUG
+#include "CLI/CLI.hpp"
+#include "core/compressed_graph.hpp"
+#include "core/counter_rng.hpp"
+#include "core/csr_graph.hpp"
+#include "core/graph.hpp"
+#include "core/log.hpp"
+#include "core/run_summary.hpp"
+#include "core/thread_pool.hpp"
+#include "meta/brkga/brkga_decoder.hpp"
+#include "meta/tuning/config_io.hpp"
+#include "meta/tuning/race.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+static uint64_t generate_random_seed() {
+  std::random_device                      rd;
+  std::mt19937_64                         gen( rd() );
+  std::uniform_int_distribution<uint64_t> dist;
+  return dist( gen );
+}
+
+constexpr unsigned DEFAULT_NUM_CANDIDATES     = 32;    // >= 2 (inclui a configuração padrão)
+constexpr unsigned DEFAULT_MAX_BLOCKS         = 20;    // instâncias (grafo, semente) da corrida
+constexpr unsigned DEFAULT_FIRST_TEST         = 5;     // blocos antes do primeiro teste
+constexpr double   DEFAULT_CONFIDENCE         = 0.95;  // nível dos testes de Friedman e Conover
+constexpr double   DEFAULT_TIME_LIMIT_SECONDS = 0.0;   // obrigatório (>0, por avaliação)
+constexpr uint64_t DEFAULT_RNG_SEED           = 0;     // 0 = aleatória
+constexpr unsigned DEFAULT_MEMORY_BUDGET_MB   = 1024;
+constexpr unsigned DEFAULT_PARSE_THREADS      = 2;
+
+using r3dp::core::create_graph_summary;
+using r3dp::core::graph_summary;
+using r3dp::tuning::brkga_config;
+using r3dp::tuning::brkga_main_args;
+using r3dp::tuning::config_json;
+
+struct race_options {
+  unsigned                  threads         = 1;
+  unsigned                  eval_threads    = 1;
+  unsigned                  max_blocks      = DEFAULT_MAX_BLOCKS;
+  unsigned                  first_test      = DEFAULT_FIRST_TEST;
+  double                    confidence      = DEFAULT_CONFIDENCE;
+  unsigned                  max_generations = 0;
+  std::chrono::milliseconds time_limit{ 0 };
+  std::uint64_t             seed = 0;
+};
+
+// Uma instância da corrida: em qual grafo, com qual semente e o fitness de cada candidata
+struct block_result {
+  std::size_t         graph = 0;
+  std::uint64_t       seed  = 0;
+  std::vector<double> fitness;  // NaN (null no JSON) para as já eliminadas
+};
+
+struct tune_results {
+  std::vector<graph_summary> graphs;
+  race_options               options;
+  unsigned                   parallel_evaluations = 0;
+  std::uint64_t              evaluations          = 0;
+  std::vector<brkga_config>  candidates;
+  std::vector<bool>          alive;
+  std::vector<std::size_t>   eliminated_after;
+  std::vector<double>        mean_rank;
+  std::vector<block_result>  blocks;
+  std::size_t                winner = 0;
+
+  friend void to_json( nlohmann::json &j, const tune_results &r ) {
+    nlohmann::json blocks = nlohmann::json::array();
+    for ( const auto &b : r.blocks ) {
+      blocks.push_back( { { "graph", r.graphs[b.graph].graph_name },
+                          { "seed", b.seed },
+                          { "fitness", b.fitness } } );
+    }
+    nlohmann::json candidates = nlohmann::json::array();
+    for ( std::size_t c = 0; c < r.candidates.size(); ++c ) {
+      candidates.push_back( { { "id", c },
+                              { "config", config_json( r.candidates[c] ) },
+                              { "alive", bool( r.alive[c] ) },
+                              { "eliminated_after_block", r.eliminated_after[c] },
+                              { "mean_rank", r.mean_rank[c] } } );
+    }
+    j = nlohmann::json{
+      { "engine", "race" },
+      { "graphs", r.graphs },
+      { "time_limit_seconds", std::chrono::duration<double>( r.options.time_limit ).count() },
+      { "max_generations", r.options.max_generations },
+      { "seed", r.options.seed },
+      { "confidence", r.options.confidence },
+      { "first_test", r.options.first_test },
+      { "eval_threads", r.options.eval_threads },
+      { "parallel_evaluations", r.parallel_evaluations },
+      { "evaluations", r.evaluations },
+      { "blocks", blocks },
+      { "candidates", candidates },
+      { "winner",
+        { { "id", r.winner },
+          { "config", config_json( r.candidates[r.winner] ) },
+          { "brkga_main_args", brkga_main_args( r.candidates[r.winner] ) } } } };
+  }
+
+  void save_json( const std::string &filename, int indent = 2 ) const {
+    nlohmann::json j = *this;
+    std::ofstream  ofs( filename );
+    if ( ofs ) {
+      ofs << j.dump( indent );
+      LOG_MESSAGE( "Resultado salvo em: " << filename );
+    } else {
+      LOG_ERR( "Erro ao salvar arquivo JSON em: " << filename );
+    }
+  }
+};
+
+/**
+ * Corre as candidatas sobre os grafos de treino (carregados uma única vez). O bloco b usa o grafo
+ * b mod G e a mesma semente para todas as candidatas; as avaliações de um bloco rodam em paralelo,
+ * cada uma com `eval_threads` threads fixadas no seu próprio bloco de CPUs.
+ */
+template <class Graph>
+void run_race( const std::deque<Graph> &graphs, const race_options &opt, tune_results &out ) {
+  using decoder_t = r3dp::brkga::basic_r3dp_decoder<Graph>;
+
+  std::deque<decoder_t> decoders;
+  for ( const auto &graph : graphs ) {
+    decoders.emplace_back( graph );
+  }
+
+  // Bloco de CPUs de cada avaliação simultânea; a primeira CPU é a da thread do pool externo
+  const auto                         cpus  = r3dp::core::thread_pool::allowed_cpus();
+  const unsigned                     slots = std::max( 1u, opt.threads / opt.eval_threads );
+  std::vector<std::vector<unsigned>> cpu_blocks( slots );
+  std::vector<unsigned>              leaders;
+  for ( unsigned s = 0; s < slots; ++s ) {
+    for ( unsigned t = 0; t < opt.eval_threads; ++t ) {
+      cpu_blocks[s].push_back( cpus[( s * opt.eval_threads + t ) % cpus.size()] );
+    }
+    leaders.push_back( cpu_blocks[s].front() );
+  }
+  r3dp::core::thread_pool::pin_current_thread( leaders.front() );
+  r3dp::core::thread_pool pool( slots, leaders );
+  out.parallel_evaluations = slots;
+
+  r3dp::tuning::race f_race( out.candidates.size() );
+  for ( unsigned block = 0; block < opt.max_blocks; ++block ) {
+    const auto ids = f_race.alive_candidates();
+    if ( ids.size() < 2 ) {
+      break;
+    }
+
+    block_result &result = out.blocks.emplace_back();
+    result.graph         = block % graphs.size();
+    result.seed          = r3dp::core::counter_rng( opt.seed, 1 + block ).next_u64();
+    result.fitness.assign( out.candidates.size(), r3dp::tuning::race::NOT_EVALUATED );
+
+    const auto n = static_cast<unsigned>( r3dp::core::vertex_count( graphs[result.graph] ) );
+    pool.parallel_for(
+      0,
+      ids.size(),
+      [&]( std::size_t i ) {
+        const auto deadline = std::chrono::steady_clock::now() + opt.time_limit;
+        result.fitness[ids[i]] = r3dp::tuning::evaluate_config( decoders[result.graph],
+                                                                n,
+                                                                out.candidates[ids[i]],
+                                                                result.seed,
+                                                                opt.eval_threads,
+                                                                cpu_blocks[pool.slot()],
+                                                                deadline,
+                                                                opt.max_generations );
+      },
+      1 );
+    out.evaluations += ids.size();
+    f_race.add_block( result.fitness );
+
+    LOG_MESSAGE( "Bloco " << block + 1 << " (" << out.graphs[result.graph].graph_name << "): "
+                          << ids.size() << " candidatas avaliadas" );
+    if ( block + 1 >= opt.first_test ) {
+      for ( auto c : f_race.eliminate( opt.confidence ) ) {
+        LOG_MESSAGE( "Candidata " << c << " eliminada após o bloco " << block + 1 );
+      }
+    }
+  }
+
+  out.mean_rank = f_race.mean_ranks();
+  out.winner    = f_race.best();
+  for ( std::size_t c = 0; c < out.candidates.size(); ++c ) {
+    out.alive.push_back( f_race.is_alive( c ) );
+    out.eliminated_after.push_back( f_race.get_eliminated_after( c ) );
+  }
+}
+
+int main( int argc, char *argv[] ) {
+  CLI::App app{ "Sintonia dos parâmetros do BRKGA por corrida (F-race) em grafos de treino" };
+  argv = app.ensure_utf8( argv );
+
+  std::vector<std::string> input_file_paths;
+  app
+    .add_option(
+      "-f,--file", input_file_paths, "Grafo de treino, repetível (edges.txt, .gz ou .zst)" )
+    ->required()
+    ->check( CLI::ExistingFile );
+
+  const auto allowed_cpus = r3dp::core::thread_pool::allowed_cpus();
+  unsigned   num_threads  = static_cast<unsigned>( allowed_cpus.size() );
+  app
+    .add_option( "-j,--threads", num_threads, "Threads no total (>= 1; padrão: CPUs disponíveis)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned eval_threads = 1;
+  app
+    .add_option( "--eval-threads",
+                 eval_threads,
+                 "Threads de cada avaliação (rodam threads / eval-threads avaliações por vez)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned num_candidates = DEFAULT_NUM_CANDIDATES;
+  app
+    .add_option( "--candidates",
+                 num_candidates,
+                 "Configurações em disputa, incluindo a padrão de brkga_main (>= 2)" )
+    ->check( CLI::Range( 2U, std::numeric_limits<unsigned>::max() ) );
+
+  unsigned max_blocks = DEFAULT_MAX_BLOCKS;
+  app
+    .add_option( "--max-blocks",
+                 max_blocks,
+                 "Máximo de instâncias (grafo, semente) avaliadas pelas candidatas vivas (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned first_test = DEFAULT_FIRST_TEST;
+  app
+    .add_option( "--first-test", first_test, "Instâncias antes do primeiro teste estatístico" )
+    ->check( CLI::Range( 2U, std::numeric_limits<unsigned>::max() ) );
+
+  double confidence = DEFAULT_CONFIDENCE;
+  app
+    .add_option( "--confidence", confidence, "Confiança dos testes de eliminação em [0.5,0.999]" )
+    ->check( CLI::Range( 0.5, 0.999 ) );
+
+  double time_limit_seconds = DEFAULT_TIME_LIMIT_SECONDS;
+  app
+    .add_option( "--time-limit",
+                 time_limit_seconds,
+                 "Tempo de cada avaliação em segundos (> 0; aceita frações, resolução de 1 ms)" )
+    ->check( CLI::PositiveNumber )
+    ->required();
+
+  unsigned max_generations = 0;
+  app.add_option( "--max-generations",
+                  max_generations,
+                  "Gerações por avaliação (0 = só o tempo; > 0 torna a corrida reprodutível)" );
+
+  r3dp::tuning::parameter_space space;
+  app
+    .add_option( "--min-pop-size", space.min_population_size, "Menor população sorteada (>= 2)" )
+    ->check( CLI::Range( 2U, std::numeric_limits<unsigned>::max() ) );
+  app
+    .add_option( "--max-pop-size", space.max_population_size, "Maior população sorteada (>= 2)" )
+    ->check( CLI::Range( 2U, std::numeric_limits<unsigned>::max() ) );
+  app
+    .add_option(
+      "--max-num-populations", space.max_num_populations, "Máximo de ilhas sorteado (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  std::string output_file_path = "default.json";
+  app.add_option( "-o,--output", output_file_path, "Arquivo de resultados (results.json)" )
+    ->required();
+
+  uint64_t rng_seed_cli = DEFAULT_RNG_SEED;
+  app.add_option( "-s,--seed", rng_seed_cli, "Semente (0 = aleatória)" );
+
+  std::string graph_backend = "adjacency-list";
+  app
+    .add_option( "--graph-backend",
+                 graph_backend,
+                 "Representação do grafo: adjacency-list, csr ou compressed (ver brkga_main)" )
+    ->check( CLI::IsMember( { "adjacency-list", "csr", "compressed" } ) );
+
+  std::size_t memory_budget_mb = DEFAULT_MEMORY_BUDGET_MB;
+  app
+    .add_option( "--memory-budget-mb",
+                 memory_budget_mb,
+                 "Memória para blocos de arestas na construção csr, em MiB (>= 1)" )
+    ->check( CLI::PositiveNumber );
+
+  unsigned parse_threads = DEFAULT_PARSE_THREADS;
+  app
+    .add_option( "--parse-threads",
+                 parse_threads,
+                 "Threads que convertem o texto do arquivo de arestas (a descompressão usa mais uma)" )
+    ->check( CLI::PositiveNumber );
+
+  CLI11_PARSE( app, argc, argv );
+
+  if ( space.min_population_size > space.max_population_size ) {
+    LOG_ERR( "min-pop-size não pode exceder max-pop-size" );
+    return 2;
+  }
+
+  const uint64_t rng_seed_to_use = ( rng_seed_cli == 0 ) ? generate_random_seed() : rng_seed_cli;
+
+  race_options options;
+  options.threads         = num_threads;
+  options.eval_threads    = std::min( eval_threads, num_threads );
+  options.max_blocks      = max_blocks;
+  options.first_test      = first_test;
+  options.confidence      = confidence;
+  options.max_generations = max_generations;
+  options.time_limit      = std::chrono::milliseconds{ std::max<long long>(
+    1, std::llround( time_limit_seconds * 1000.0 ) ) };
+  options.seed            = rng_seed_to_use;
+
+  LOG_VAR( input_file_paths.size() );
+  LOG_VAR( num_threads );
+  LOG_VAR( options.eval_threads );
+  LOG_VAR( num_candidates );
+  LOG_VAR( max_blocks );
+  LOG_VAR( first_test );
+  LOG_VAR( confidence );
+  LOG_VAR( time_limit_seconds );
+  LOG_VAR( max_generations );
+  LOG_VAR( output_file_path );
+  LOG_VAR( rng_seed_to_use );
+  LOG_VAR( graph_backend );
+
+  // A candidata 0 é a configuração padrão de brkga_main; as demais são sorteadas
+  tune_results result;
+  result.options = options;
+  result.candidates.push_back( brkga_config{} );
+  r3dp::core::counter_rng sampler( rng_seed_to_use, 0 );
+  while ( result.candidates.size() < num_candidates ) {
+    result.candidates.push_back( r3dp::tuning::sample_config( sampler, space ) );
+  }
+
+  r3dp::core::edge_stream_options stream_options;
+  stream_options.parser_threads = parse_threads;
+
+  try {
+    // Cada grafo é lido uma vez e compartilhado (somente leitura) por todas as avaliações
+    if ( graph_backend == "csr" || graph_backend == "compressed" ) {
+      r3dp::core::streaming_build_options build_options;
+      build_options.memory_budget_bytes = std::size_t{ memory_budget_mb } << 20;
+      build_options.input               = stream_options;
+
+      std::deque<r3dp::core::csr_graph>        csr_graphs;
+      std::deque<r3dp::core::compressed_graph> compressed_graphs;
+      for ( const auto &path : input_file_paths ) {
+        auto csr = r3dp::core::build_csr_from_file( path, build_options );
+        result.graphs.push_back( create_graph_summary(
+          std::filesystem::path( path ).stem().string(),
+          static_cast<std::uint32_t>( csr.vertex_count() ),
+          csr.edge_count() ) );
+        if ( graph_backend == "compressed" ) {
+          compressed_graphs.push_back( r3dp::core::compress( csr ) );
+        } else {
+          csr_graphs.push_back( std::move( csr ) );
+        }
+      }
+      if ( graph_backend == "compressed" ) {
+        run_race( compressed_graphs, options, result );
+      } else {
+        run_race( csr_graphs, options, result );
+      }
+    } else {
+      std::deque<r3dp::core::graph_t> graphs;
+      for ( const auto &path : input_file_paths ) {
+        auto [vertex_count_total, edge_list] =
+          r3dp::core::read_graph_from_file( path, stream_options );
+        graphs.push_back( r3dp::core::build_graph_from( vertex_count_total, edge_list ) );
+        const std::string name = std::filesystem::path( path ).stem().string();
+        result.graphs.push_back(
+          create_graph_summary( name, vertex_count_total, edge_list.size() ) );
+      }
+      run_race( graphs, options, result );
+    }
+  } catch ( const std::exception &e ) {
+    LOG_ERR( "Falha na execução: " << e.what() );
+    return 1;
+  }
+
+  const brkga_config &winner = result.candidates[result.winner];
+  LOG_MESSAGE( "Configuração vencedora: candidata " << result.winner );
+  LOG_MESSAGE( "brkga_main " << brkga_main_args( winner ) );
+
+  result.save_json( output_file_path );
+  return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <iostream>
+
+// Verificação mínima dos testes (sem framework): cada falha é impressa e conta no código de saída
+namespace r3dp::test {
+  inline int &failures() {
+    static int count = 0;
+    return count;
+  }
+
+  inline int exit_code() {
+    if ( failures() > 0 ) {
+      std::cerr << failures() << " verificação(ões) falharam\n";
+    }
+    return failures() == 0 ? 0 : 1;
+  }
+}  // namespace r3dp::test
+
+#define CHECK( condition )                                                              \
+  do {                                                                                  \
+    if ( !( condition ) ) {                                                             \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": falhou: " << #condition << '\n'; \
+      ++r3dp::test::failures();                                                         \
+    }                                                                                   \
+  } while ( false )
@@ -0,0 +1,106 @@
+#include "check.hpp"
+#include "core/graph.hpp"
+#include "meta/brkga/brkga_decoder.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+  using decoder_t = r3dp::brkga::basic_r3dp_decoder<r3dp::core::graph_t>;
+
+  // G(n, m) sem laços; densidades baixas deixam vértices isolados e de grau 1
+  r3dp::core::graph_t random_graph( r3dp::core::vertex_t n, std::size_t m, std::uint64_t seed ) {
+    std::mt19937_64                                     rng( seed );
+    std::uniform_int_distribution<r3dp::core::vertex_t> vertex( 0, n - 1 );
+    std::set<r3dp::core::edge_t>                        edges;
+    while ( edges.size() < m ) {
+      auto u = vertex( rng );
+      auto v = vertex( rng );
+      if ( u != v ) {
+        edges.insert( { std::min( u, v ), std::max( u, v ) } );
+      }
+    }
+    return r3dp::core::build_graph_from( n, edges );
+  }
+
+  std::vector<double> random_chromosome( std::size_t n, std::mt19937_64 &rng ) {
+    std::uniform_real_distribution<double> gene( 0.0, 1.0 );
+    std::vector<double>                    chromosome( n );
+    for ( double &key : chromosome ) {
+      key = gene( rng );
+    }
+    return chromosome;
+  }
+
+  // Cada pista do lote tem o fitness de `decode` sequencial, inclusive no último lote incompleto
+  void batch_matches_sequential() {
+    for ( const std::size_t m : { 150, 400, 1500 } ) {
+      const auto      graph = random_graph( 300, m, m );
+      const decoder_t decoder( graph );
+      std::mt19937_64 rng( m + 1 );
+
+      std::vector<std::vector<double>> chromosomes;
+      for ( std::size_t c = 0; c < decoder_t::BATCH_LANES + 5; ++c ) {
+        chromosomes.push_back( random_chromosome( 300, rng ) );
+      }
+      std::vector<const std::vector<double> *> pointers;
+      for ( const auto &chromosome : chromosomes ) {
+        pointers.push_back( &chromosome );
+      }
+
+      std::vector<double>         fitness( chromosomes.size() );
+      r3dp::brkga::decode_context ctx;
+      decoder.decode_batch( pointers, fitness, ctx );
+      CHECK( !ctx.cancelled );
+      for ( std::size_t c = 0; c < chromosomes.size(); ++c ) {
+        CHECK( fitness[c] == decoder.decode( chromosomes[c] ) );
+      }
+    }
+  }
+
+  // A partir da solução do pai, decode_delta dá a solução e o fitness de `decode` completo: de
+  // forma incremental quando poucos genes mudam, e pelo reparo completo quando muitos mudam
+  void delta_matches_sequential() {
+    for ( const std::size_t m : { 150, 400, 1500 } ) {
+      const auto      graph = random_graph( 300, m, m + 2 );
+      const decoder_t decoder( graph );
+      std::mt19937_64 rng( m + 3 );
+
+      for ( const std::size_t changes : { 0, 1, 5, 20, 300 } ) {
+        const auto                  parent = random_chromosome( 300, rng );
+        std::vector<std::uint8_t>   parent_solution;
+        r3dp::brkga::decode_context ctx;
+        (void)decoder.decode( parent, parent_solution, ctx );
+
+        auto                                       child = parent;
+        std::uniform_int_distribution<std::size_t> vertex( 0, 299 );
+        const auto                                 fresh = random_chromosome( 300, rng );
+        for ( std::size_t k = 0; k < changes; ++k ) {
+          const std::size_t v = changes == 300 ? k : vertex( rng );
+          child[v]            = fresh[v];
+        }
+
+        std::vector<std::uint8_t> expected;
+        const double              fitness = decoder.decode( child, expected, ctx );
+
+        std::vector<std::uint8_t> solution;
+        CHECK( decoder.decode_delta( child, parent_solution, solution, ctx ) == fitness );
+        CHECK( solution == expected );
+        CHECK( !ctx.cancelled );
+        if ( changes <= 5 ) {
+          CHECK( ctx.incremental );
+        }
+      }
+    }
+  }
+}  // namespace
+
+int main() {
+  batch_matches_sequential();
+  delta_matches_sequential();
+  return r3dp::test::exit_code();
+}
@@ -0,0 +1,74 @@
+#include "check.hpp"
+#include "core/edge_stream.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  using r3dp::core::edge_stream;
+
+  // Grava `text` num arquivo temporário e devolve todas as arestas, em ordem
+  std::vector<edge_stream::raw_edge> read_all( const std::string &text ) {
+    const auto path = std::filesystem::temp_directory_path() / "r3dp_edge_stream_test.txt";
+    std::ofstream( path, std::ios::binary ) << text;
+
+    std::vector<edge_stream::raw_edge> edges;
+    std::vector<edge_stream::raw_edge> batch;
+    edge_stream                        input( path.string() );
+    while ( input.next_batch( batch ) ) {
+      edges.insert( edges.end(), batch.begin(), batch.end() );
+    }
+    std::sort( edges.begin(), edges.end() );
+    return edges;
+  }
+
+  // Mensagem do erro de formato, vazia se a leitura passou
+  std::string error_of( const std::string &text ) {
+    try {
+      read_all( text );
+    } catch ( const std::runtime_error &e ) {
+      return e.what();
+    }
+    return {};
+  }
+
+  void accepts_edge_lists() {
+    const auto edges = read_all( "# comentário\n1 2\n\n3\t4\r\n5,6  % fim\n  4294967295 0\n7 8" );
+    const std::vector<edge_stream::raw_edge> expected{
+      { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 }, { 4294967295U, 0 } };
+    CHECK( edges == expected );
+  }
+
+  void rejects_malformed_lines() {
+    CHECK( error_of( "1 2\n4294967296 1\n" ).find( "byte 4:" ) != std::string::npos );
+    CHECK( error_of( "1 -2\n" ).find( "byte 2:" ) != std::string::npos );
+    CHECK( error_of( "1 2.5\n" ).find( "byte 3:" ) != std::string::npos );
+    CHECK( error_of( "1 2 3\n" ).find( "byte 4:" ) != std::string::npos );
+    CHECK( error_of( "1 2\n3\n" ).find( "byte 4:" ) != std::string::npos );
+    CHECK( error_of( "1 2\n3" ).find( "byte 4:" ) != std::string::npos );
+    CHECK( error_of( "1 2\nx y\n" ).find( "byte 4:" ) != std::string::npos );
+  }
+
+  // A posição conta os bytes dos blocos anteriores (o arquivo é cortado em blocos de linhas)
+  void reports_offsets_past_the_first_chunk() {
+    std::string text;
+    while ( text.size() < ( std::size_t{ 3 } << 20 ) ) {
+      text += "123456 654321\n";
+    }
+    const auto offset = text.size();
+    text += "1 2 3\n";
+    CHECK( error_of( text ).find( "byte " + std::to_string( offset + 4 ) + ":" ) !=
+           std::string::npos );
+  }
+}  // namespace
+
+int main() {
+  accepts_edge_lists();
+  rejects_malformed_lines();
+  reports_offsets_past_the_first_chunk();
+  return r3dp::test::exit_code();
+}
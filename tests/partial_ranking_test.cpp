@@ -0,0 +1,144 @@
+#include "check.hpp"
+#include "meta/brkga/brkga.hpp"
+#include "meta/brkga/mt_rand.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace {
+  // Fitness = soma das chaves: empates praticamente impossíveis
+  struct sum_decoder {
+    double decode( const std::vector<double> &chromosome ) const {
+      return std::accumulate( chromosome.begin(), chromosome.end(), 0.0 );
+    }
+  };
+
+  using engine = r3dp::brkga::BRKGA<sum_decoder, r3dp::brkga::MTRand>;
+
+  constexpr unsigned N = 16;
+  constexpr unsigned P = 40;
+  constexpr unsigned K = 2;
+
+  std::vector<double> fitness_of( const r3dp::brkga::Population &pop ) {
+    std::vector<double> all;
+    for ( unsigned i = 0; i < pop.getP(); ++i ) {
+      all.push_back( pop.getFitness( i ) );
+    }
+    return all;
+  }
+
+  // O prefixo classificado está em ordem e nada fora dele é melhor que o seu último
+  bool ranked_prefix_holds( const r3dp::brkga::Population &pop ) {
+    const unsigned ranked = pop.getRanked();
+    if ( ranked == 0 ) {
+      return false;
+    }
+    for ( unsigned i = 1; i < ranked; ++i ) {
+      if ( pop.getFitness( i ) < pop.getFitness( i - 1 ) ) {
+        return false;
+      }
+    }
+    for ( unsigned i = ranked; i < pop.getP(); ++i ) {
+      if ( pop.getFitness( i ) < pop.getFitness( ranked - 1 ) ) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Valores de `before` que sumiram em `after`, em ordem crescente
+  std::vector<double> removed( std::vector<double> before, std::vector<double> after ) {
+    std::sort( before.begin(), before.end() );
+    std::sort( after.begin(), after.end() );
+    std::vector<double> out;
+    std::set_difference(
+      before.begin(), before.end(), after.begin(), after.end(), std::back_inserter( out ) );
+    return out;
+  }
+
+  // Os `count` maiores de `values`, em ordem crescente
+  std::vector<double> worst( std::vector<double> values, std::size_t count ) {
+    std::sort( values.begin(), values.end() );
+    return { values.end() - long( count ), values.end() };
+  }
+
+  void evolution_keeps_ranked_prefix() {
+    r3dp::brkga::MTRand rng( 11 );
+    const sum_decoder   decoder;
+    engine              algorithm( N, P, 0.2, 0.1, 0.7, decoder, rng, K, 2 );
+    for ( int g = 0; g < 5; ++g ) {
+      algorithm.evolve( 1 );
+      for ( unsigned k = 0; k < K; ++k ) {
+        CHECK( algorithm.getPopulation( k ).getRanked() >= algorithm.getPe() );
+        CHECK( ranked_prefix_holds( algorithm.getPopulation( k ) ) );
+      }
+    }
+  }
+
+  void exchange_replaces_the_worst() {
+    constexpr unsigned  M = 3;
+    r3dp::brkga::MTRand rng( 12 );
+    const sum_decoder   decoder;
+    engine              algorithm( N, P, 0.2, 0.1, 0.7, decoder, rng, K, 2 );
+    algorithm.evolve( 2 );
+
+    std::vector<std::vector<double>> before;
+    for ( unsigned k = 0; k < K; ++k ) {
+      before.push_back( fitness_of( algorithm.getPopulation( k ) ) );
+    }
+    algorithm.exchangeElite( M );
+    for ( unsigned k = 0; k < K; ++k ) {
+      const auto &pop = algorithm.getPopulation( k );
+      CHECK( removed( before[k], fitness_of( pop ) ) == worst( before[k], M ) );
+      CHECK( ranked_prefix_holds( pop ) );
+    }
+  }
+
+  void migrant_replaces_the_worst_and_is_promoted() {
+    r3dp::brkga::MTRand rng( 13 );
+    const sum_decoder   decoder;
+    engine              algorithm( N, P, 0.2, 0.1, 0.7, decoder, rng, 1, 1 );
+    algorithm.evolve( 2 );
+
+    const auto                before = fitness_of( algorithm.getPopulation() );
+    const std::vector<double> migrant( N, 0.0 );
+    CHECK( algorithm.injectMigrant( migrant, 0.0 ) );
+
+    const auto &pop = algorithm.getPopulation();
+    CHECK( removed( before, fitness_of( pop ) ) == worst( before, 1 ) );
+    CHECK( pop.getBestFitness() == 0.0 );
+    CHECK( ranked_prefix_holds( pop ) );
+  }
+
+  void seeds_replace_the_worst() {
+    r3dp::brkga::MTRand rng( 14 );
+    const sum_decoder   decoder;
+    engine              algorithm( N, P, 0.2, 0.1, 0.7, decoder, rng, K, 2 );
+    algorithm.evolve( 1 );
+
+    std::vector<std::vector<double>> before;
+    for ( unsigned k = 0; k < K; ++k ) {
+      before.push_back( fitness_of( algorithm.getPopulation( k ) ) );
+    }
+    // 5 sementes: 3 na ilha 0 e 2 na ilha 1, cada uma com fitness distinto e baixo
+    std::vector<std::vector<double>> seeds;
+    for ( unsigned s = 0; s < 5; ++s ) {
+      seeds.emplace_back( N, 0.001 * ( s + 1 ) );
+    }
+    algorithm.seedPopulations( seeds );
+    for ( unsigned k = 0; k < K; ++k ) {
+      const auto &pop = algorithm.getPopulation( k );
+      CHECK( removed( before[k], fitness_of( pop ) ) == worst( before[k], k == 0 ? 3 : 2 ) );
+      CHECK( ranked_prefix_holds( pop ) );
+    }
+  }
+}  // namespace
+
+int main() {
+  evolution_keeps_ranked_prefix();
+  exchange_replaces_the_worst();
+  migrant_replaces_the_worst_and_is_promoted();
+  seeds_replace_the_worst();
+  return r3dp::test::exit_code();
+}
@@ -0,0 +1,97 @@
+#include "check.hpp"
+#include "core/spsc_ring.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+  using r3dp::core::spsc_ring;
+
+  // Cheia após `capacity` itens, vazia depois de esvaziada, em ordem FIFO mesmo dando a volta
+  void fifo_full_and_empty() {
+    spsc_ring<int> ring( 3 );
+    CHECK( ring.capacity() == 3 );
+    CHECK( !ring.try_pop( []( int & ) {} ) );
+
+    int next_in  = 0;
+    int next_out = 0;
+    for ( int round = 0; round < 5; ++round ) {
+      for ( int i = 0; i < 3; ++i ) {
+        CHECK( ring.try_push( [&]( int &slot ) { slot = next_in++; } ) );
+      }
+      bool called = false;
+      CHECK( !ring.try_push( [&]( int & ) { called = true; } ) );
+      CHECK( !called );
+
+      for ( int i = 0; i < 3; ++i ) {
+        int value = -1;
+        CHECK( ring.try_pop( [&]( int &slot ) { value = slot; } ) );
+        CHECK( value == next_out++ );
+      }
+      CHECK( !ring.try_pop( []( int & ) {} ) );
+    }
+
+    spsc_ring<int> zero( 0 );  // capacidade mínima é 1
+    CHECK( zero.capacity() == 1 );
+  }
+
+  // Os slots são reaproveitados: o produtor atribui sobre a memória de um vetor já usado (com
+  // capacidade 1 a fila alterna entre dois slots)
+  void slots_are_reused() {
+    spsc_ring<std::vector<int>> ring( 1 );
+    std::vector<const int *>    used;
+    for ( int round = 0; round < 4; ++round ) {
+      const std::size_t size = round < 2 ? 100 : 50;
+      CHECK( ring.try_push( [&]( std::vector<int> &slot ) { slot.assign( size, round ); } ) );
+      CHECK( ring.try_pop( [&]( std::vector<int> &slot ) {
+        CHECK( slot.size() == size );
+        used.push_back( slot.data() );
+      } ) );
+    }
+    CHECK( used.size() == 4 && used[2] == used[0] && used[3] == used[1] );
+  }
+
+  // Uma thread de cada lado: o consumidor recebe toda a sequência, sem perda, repetição ou troca
+  // de ordem, e cada item chega inteiro (escrito antes de publicado)
+  void producer_and_consumer_threads() {
+    constexpr std::uint64_t               COUNT = 200000;
+    spsc_ring<std::vector<std::uint64_t>> ring( 7 );
+
+    std::thread producer( [&] {
+      for ( std::uint64_t i = 0; i < COUNT; ) {
+        if ( ring.try_push( [&]( std::vector<std::uint64_t> &slot ) { slot.assign( 4, i ); } ) ) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    } );
+
+    std::uint64_t expected = 0;
+    std::uint64_t torn     = 0;
+    while ( expected < COUNT ) {
+      const bool got = ring.try_pop( [&]( std::vector<std::uint64_t> &slot ) {
+        for ( const auto value : slot ) {
+          torn += value != expected ? 1 : 0;
+        }
+        ++expected;
+      } );
+      if ( !got ) {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+
+    CHECK( torn == 0 );
+    CHECK( !ring.try_pop( []( std::vector<std::uint64_t> & ) {} ) );
+  }
+}  // namespace
+
+int main() {
+  fifo_full_and_empty();
+  slots_are_reused();
+  producer_and_consumer_threads();
+  return r3dp::test::exit_code();
+}
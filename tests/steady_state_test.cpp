@@ -0,0 +1,74 @@
+#include "check.hpp"
+#include "meta/brkga/mt_rand.hpp"
+#include "meta/brkga/steady_state_brkga.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+  // Decodificação de duração fixa que respeita o cancelamento; fitness = primeira chave
+  struct slow_decoder {
+    std::chrono::milliseconds duration;
+
+    double decode( const std::vector<double> &chromosome, r3dp::brkga::decode_context &ctx ) const {
+      const auto until = clock_type::now() + duration;
+      while ( clock_type::now() < until ) {
+        if ( ctx.should_stop() ) {
+          return 0.0;
+        }
+        std::this_thread::sleep_for( 1ms );
+      }
+      return chromosome[0];
+    }
+  };
+
+  using engine = r3dp::brkga::SteadyStateBRKGA<slow_decoder, r3dp::brkga::MTRand>;
+
+  // Sem prazo, o orçamento de decodificações é respeitado exatamente
+  void budget_is_exact() {
+    r3dp::brkga::MTRand rng( 1 );
+    const slow_decoder  decoder{ 0ms };
+    engine              algorithm( 4, 20, 0.2, 0.1, 0.7, decoder, rng, 3 );
+    const double        initial = algorithm.getBestFitness();
+    CHECK( algorithm.evolve( 100 ) == 100 );
+    CHECK( algorithm.evolve( 37 ) == 37 );
+    CHECK( algorithm.getBestFitness() <= initial );
+    CHECK( algorithm.getPhaseReport().evaluations == 20 + 100 + 37 );
+  }
+
+  // Uma fatia de relatório mais curta que a decodificação não descarta o que já começou
+  void slice_does_not_cancel_decodes() {
+    r3dp::brkga::MTRand rng( 2 );
+    const slow_decoder  decoder{ 40ms };
+    engine              algorithm( 4, 6, 0.34, 0.0, 0.7, decoder, rng, 2 );
+    const auto          now = clock_type::now();
+    const auto decoded = algorithm.evolve( 1000, now + 10s, now + 5ms );
+    CHECK( decoded >= 1 );
+    CHECK( decoded <= 2 );  // só as que começaram antes do fim da fatia
+  }
+
+  // O prazo interrompe a decodificação em andamento, que é descartada
+  void deadline_cancels_decodes() {
+    r3dp::brkga::MTRand rng( 3 );
+    slow_decoder        decoder{ 0ms };
+    engine              algorithm( 4, 6, 0.34, 0.0, 0.7, decoder, rng, 2 );
+    const double        best = algorithm.getBestFitness();
+
+    decoder.duration = 10s;
+    const auto start = clock_type::now();
+    CHECK( algorithm.evolve( 1000, start + 30ms ) == 0 );
+    CHECK( clock_type::now() - start < 2s );
+    CHECK( algorithm.getBestFitness() == best );
+  }
+}  // namespace
+
+int main() {
+  budget_is_exact();
+  slice_does_not_cancel_decodes();
+  deadline_cancels_decodes();
+  return r3dp::test::exit_code();
+}
@@ -0,0 +1,78 @@
+#include "check.hpp"
+#include "core/thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+  // Quem espera um parallel_for aninhado não pode pegar outra tarefa externa (ex.: outra ilha
+  // inteira): cada thread está dentro de no máximo uma tarefa externa por vez
+  void waiter_helps_only_its_group() {
+    r3dp::core::thread_pool       pool( 4 );
+    static thread_local int       inside = 0;
+    std::atomic<int>              overlaps{ 0 };
+    std::atomic<std::size_t>      inner_done{ 0 };
+    std::vector<std::atomic<int>> outer_runs( 32 );
+
+    pool.parallel_for(
+      0,
+      outer_runs.size(),
+      [&]( std::size_t i ) {
+        if ( ++inside > 1 ) {
+          ++overlaps;
+        }
+        ++outer_runs[i];
+        pool.parallel_for(
+          0,
+          16,
+          [&]( std::size_t ) {
+            std::this_thread::sleep_for( 100us );
+            ++inner_done;
+          },
+          1 );
+        --inside;
+      },
+      1 );
+
+    CHECK( overlaps.load() == 0 );
+    CHECK( inner_done.load() == outer_runs.size() * 16 );
+    for ( const auto &runs : outer_runs ) {
+      CHECK( runs.load() == 1 );
+    }
+  }
+
+  // Mesmo com domínios, todo índice roda uma vez e as exceções chegam a quem chamou
+  void placed_runs_every_index_once() {
+    r3dp::core::thread_pool       pool( 4, {}, { 0, 0, 1, 1 } );
+    std::vector<std::atomic<int>> runs( 10 );
+    pool.parallel_for_placed( { 0, 1, 0, 1, 1, 0, 1, 0, 0, 1 },
+                              [&]( std::size_t i ) { ++runs[i]; } );
+    for ( const auto &count : runs ) {
+      CHECK( count.load() == 1 );
+    }
+
+    bool thrown = false;
+    try {
+      pool.parallel_for( 0, 100, []( std::size_t i ) {
+        if ( i == 42 ) {
+          throw std::runtime_error( "42" );
+        }
+      } );
+    } catch ( const std::runtime_error & ) {
+      thrown = true;
+    }
+    CHECK( thrown );
+  }
+}  // namespace
+
+int main() {
+  waiter_helps_only_its_group();
+  placed_runs_every_index_once();
+  return r3dp::test::exit_code();
+}